@@ -0,0 +1,141 @@
+//          Copyright Dominic Koepke 2017 - 2020.
+// Distributed under the Boost Software License, Version 1.0.
+//    (See accompanying file LICENSE_1_0.txt or copy at
+//          https://www.boost.org/LICENSE_1_0.txt)
+
+#ifndef GEORITHM_BENCH_BENCHMARK_HPP
+#define GEORITHM_BENCH_BENCHMARK_HPP
+
+#pragma once
+
+#include <algorithm>
+#include <chrono>
+#include <concepts>
+#include <cstddef>
+#include <functional>
+#include <random>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace georithm::bench
+{
+	// prevents the compiler from optimizing away results, which are never used otherwise
+	template <class T>
+	void doNotOptimize(const T& value) noexcept
+	{
+#if defined(__GNUC__) || defined(__clang__)
+		asm volatile("" : : "r,m"(value) : "memory");
+#else
+		static volatile const void* sink;
+		sink = &value;
+#endif
+	}
+
+	// a benchmark body executes its operation(s) exactly iterations times
+	using BenchmarkBody = std::function<void(std::size_t iterations)>;
+
+	struct Benchmark
+	{
+		std::string name;
+		// how many operations a single iteration performs; batch benchmarks use their batch size here
+		std::size_t opsPerIteration;
+		BenchmarkBody body;
+	};
+
+	struct Result
+	{
+		std::string name;
+		double nsPerOp;
+		double opsPerSecond;
+		double p50NsPerOp;
+		double p99NsPerOp;
+		std::size_t samples;
+	};
+
+	[[nodiscard]] inline std::vector<Benchmark>& registry() noexcept
+	{
+		static std::vector<Benchmark> benchmarks;
+		return benchmarks;
+	}
+
+	inline void registerBenchmark(std::string name, std::size_t opsPerIteration, BenchmarkBody body)
+	{
+		registry().push_back({ std::move(name), opsPerIteration, std::move(body) });
+	}
+
+	struct Registrar
+	{
+		template <std::invocable TFunc>
+		explicit Registrar(TFunc func)
+		{
+			func();
+		}
+	};
+
+	[[nodiscard]] inline Result run(const Benchmark& benchmark, std::size_t sampleCount = 100,
+									std::chrono::nanoseconds minSampleTime = std::chrono::microseconds{ 200 })
+	{
+		using Clock_t = std::chrono::steady_clock;
+		auto measure = [&benchmark](std::size_t iterations)
+		{
+			auto begin = Clock_t::now();
+			benchmark.body(iterations);
+			return std::chrono::duration_cast<std::chrono::nanoseconds>(Clock_t::now() - begin);
+		};
+
+		// calibrate iterations per sample; this doubles as warm up
+		std::size_t iterations = 1;
+		while (measure(iterations) < minSampleTime && iterations < (std::size_t(1) << 30))
+			iterations *= 2;
+
+		std::vector<double> nsPerOp;
+		nsPerOp.reserve(sampleCount);
+		double totalNs = 0;
+		for (std::size_t i = 0; i < sampleCount; ++i)
+		{
+			auto ns = static_cast<double>(measure(iterations).count());
+			totalNs += ns;
+			nsPerOp.push_back(ns / static_cast<double>(iterations * benchmark.opsPerIteration));
+		}
+		std::sort(std::begin(nsPerOp), std::end(nsPerOp));
+
+		auto percentile = [&nsPerOp](double p)
+		{
+			auto index = static_cast<std::size_t>(p * static_cast<double>(nsPerOp.size() - 1) + 0.5);
+			return nsPerOp[index];
+		};
+
+		auto totalOps = static_cast<double>(sampleCount * iterations * benchmark.opsPerIteration);
+		return {
+			benchmark.name,
+			totalNs / totalOps,
+			totalOps / (totalNs * 1e-9),
+			percentile(0.5),
+			percentile(0.99),
+			sampleCount
+		};
+	}
+
+	// deterministic input generation, thus numbers are comparable between runs
+	template <class T>
+	[[nodiscard]] std::vector<T> makeRandomValues(std::size_t count, T min, T max, unsigned seed = 1337)
+	{
+		std::mt19937 engine{ seed };
+		std::vector<T> values(count);
+		if constexpr (std::is_integral_v<T>)
+		{
+			std::uniform_int_distribution<T> dist{ min, max };
+			std::generate(std::begin(values), std::end(values), [&]() { return dist(engine); });
+		}
+		else
+		{
+			std::uniform_real_distribution<T> dist{ min, max };
+			std::generate(std::begin(values), std::end(values), [&]() { return dist(engine); });
+		}
+		return values;
+	}
+}
+
+#endif
@@ -0,0 +1,126 @@
+//          Copyright Dominic Koepke 2017 - 2020.
+// Distributed under the Boost Software License, Version 1.0.
+//    (See accompanying file LICENSE_1_0.txt or copy at
+//          https://www.boost.org/LICENSE_1_0.txt)
+
+#include "Benchmark.hpp"
+
+#include <span>
+#include <string>
+#include <vector>
+
+#include "georithm/Intersection.hpp"
+#include "georithm/Line.hpp"
+#include "georithm/LineSoA.hpp"
+#include "georithm/SweepIntersection.hpp"
+#include "georithm/Vector.hpp"
+
+namespace
+{
+	using namespace georithm;
+	using namespace georithm::bench;
+
+	constexpr std::size_t segmentCount = 1024;
+	// short segments spread over a large area, like the edges of a road network
+	constexpr std::size_t networkSegmentCount = 4096;
+
+	template <class T>
+	std::vector<Segment<Vector<T, 2>>> makeSegments(std::size_t count, unsigned seed)
+	{
+		auto locations = makeRandomValues<T>(count * 2, T(-100), T(100), seed);
+		auto directions = makeRandomValues<T>(count * 2, T(-20), T(20), seed + 1);
+		std::vector<Segment<Vector<T, 2>>> segments(count);
+		for (std::size_t i = 0; i < count; ++i)
+			segments[i] = { { locations[2 * i], locations[2 * i + 1] }, { directions[2 * i], directions[2 * i + 1] } };
+		return segments;
+	}
+
+	template <class T>
+	void registerLineBenchmarks(const std::string& typeName)
+	{
+		using Vector_t = Vector<T, 2>;
+		const Segment<Vector_t> segment{ { T(-50), T(-30) }, { T(100), T(70) } };
+
+		registerBenchmark("intersection(segment<" + typeName + ">, segment) batch",
+						segmentCount,
+						[segment, segments = makeSegments<T>(segmentCount, 1), results = std::vector<LineIntersectionResult>(segmentCount),
+							lhsDistances = std::vector<T>(segmentCount), rhsDistances = std::vector<T>(segmentCount)](std::size_t iterations) mutable
+						{
+							for (std::size_t i = 0; i < iterations; ++i)
+							{
+								for (std::size_t j = 0; j < segmentCount; ++j)
+									std::tie(results[j], lhsDistances[j], rhsDistances[j]) = intersection(segment, segments[j]);
+								doNotOptimize(results.data());
+								doNotOptimize(lhsDistances.data());
+								doNotOptimize(rhsDistances.data());
+							}
+						}
+		);
+
+		registerBenchmark("intersection(segment<" + typeName + ">, SegmentSoA)",
+						segmentCount,
+						[segment, segments = SegmentSoA<T>{ makeSegments<T>(segmentCount, 1) }, results = std::vector<LineIntersectionResult>(segmentCount),
+							lhsDistances = std::vector<T>(segmentCount), rhsDistances = std::vector<T>(segmentCount)](std::size_t iterations) mutable
+						{
+							for (std::size_t i = 0; i < iterations; ++i)
+							{
+								intersection(segment, segments, std::span{ results }, std::span{ lhsDistances }, std::span{ rhsDistances });
+								doNotOptimize(results.data());
+								doNotOptimize(lhsDistances.data());
+								doNotOptimize(rhsDistances.data());
+							}
+						}
+		);
+	}
+
+	void registerAllPairsBenchmarks()
+	{
+		auto segments = makeSegments<double>(networkSegmentCount, 3);
+		for (auto& segment : segments)
+			segment.location() *= 10.;
+
+		registerBenchmark("all intersecting pairs of segment<double> brute force",
+						networkSegmentCount,
+						[segments](std::size_t iterations)
+						{
+							for (std::size_t i = 0; i < iterations; ++i)
+							{
+								std::size_t count = 0;
+								for (std::size_t lhs = 0; lhs < std::size(segments); ++lhs)
+								{
+									for (std::size_t rhs = lhs + 1; rhs < std::size(segments); ++rhs)
+									{
+										if (std::get<0>(intersection(segments[lhs], segments[rhs])) == LineIntersectionResult::intersecting)
+											++count;
+									}
+								}
+								doNotOptimize(count);
+							}
+						}
+		);
+
+		registerBenchmark("all intersecting pairs of segment<double> sweep",
+						networkSegmentCount,
+						[segments](std::size_t iterations)
+						{
+							for (std::size_t i = 0; i < iterations; ++i)
+							{
+								std::size_t count = 0;
+								forEachIntersectingPair(segments, [&count](auto&&...) { ++count; });
+								doNotOptimize(count);
+							}
+						}
+		);
+	}
+
+	const Registrar lineBenchmarks
+	{
+		[]()
+		{
+			registerLineBenchmarks<float>("float");
+			registerLineBenchmarks<double>("double");
+			registerLineBenchmarks<int>("int");
+			registerAllPairsBenchmarks();
+		}
+	};
+}
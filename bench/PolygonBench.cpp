@@ -0,0 +1,213 @@
+//          Copyright Dominic Koepke 2017 - 2020.
+// Distributed under the Boost Software License, Version 1.0.
+//    (See accompanying file LICENSE_1_0.txt or copy at
+//          https://www.boost.org/LICENSE_1_0.txt)
+
+#include "Benchmark.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <numbers>
+#include <string>
+#include <vector>
+
+#include "georithm/Bounding.hpp"
+#include "georithm/Contains.hpp"
+#include "georithm/ConvexHull.hpp"
+#include "georithm/Execution.hpp"
+#include "georithm/Overlaps.hpp"
+#include "georithm/Polygon.hpp"
+#include "georithm/Rect.hpp"
+#include "georithm/Vector.hpp"
+
+#include "georithm/transform/Rotate.hpp"
+#include "georithm/transform/Translate.hpp"
+
+namespace
+{
+	using namespace georithm;
+	using namespace georithm::bench;
+
+	constexpr std::size_t pointCount = 1024;
+
+	template <class T>
+	std::vector<Vector<T, 2>> makePoints(std::size_t count, unsigned seed)
+	{
+		auto values = makeRandomValues<T>(count * 2, T(-100), T(100), seed);
+		std::vector<Vector<T, 2>> points(count);
+		for (std::size_t i = 0; i < count; ++i)
+			points[i] = { values[2 * i], values[2 * i + 1] };
+		return points;
+	}
+
+	template <class T>
+	Polygon<Vector<T, 2>> makeStar(std::size_t spikes)
+	{
+		Polygon<Vector<T, 2>> star;
+		for (std::size_t i = 0; i < 2 * spikes; ++i)
+		{
+			auto radius = i % 2 == 0 ? 90. : 40.;
+			auto angle = std::numbers::pi * static_cast<double>(i) / static_cast<double>(spikes);
+			star.vertices().emplace_back(static_cast<T>(radius * std::cos(angle)), static_cast<T>(radius * std::sin(angle)));
+		}
+		return star;
+	}
+
+	template <class TPolygon>
+	void registerContainsBenchmarks(const std::string& name, TPolygon polygon)
+	{
+		using T = typename GeometricTraits<TPolygon>::ValueType;
+
+		registerBenchmark("contains(" + name + ", point) batch",
+						pointCount,
+						[polygon, points = makePoints<T>(pointCount, 1), results = std::vector<char>(pointCount)](std::size_t iterations) mutable
+						{
+							for (std::size_t i = 0; i < iterations; ++i)
+							{
+								for (std::size_t j = 0; j < pointCount; ++j)
+									results[j] = contains(polygon, points[j]);
+								doNotOptimize(results.data());
+							}
+						}
+		);
+
+		registerBenchmark("contains(" + name + ", points)",
+						pointCount,
+						[polygon, points = makePoints<T>(pointCount, 1), results = std::vector<char>(pointCount)](std::size_t iterations) mutable
+						{
+							for (std::size_t i = 0; i < iterations; ++i)
+							{
+								contains(polygon, points, std::begin(results));
+								doNotOptimize(results.data());
+							}
+						}
+		);
+	}
+
+	template <class T>
+	void registerPolygonBenchmarks(const std::string& typeName)
+	{
+		using Vector_t = Vector<T, 2>;
+
+		registerBenchmark("boundingRect(points<" + typeName + ">)",
+						pointCount,
+						[points = makePoints<T>(pointCount, 2)](std::size_t iterations)
+						{
+							for (std::size_t i = 0; i < iterations; ++i)
+							{
+								doNotOptimize(points.data());
+								doNotOptimize(boundingRect(points));
+							}
+						}
+		);
+
+		registerBenchmark("boundingRect(Polygon<" + typeName + ", 128>)",
+						128,
+						[polygon = makeStar<T>(64)](std::size_t iterations)
+						{
+							for (std::size_t i = 0; i < iterations; ++i)
+							{
+								doNotOptimize(polygon.vertices().data());
+								doNotOptimize(boundingRect(polygon));
+							}
+						}
+		);
+
+		registerBenchmark("overlaps(Polygon<" + typeName + ", 16>, rect)",
+						pointCount,
+						[star = makeStar<T>(8), points = makePoints<T>(pointCount, 3), results = std::vector<char>(pointCount)](std::size_t iterations) mutable
+						{
+							for (std::size_t i = 0; i < iterations; ++i)
+							{
+								for (std::size_t j = 0; j < pointCount; ++j)
+									results[j] = overlaps(star, AABB_t<T>{ points[j], { T(10), T(10) } });
+								doNotOptimize(results.data());
+							}
+						}
+		);
+
+		auto registerPolicy = [&](const std::string& policyName, const auto& policy)
+		{
+			std::vector<AABB_t<T>> rects;
+			for (auto& point : makePoints<T>(pointCount, 3))
+				rects.push_back({ point, { T(10), T(10) } });
+
+			registerBenchmark("overlaps(" + policyName + ", Polygon<" + typeName + ", 16>, rects)",
+							pointCount,
+							[policy, star = makeStar<T>(8), rects, results = std::vector<char>(pointCount)](std::size_t iterations) mutable
+							{
+								for (std::size_t i = 0; i < iterations; ++i)
+								{
+									overlaps(policy, star, rects, std::begin(results));
+									doNotOptimize(results.data());
+								}
+							}
+			);
+		};
+		registerPolicy("seq", execution::seq);
+		registerPolicy("unseq", execution::unseq);
+		registerPolicy("par_unseq", execution::par_unseq);
+
+		constexpr std::size_t hullPointCount = 1 << 20;
+		auto hullPoints = makePoints<T>(hullPointCount, 4);
+		registerBenchmark("convexHull(points<" + typeName + ">)",
+						hullPointCount,
+						[hullPoints](std::size_t iterations)
+						{
+							for (std::size_t i = 0; i < iterations; ++i)
+								doNotOptimize(convexHull(hullPoints));
+						}
+		);
+
+		registerBenchmark("convexHull(par, points<" + typeName + ">)",
+						hullPointCount,
+						[hullPoints](std::size_t iterations)
+						{
+							for (std::size_t i = 0; i < iterations; ++i)
+								doNotOptimize(convexHull(execution::par, hullPoints));
+						}
+		);
+
+		auto sortedPoints = hullPoints;
+		std::ranges::sort(sortedPoints, [](const Vector_t& lhs, const Vector_t& rhs) { return lhs.x() < rhs.x() || (lhs.x() == rhs.x() && lhs.y() < rhs.y()); });
+		registerBenchmark("convexHullSorted(points<" + typeName + ">)",
+						hullPointCount,
+						[sortedPoints](std::size_t iterations)
+						{
+							for (std::size_t i = 0; i < iterations; ++i)
+								doNotOptimize(convexHullSorted(sortedPoints));
+						}
+		);
+
+		registerBenchmark("IncrementalConvexHull<" + typeName + "> insert",
+						hullPointCount,
+						[hullPoints](std::size_t iterations)
+						{
+							for (std::size_t i = 0; i < iterations; ++i)
+							{
+								IncrementalConvexHull<Vector_t> hull;
+								hull.insert(hullPoints);
+								doNotOptimize(hull.hull());
+							}
+						}
+		);
+
+		registerContainsBenchmarks("Polygon<" + typeName + ", 16>", makeStar<T>(8));
+		registerContainsBenchmarks("Polygon<" + typeName + ", 128>", makeStar<T>(64));
+
+		Rect<T, transform::Rotate<Vector_t>, transform::Translate<Vector_t>> rect{ { T(-40), T(-30) }, { T(80), T(60) } };
+		rect.rotation() = 0.7;
+		rect.translation() = { T(5), T(-5) };
+		registerContainsBenchmarks("Rect<" + typeName + ", Rotate, Translate>", rect);
+	}
+
+	const Registrar polygonBenchmarks
+	{
+		[]()
+		{
+			registerPolygonBenchmarks<float>("float");
+			registerPolygonBenchmarks<double>("double");
+			registerPolygonBenchmarks<int>("int");
+		}
+	};
+}
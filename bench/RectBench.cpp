@@ -0,0 +1,214 @@
+//          Copyright Dominic Koepke 2017 - 2020.
+// Distributed under the Boost Software License, Version 1.0.
+//    (See accompanying file LICENSE_1_0.txt or copy at
+//          https://www.boost.org/LICENSE_1_0.txt)
+
+#include "Benchmark.hpp"
+
+#include <numbers>
+#include <string>
+#include <tuple>
+
+#include "georithm/Bounding.hpp"
+#include "georithm/CachedRect.hpp"
+#include "georithm/Contains.hpp"
+#include "georithm/Intersection.hpp"
+#include "georithm/Intersects.hpp"
+#include "georithm/Line.hpp"
+#include "georithm/Overlaps.hpp"
+#include "georithm/Rect.hpp"
+#include "georithm/Vector.hpp"
+
+#include "georithm/transform/Affine.hpp"
+#include "georithm/transform/PrecomputedRotate.hpp"
+#include "georithm/transform/Rotate.hpp"
+#include "georithm/transform/Scale.hpp"
+#include "georithm/transform/Shear.hpp"
+#include "georithm/transform/Translate.hpp"
+
+namespace
+{
+	using namespace georithm;
+	using namespace georithm::bench;
+
+	constexpr std::size_t batchSize = 256;
+
+	template <class TRect>
+	std::vector<TRect> makeRects(std::size_t count, unsigned seed)
+	{
+		if constexpr (requires { typename TRect::RectType; })
+		{
+			auto rects = makeRects<typename TRect::RectType>(count, seed);
+			return { std::begin(rects), std::end(rects) };
+		}
+
+		using T = typename TRect::ValueType;
+		auto positions = makeRandomValues<T>(count * 2, T(-50), T(50), seed);
+		auto spans = makeRandomValues<T>(count * 2, T(1), T(20), seed + 1);
+		auto rotations = makeRandomValues<double>(count, 0., 2 * std::numbers::pi, seed + 2);
+		auto factors = makeRandomValues<double>(count * 2, 0.5, 2., seed + 3);
+
+		std::vector<TRect> rects(count);
+		for (std::size_t i = 0; i < count; ++i)
+		{
+			auto configure = [&](auto& target)
+			{
+				if constexpr (requires { target.rotation(rotations[i]); })
+					target.rotation(static_cast<std::remove_cvref_t<decltype(target.rotation())>>(rotations[i]));
+				else if constexpr (requires { target.rotation(); })
+					target.rotation() = static_cast<std::remove_cvref_t<decltype(target.rotation())>>(rotations[i]);
+				if constexpr (requires { target.scale(); })
+					target.scale() = { static_cast<T>(factors[2 * i] + 0.5), static_cast<T>(factors[2 * i + 1] + 0.5) };
+				if constexpr (requires { target.shear(); })
+					target.shear() = { static_cast<T>(factors[2 * i] - 1), T(0) };
+				if constexpr (requires { target.translation(); })
+					target.translation() = { static_cast<T>(factors[2 * i] * 2), static_cast<T>(factors[2 * i + 1] * -2) };
+			};
+
+			auto& rect = rects[i];
+			rect.position() = { positions[2 * i], positions[2 * i + 1] };
+			rect.span() = { spans[2 * i], spans[2 * i + 1] };
+			configure(rect);
+			if constexpr (requires { rect.components(); })
+				std::apply([&](auto&... components) { (configure(components), ...); }, rect.components());
+		}
+		return rects;
+	}
+
+	template <class TItem, class TOp>
+	void registerMicroAndBatch(const std::string& name, const std::vector<TItem>& items, TOp op)
+	{
+		registerBenchmark(name + " micro",
+						1,
+						[op, lhs = items[0], rhs = items[1]](std::size_t iterations)
+						{
+							for (std::size_t i = 0; i < iterations; ++i)
+							{
+								doNotOptimize(lhs);
+								doNotOptimize(rhs);
+								doNotOptimize(op(lhs, rhs));
+							}
+						}
+		);
+
+		// every item is tested against its successor, which results in a good mixture of hits and misses
+		registerBenchmark(name + " batch",
+						items.size() - 1,
+						[op, items](std::size_t iterations)
+						{
+							for (std::size_t i = 0; i < iterations; ++i)
+							{
+								for (std::size_t j = 1; j < std::size(items); ++j)
+									doNotOptimize(op(items[j - 1], items[j]));
+							}
+						}
+		);
+	}
+
+	template <class TRect>
+	void registerRectBenchmarks(const std::string& rectName)
+	{
+		using T = typename TRect::ValueType;
+		using Vector_t = typename TRect::VectorType;
+
+		auto rects = makeRects<TRect>(batchSize, 42);
+
+		registerBenchmark(rectName + " boundingRect micro",
+						1,
+						[rect = rects[0]](std::size_t iterations)
+						{
+							for (std::size_t i = 0; i < iterations; ++i)
+							{
+								doNotOptimize(rect);
+								doNotOptimize(boundingRect(rect));
+							}
+						}
+		);
+
+		registerBenchmark(rectName + " boundingRect batch",
+						batchSize,
+						[rects](std::size_t iterations)
+						{
+							for (std::size_t i = 0; i < iterations; ++i)
+							{
+								for (const auto& rect : rects)
+									doNotOptimize(boundingRect(rect));
+							}
+						}
+		);
+
+		registerMicroAndBatch(rectName + " intersects(rect, rect)",
+							rects,
+							[](const TRect& lhs, const TRect& rhs) { return intersects(lhs, rhs); }
+		);
+
+		registerMicroAndBatch(rectName + " overlaps(rect, rect)",
+							rects,
+							[](const TRect& lhs, const TRect& rhs) { return overlaps(lhs, rhs); }
+		);
+
+		registerMicroAndBatch(rectName + " contains(rect, point)",
+							rects,
+							[](const TRect& lhs, const TRect& rhs) { return contains(lhs, rhs.position()); }
+		);
+
+		std::vector<Segment<Vector_t>> segments;
+		auto directions = makeRandomValues<T>(batchSize * 2, T(-30), T(30), 7);
+		for (std::size_t i = 0; i < batchSize; ++i)
+			segments.emplace_back(rects[i].position(), Vector_t{ directions[2 * i], directions[2 * i + 1] });
+
+		registerBenchmark(rectName + " intersects(segment, rect) batch",
+						batchSize - 1,
+						[rects, segments](std::size_t iterations)
+						{
+							for (std::size_t i = 0; i < iterations; ++i)
+							{
+								for (std::size_t j = 1; j < batchSize; ++j)
+									doNotOptimize(intersects(segments[j - 1], rects[j]));
+							}
+						}
+		);
+
+		registerBenchmark(rectName + " intersection(segment, rect) batch",
+						batchSize - 1,
+						[rects, segments](std::size_t iterations)
+						{
+							for (std::size_t i = 0; i < iterations; ++i)
+							{
+								for (std::size_t j = 1; j < batchSize; ++j)
+									doNotOptimize(intersection(segments[j - 1], rects[j]));
+							}
+						}
+		);
+	}
+
+	template <class T>
+	void registerRectBenchmarksFor(const std::string& typeName)
+	{
+		using Vector_t = Vector<T, 2>;
+		using Rotate_t = transform::Rotate<Vector_t>;
+		using Scale_t = transform::Scale<Vector_t>;
+		using Shear_t = transform::Shear<Vector_t>;
+		using Translate_t = transform::Translate<Vector_t>;
+
+		registerRectBenchmarks<Rect<T>>("AABB_t<" + typeName + ">");
+		registerRectBenchmarks<Rect<T, Rotate_t>>("Rect<" + typeName + ", R>");
+		registerRectBenchmarks<Rect<T, Rotate_t, Translate_t>>("Rect<" + typeName + ", R, T>");
+		registerRectBenchmarks<Rect<T, Rotate_t, Scale_t, Translate_t>>("Rect<" + typeName + ", R, Sc, T>");
+		registerRectBenchmarks<Rect<T, Rotate_t, Scale_t, Shear_t, Translate_t>>("Rect<" + typeName + ", R, Sc, Sh, T>");
+		registerRectBenchmarks<Rect<T, transform::PrecomputedRotate<Vector_t>, Translate_t>>("Rect<" + typeName + ", PR, T>");
+		registerRectBenchmarks<Rect<T, transform::AffineChain<Vector_t, Rotate_t, Scale_t, Shear_t, Translate_t>>>(
+			"Rect<" + typeName + ", Chain<R, Sc, Sh, T>>");
+		registerRectBenchmarks<CachedRect<Rect<T, Rotate_t, Translate_t>>>("CachedRect<" + typeName + ", R, T>");
+	}
+
+	const Registrar rectBenchmarks
+	{
+		[]()
+		{
+			registerRectBenchmarksFor<float>("float");
+			registerRectBenchmarksFor<double>("double");
+			registerRectBenchmarksFor<int>("int");
+		}
+	};
+}
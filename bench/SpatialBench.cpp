@@ -0,0 +1,455 @@
+//          Copyright Dominic Koepke 2017 - 2020.
+// Distributed under the Boost Software License, Version 1.0.
+//    (See accompanying file LICENSE_1_0.txt or copy at
+//          https://www.boost.org/LICENSE_1_0.txt)
+
+#include "Benchmark.hpp"
+
+#include <cmath>
+#include <string>
+#include <vector>
+
+#include "georithm/BatchQuery.hpp"
+#include "georithm/BinnedSahBvh.hpp"
+#include "georithm/Bounding.hpp"
+#include "georithm/DynamicAABBTree.hpp"
+#include "georithm/Line.hpp"
+#include "georithm/LinearBvh.hpp"
+#include "georithm/PackedRTree.hpp"
+#include "georithm/Rect.hpp"
+#include "georithm/SweepAndPrune.hpp"
+#include "georithm/UniformGrid.hpp"
+#include "georithm/Vector.hpp"
+
+#include "georithm/transform/Rotate.hpp"
+#include "georithm/transform/Translate.hpp"
+
+namespace
+{
+	using namespace georithm;
+	using namespace georithm::bench;
+
+	constexpr std::size_t objectCount = 2000;
+	constexpr std::size_t particleCount = 1'000'000;
+
+	template <class T>
+	std::vector<AABB_t<T>> makeBoxes(std::size_t count, unsigned seed)
+	{
+		auto positions = makeRandomValues<T>(count * 2, T(0), T(1000), seed);
+		auto spans = makeRandomValues<T>(count * 2, T(1), T(20), seed + 1);
+		std::vector<AABB_t<T>> boxes(count);
+		for (std::size_t i = 0; i < count; ++i)
+			boxes[i] = { { positions[2 * i], positions[2 * i + 1] }, { spans[2 * i], spans[2 * i + 1] } };
+		return boxes;
+	}
+
+	template <class T>
+	void registerSpatialBenchmarks(const std::string& typeName)
+	{
+		registerBenchmark("brute force pairs<" + typeName + ">",
+						objectCount,
+						[boxes = makeBoxes<T>(objectCount, 1)](std::size_t iterations)
+						{
+							for (std::size_t i = 0; i < iterations; ++i)
+							{
+								std::size_t count = 0;
+								for (std::size_t lhs = 0; lhs < std::size(boxes); ++lhs)
+								{
+									for (std::size_t rhs = lhs + 1; rhs < std::size(boxes); ++rhs)
+										count += detail::intersectsBounds(boxes[lhs], boxes[rhs]);
+								}
+								doNotOptimize(count);
+							}
+						}
+		);
+
+		registerBenchmark("DynamicAABBTree<" + typeName + "> build",
+						objectCount,
+						[boxes = makeBoxes<T>(objectCount, 1)](std::size_t iterations)
+						{
+							for (std::size_t i = 0; i < iterations; ++i)
+							{
+								DynamicAABBTree<T> tree{ T(1) };
+								for (std::size_t j = 0; j < std::size(boxes); ++j)
+									tree.insert(boxes[j], j);
+								doNotOptimize(tree.height());
+							}
+						}
+		);
+
+		auto makeTree = [](const std::vector<AABB_t<T>>& boxes)
+		{
+			DynamicAABBTree<T> tree{ T(1) };
+			for (std::size_t j = 0; j < std::size(boxes); ++j)
+				tree.insert(boxes[j], j);
+			return tree;
+		};
+
+		registerBenchmark("DynamicAABBTree<" + typeName + "> pairs",
+						objectCount,
+						[tree = makeTree(makeBoxes<T>(objectCount, 1))](std::size_t iterations)
+						{
+							for (std::size_t i = 0; i < iterations; ++i)
+							{
+								std::size_t count = 0;
+								tree.forEachOverlappingPair([&count](auto, auto) { ++count; });
+								doNotOptimize(count);
+							}
+						}
+		);
+
+		registerBenchmark("DynamicAABBTree<" + typeName + "> query",
+						objectCount,
+						[boxes = makeBoxes<T>(objectCount, 2), tree = makeTree(makeBoxes<T>(objectCount, 1))](std::size_t iterations)
+						{
+							for (std::size_t i = 0; i < iterations; ++i)
+							{
+								std::size_t count = 0;
+								for (auto& box : boxes)
+									tree.query(box, [&count](auto) { ++count; });
+								doNotOptimize(count);
+							}
+						}
+		);
+
+		registerBenchmark("DynamicAABBTree<" + typeName + "> move",
+						objectCount,
+						[boxes = makeBoxes<T>(objectCount, 1), tree = makeTree(makeBoxes<T>(objectCount, 1)),
+							offsets = makeRandomValues<T>(objectCount * 2, T(-2), T(2), 3)](std::size_t iterations) mutable
+						{
+							for (std::size_t i = 0; i < iterations; ++i)
+							{
+								for (std::size_t j = 0; j < std::size(boxes); ++j)
+								{
+									Vector<T, 2> offset{ offsets[2 * j], offsets[2 * j + 1] };
+									boxes[j].position() += (i % 2 == 0) ? offset : offset * T(-1);
+									doNotOptimize(tree.move(j, boxes[j]));
+								}
+							}
+						}
+		);
+
+		registerBenchmark("PackedRTree<" + typeName + "> build",
+						objectCount,
+						[boxes = makeBoxes<T>(objectCount, 1)](std::size_t iterations)
+						{
+							for (std::size_t i = 0; i < iterations; ++i)
+							{
+								PackedRTree<T> tree{ boxes };
+								doNotOptimize(tree.levelCount());
+							}
+						}
+		);
+
+		registerBenchmark("PackedRTree<" + typeName + "> query",
+						objectCount,
+						[boxes = makeBoxes<T>(objectCount, 2), tree = PackedRTree<T>{ makeBoxes<T>(objectCount, 1) }](std::size_t iterations)
+						{
+							for (std::size_t i = 0; i < iterations; ++i)
+							{
+								std::size_t count = 0;
+								for (auto& box : boxes)
+									tree.query(box, [&count](auto) { ++count; });
+								doNotOptimize(count);
+							}
+						}
+		);
+
+		registerBenchmark("LinearBvh<" + typeName + "> build",
+						objectCount,
+						[boxes = makeBoxes<T>(objectCount, 1)](std::size_t iterations)
+						{
+							for (std::size_t i = 0; i < iterations; ++i)
+							{
+								auto bvh = buildLinearBvh(boxes);
+								doNotOptimize(bvh.size());
+							}
+						}
+		);
+
+		registerBenchmark("LinearBvh<" + typeName + "> query",
+						objectCount,
+						[boxes = makeBoxes<T>(objectCount, 2), bvh = buildLinearBvh(makeBoxes<T>(objectCount, 1))](std::size_t iterations)
+						{
+							for (std::size_t i = 0; i < iterations; ++i)
+							{
+								std::size_t count = 0;
+								for (auto& box : boxes)
+									bvh.query(box, [&count](auto) { ++count; });
+								doNotOptimize(count);
+							}
+						}
+		);
+
+		// each frame moves all objects back and forth by a small offset and collects the changed pairs
+		auto makeSweepAndPrune = [](const std::vector<AABB_t<T>>& boxes)
+		{
+			SweepAndPrune<T> broadPhase;
+			for (std::size_t i = 0; i < std::size(boxes); ++i)
+				broadPhase.insert(boxes[i], i);
+			broadPhase.update();
+			return broadPhase;
+		};
+
+		registerBenchmark("SweepAndPrune<" + typeName + "> frame",
+						objectCount,
+						[boxes = makeBoxes<T>(objectCount, 1), broadPhase = makeSweepAndPrune(makeBoxes<T>(objectCount, 1)),
+							offsets = makeRandomValues<T>(objectCount * 2, T(-2), T(2), 3)](std::size_t iterations) mutable
+						{
+							for (std::size_t i = 0; i < iterations; ++i)
+							{
+								for (std::size_t j = 0; j < std::size(boxes); ++j)
+								{
+									Vector<T, 2> offset{ offsets[2 * j], offsets[2 * j + 1] };
+									boxes[j].position() += (i % 2 == 0) ? offset : offset * T(-1);
+									broadPhase.move(j, boxes[j]);
+								}
+								std::size_t changes = 0;
+								broadPhase.update([&changes](auto, auto) { ++changes; }, [&changes](auto, auto) { ++changes; });
+								doNotOptimize(changes);
+							}
+						}
+		);
+
+		auto makeGrid = [](const std::vector<AABB_t<T>>& boxes)
+		{
+			UniformGrid<T> grid{ T(20) };
+			grid.rebuild(boxes);
+			return grid;
+		};
+
+		registerBenchmark("UniformGrid<" + typeName + "> rebuild",
+						objectCount,
+						[boxes = makeBoxes<T>(objectCount, 1), grid = UniformGrid<T>{ T(20) }](std::size_t iterations) mutable
+						{
+							for (std::size_t i = 0; i < iterations; ++i)
+							{
+								grid.rebuild(boxes);
+								doNotOptimize(grid.size());
+							}
+						}
+		);
+
+		registerBenchmark("UniformGrid<" + typeName + "> pairs",
+						objectCount,
+						[grid = makeGrid(makeBoxes<T>(objectCount, 1))](std::size_t iterations)
+						{
+							for (std::size_t i = 0; i < iterations; ++i)
+							{
+								std::size_t count = 0;
+								grid.forEachOverlappingPair([&count](auto, auto) { ++count; });
+								doNotOptimize(count);
+							}
+						}
+		);
+
+		registerBenchmark("UniformGrid<" + typeName + "> query",
+						objectCount,
+						[boxes = makeBoxes<T>(objectCount, 2), grid = makeGrid(makeBoxes<T>(objectCount, 1))](std::size_t iterations)
+						{
+							for (std::size_t i = 0; i < iterations; ++i)
+							{
+								std::size_t count = 0;
+								for (auto& box : boxes)
+									grid.query(box, [&count](auto) { ++count; });
+								doNotOptimize(count);
+							}
+						}
+		);
+	}
+
+	// segments of about a tenth of the scene size, which are tested against the edges of all candidates
+	template <class T>
+	void registerRaycastBenchmarks(const std::string& typeName)
+	{
+		auto makeSegments = []()
+		{
+			auto origins = makeRandomValues<T>(objectCount * 2, T(0), T(1000), 7);
+			auto directions = makeRandomValues<T>(objectCount * 2, T(-100), T(100), 8);
+			std::vector<Segment<Vector<T, 2>>> segments;
+			for (std::size_t i = 0; i < objectCount; ++i)
+				segments.emplace_back(Vector<T, 2>{ origins[2 * i], origins[2 * i + 1] }, Vector<T, 2>{ directions[2 * i], directions[2 * i + 1] });
+			return segments;
+		};
+
+		auto registerRaycast = [&](const std::string& name, auto bvh, auto boxes)
+		{
+			registerBenchmark(name + "<" + typeName + "> raycast",
+							objectCount,
+							[segments = makeSegments(), bvh = std::move(bvh), boxes = std::move(boxes)](std::size_t iterations)
+							{
+								for (std::size_t i = 0; i < iterations; ++i)
+								{
+									T sum{};
+									for (auto& segment : segments)
+										bvh.forEachIntersection(boxes, segment, [&sum](auto, T lineDist, const auto&, T) { sum += lineDist; });
+									doNotOptimize(sum);
+								}
+							}
+			);
+		};
+
+		// level like scene: clusters of objects, whose sizes span two orders of magnitude, where every third one is a thin wall
+		auto clusterCentres = makeRandomValues<T>(40, T(0), T(1000), 9);
+		auto offsets = makeRandomValues<T>(objectCount * 2, T(-60), T(60), 10);
+		auto exponents = makeRandomValues<double>(objectCount * 2, 0., 5.3, 11);
+		std::vector<AABB_t<T>> boxes(objectCount);
+		for (std::size_t i = 0; i < objectCount; ++i)
+		{
+			auto cluster = 2 * (i % 20);
+			Vector<T, 2> span{ static_cast<T>(std::exp(exponents[2 * i])), static_cast<T>(std::exp(exponents[2 * i + 1])) };
+			if (i % 3 == 0)
+				span.y() /= T(20);
+			boxes[i] = { { clusterCentres[cluster] + offsets[2 * i], clusterCentres[cluster + 1] + offsets[2 * i + 1] }, span };
+		}
+		registerRaycast("LinearBvh", buildLinearBvh(boxes), boxes);
+		registerRaycast("BinnedSahBvh", buildBinnedSahBvh(boxes), boxes);
+
+		registerBenchmark("BinnedSahBvh<" + typeName + "> build",
+						objectCount,
+						[boxes](std::size_t iterations)
+						{
+							for (std::size_t i = 0; i < iterations; ++i)
+							{
+								auto bvh = buildBinnedSahBvh(boxes);
+								doNotOptimize(bvh.size());
+							}
+						}
+		);
+	}
+
+	// particle like workload: many small objects of about the same size in a dense area
+	void registerParticleBenchmarks()
+	{
+		auto positions = makeRandomValues<float>(particleCount * 2, 0.f, 10000.f, 5);
+		auto spans = makeRandomValues<float>(particleCount * 2, 1.f, 4.f, 6);
+		std::vector<AABB_t<float>> particles(particleCount);
+		for (std::size_t i = 0; i < particleCount; ++i)
+			particles[i] = { { positions[2 * i], positions[2 * i + 1] }, { spans[2 * i], spans[2 * i + 1] } };
+
+		registerBenchmark("UniformGrid<float> rebuild 1M particles",
+						particleCount,
+						[particles, grid = UniformGrid<float>{ 4.f }](std::size_t iterations) mutable
+						{
+							for (std::size_t i = 0; i < iterations; ++i)
+							{
+								grid.rebuild(particles);
+								doNotOptimize(grid.size());
+							}
+						}
+		);
+
+		registerBenchmark("LinearBvh<float> build 1M particles",
+						particleCount,
+						[particles](std::size_t iterations)
+						{
+							for (std::size_t i = 0; i < iterations; ++i)
+							{
+								auto bvh = buildLinearBvh(particles);
+								doNotOptimize(bvh.size());
+							}
+						}
+		);
+
+		// each particle queries its own neighbourhood, once one after another and once as batch on the default pool
+		registerBenchmark("LinearBvh<float> query 1M particles",
+						particleCount,
+						[particles, bvh = buildLinearBvh(particles)](std::size_t iterations)
+						{
+							for (std::size_t i = 0; i < iterations; ++i)
+							{
+								std::size_t count = 0;
+								for (auto& particle : particles)
+									bvh.query(particle, [&count](auto) { ++count; });
+								doNotOptimize(count);
+							}
+						}
+		);
+
+		registerBenchmark("LinearBvh<float> batch query 1M particles",
+						particleCount,
+						[particles, bvh = buildLinearBvh(particles)](std::size_t iterations)
+						{
+							for (std::size_t i = 0; i < iterations; ++i)
+							{
+								auto result = batchQuery(bvh, particles);
+								doNotOptimize(std::size(result.values()));
+							}
+						}
+		);
+
+		registerBenchmark("SweepAndPrune<float> frame 1M particles",
+						particleCount,
+						[particles, broadPhase = SweepAndPrune<float>{}, offsets = makeRandomValues<float>(particleCount * 2, -0.02f, 0.02f, 8)](std::size_t iterations) mutable
+						{
+							if (broadPhase.empty())
+							{
+								for (std::size_t i = 0; i < std::size(particles); ++i)
+									broadPhase.insert(particles[i], i);
+								broadPhase.update();
+							}
+
+							for (std::size_t i = 0; i < iterations; ++i)
+							{
+								for (std::size_t j = 0; j < std::size(particles); ++j)
+								{
+									Vector<float, 2> offset{ offsets[2 * j], offsets[2 * j + 1] };
+									particles[j].position() += (i % 2 == 0) ? offset : offset * -1.f;
+									broadPhase.move(j, particles[j]);
+								}
+								std::size_t changes = 0;
+								broadPhase.update([&changes](auto, auto) { ++changes; }, [&changes](auto, auto) { ++changes; });
+								doNotOptimize(changes);
+							}
+						}
+		);
+
+		// rotated and translated rects, whose bounds are recomputed each frame
+		using MovingRect_t = Rect<float, transform::Rotate<Vector<float, 2>>, transform::Translate<Vector<float, 2>>>;
+		auto rotations = makeRandomValues<float>(particleCount, 0.f, 6.f, 7);
+		std::vector<MovingRect_t> movingRects;
+		movingRects.reserve(particleCount);
+		for (std::size_t i = 0; i < particleCount; ++i)
+		{
+			auto& rect = movingRects.emplace_back(particles[i].position(), particles[i].span());
+			rect.rotation() = rotations[i];
+		}
+
+		registerBenchmark("LinearBvh<float> rebuild 1M moving rects",
+						particleCount,
+						[movingRects](std::size_t iterations)
+						{
+							for (std::size_t i = 0; i < iterations; ++i)
+							{
+								auto bvh = buildLinearBvh(movingRects);
+								doNotOptimize(bvh.size());
+							}
+						}
+		);
+
+		registerBenchmark("LinearBvh<float> refit 1M moving rects",
+						particleCount,
+						[movingRects, bvh = buildLinearBvh(movingRects)](std::size_t iterations) mutable
+						{
+							for (std::size_t i = 0; i < iterations; ++i)
+							{
+								bvh.refit(movingRects, defaultThreadPool());
+								doNotOptimize(bvh.bounds());
+							}
+						}
+		);
+	}
+
+	const Registrar spatialBenchmarks
+	{
+		[]()
+		{
+			registerSpatialBenchmarks<float>("float");
+			registerSpatialBenchmarks<double>("double");
+			registerSpatialBenchmarks<int>("int");
+			registerRaycastBenchmarks<float>("float");
+			registerRaycastBenchmarks<double>("double");
+			registerParticleBenchmarks();
+		}
+	};
+}
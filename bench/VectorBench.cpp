@@ -0,0 +1,165 @@
+//          Copyright Dominic Koepke 2017 - 2020.
+// Distributed under the Boost Software License, Version 1.0.
+//    (See accompanying file LICENSE_1_0.txt or copy at
+//          https://www.boost.org/LICENSE_1_0.txt)
+
+#include "Benchmark.hpp"
+
+#include <numbers>
+#include <string>
+
+#include "georithm/Vector.hpp"
+#include "georithm/VectorSoA.hpp"
+
+#include "georithm/transform/PrecomputedRotate.hpp"
+#include "georithm/transform/Rotate.hpp"
+#include "georithm/transform/Scale.hpp"
+#include "georithm/transform/Shear.hpp"
+#include "georithm/transform/Translate.hpp"
+
+namespace
+{
+	using namespace georithm;
+	using namespace georithm::bench;
+
+	constexpr std::size_t batchSize = 1024;
+
+	template <class T>
+	std::vector<Vector<T, 2>> makeVectors(std::size_t count, unsigned seed)
+	{
+		auto values = makeRandomValues<T>(count * 2, T(-100), T(100), seed);
+		std::vector<Vector<T, 2>> vectors(count);
+		for (std::size_t i = 0; i < count; ++i)
+			vectors[i] = { values[2 * i], values[2 * i + 1] };
+		return vectors;
+	}
+
+	template <class TTransformer>
+	void registerTransformer(const std::string& name, TTransformer transformer)
+	{
+		using Vector_t = typename TTransformer::VectorType;
+		using T = typename Vector_t::ValueType;
+
+		registerBenchmark(name + " micro",
+						1,
+						[transformer, vec = Vector_t{ T(3), T(7) }](std::size_t iterations)
+						{
+							for (std::size_t i = 0; i < iterations; ++i)
+							{
+								doNotOptimize(vec);
+								doNotOptimize(transformer.transform(vec));
+							}
+						}
+		);
+
+		registerBenchmark(name + " batch",
+						batchSize,
+						[transformer, vectors = makeVectors<T>(batchSize, 1)](std::size_t iterations) mutable
+						{
+							for (std::size_t i = 0; i < iterations; ++i)
+							{
+								for (auto& vec : vectors)
+									vec = transformer.transform(vec);
+								doNotOptimize(vectors.data());
+							}
+						}
+		);
+	}
+
+	template <class T, class TArc>
+	void registerVectorBenchmarks(const std::string& typeName, TArc radian)
+	{
+		using Vector_t = Vector<T, 2>;
+
+		registerBenchmark("rotate<" + typeName + "> micro",
+						1,
+						[radian, vec = Vector_t{ T(3), T(7) }](std::size_t iterations)
+						{
+							for (std::size_t i = 0; i < iterations; ++i)
+							{
+								doNotOptimize(vec);
+								doNotOptimize(rotate(vec, radian));
+							}
+						}
+		);
+
+		registerBenchmark("rotate<" + typeName + "> batch",
+						batchSize,
+						[radians = makeRandomValues<TArc>(batchSize, TArc(0), TArc(2 * std::numbers::pi), 2),
+							vectors = makeVectors<T>(batchSize, 3)](std::size_t iterations)
+						{
+							for (std::size_t i = 0; i < iterations; ++i)
+							{
+								for (std::size_t j = 0; j < batchSize; ++j)
+									doNotOptimize(rotate(vectors[j], radians[j]));
+							}
+						}
+		);
+
+		registerBenchmark("rotate<" + typeName + "> uniform batch",
+						batchSize,
+						[radian, vectors = makeVectors<T>(batchSize, 4)](std::size_t iterations) mutable
+						{
+							for (std::size_t i = 0; i < iterations; ++i)
+							{
+								for (auto& vec : vectors)
+									vec = rotate(vec, radian);
+								doNotOptimize(vectors.data());
+							}
+						}
+		);
+
+		registerBenchmark("VectorSoA rotate<" + typeName + "> batch",
+						batchSize,
+						[radian, vectors = VectorSoA<T, 2>{ makeVectors<T>(batchSize, 4) }](std::size_t iterations) mutable
+						{
+							for (std::size_t i = 0; i < iterations; ++i)
+							{
+								vectors = rotate(std::move(vectors), radian);
+								doNotOptimize(vectors.lane(0).data());
+							}
+						}
+		);
+
+		registerBenchmark("lengthSq<" + typeName + "> batch",
+						batchSize,
+						[vectors = makeVectors<T>(batchSize, 5), out = std::vector<T>(batchSize)](std::size_t iterations) mutable
+						{
+							for (std::size_t i = 0; i < iterations; ++i)
+							{
+								for (std::size_t j = 0; j < batchSize; ++j)
+									out[j] = lengthSq(vectors[j]);
+								doNotOptimize(out.data());
+							}
+						}
+		);
+
+		registerBenchmark("VectorSoA lengthSq<" + typeName + "> batch",
+						batchSize,
+						[vectors = VectorSoA<T, 2>{ makeVectors<T>(batchSize, 5) }, out = std::vector<T>(batchSize)](std::size_t iterations) mutable
+						{
+							for (std::size_t i = 0; i < iterations; ++i)
+							{
+								lengthSq(vectors, std::span<T>{ out });
+								doNotOptimize(out.data());
+							}
+						}
+		);
+
+		registerTransformer("transform::Translate<" + typeName + ">", transform::Translate<Vector_t>{ { T(1), T(2) } });
+		registerTransformer("transform::Scale<" + typeName + ">", transform::Scale<Vector_t>{ { T(2), T(3) } });
+		registerTransformer("transform::Shear<" + typeName + ">", transform::Shear<Vector_t>{ { T(1), T(0) } });
+		registerTransformer("transform::Rotate<" + typeName + ">", transform::Rotate<Vector_t>{ radian });
+		registerTransformer("transform::PrecomputedRotate<" + typeName + ">", transform::PrecomputedRotate<Vector_t>{ radian });
+	}
+
+	const Registrar vectorBenchmarks
+	{
+		[]()
+		{
+			registerVectorBenchmarks<float>("float", 0.7f);
+			registerVectorBenchmarks<double>("double", 0.7);
+			registerVectorBenchmarks<int>("int", 0.7);
+		}
+	};
+}
@@ -0,0 +1,45 @@
+//          Copyright Dominic Koepke 2017 - 2020.
+// Distributed under the Boost Software License, Version 1.0.
+//    (See accompanying file LICENSE_1_0.txt or copy at
+//          https://www.boost.org/LICENSE_1_0.txt)
+
+#include "Benchmark.hpp"
+
+#include <cstdio>
+#include <string_view>
+
+// usage: bench_georithm [filter...]
+// runs every registered benchmark, whose name contains at least one of the given filters (or all, if none are given)
+int main(int argc, char** argv)
+{
+	using namespace georithm::bench;
+
+	auto isSelected = [argc, argv](std::string_view name)
+	{
+		if (argc <= 1)
+			return true;
+		for (int i = 1; i < argc; ++i)
+		{
+			if (name.find(argv[i]) != std::string_view::npos)
+				return true;
+		}
+		return false;
+	};
+
+	std::printf("%-64s %12s %14s %12s %12s\n", "benchmark", "ns/op", "ops/s", "p50 ns/op", "p99 ns/op");
+	for (const auto& benchmark : registry())
+	{
+		if (!isSelected(benchmark.name))
+			continue;
+
+		auto result = run(benchmark);
+		std::printf("%-64s %12.3f %14.4g %12.3f %12.3f\n",
+					result.name.c_str(),
+					result.nsPerOp,
+					result.opsPerSecond,
+					result.p50NsPerOp,
+					result.p99NsPerOp
+		);
+	}
+	return 0;
+}
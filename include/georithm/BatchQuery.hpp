@@ -0,0 +1,255 @@
+//          Copyright Dominic Koepke 2017 - 2020.
+// Distributed under the Boost Software License, Version 1.0.
+//    (See accompanying file LICENSE_1_0.txt or copy at
+//          https://www.boost.org/LICENSE_1_0.txt)
+
+#ifndef GEORITHM_BATCH_QUERY_HPP
+#define GEORITHM_BATCH_QUERY_HPP
+
+#pragma once
+
+#include <algorithm>
+#include <cassert>
+#include <concepts>
+#include <cstddef>
+#include <ranges>
+#include <span>
+#include <utility>
+#include <vector>
+
+#include "georithm/Bounding.hpp"
+#include "georithm/Concepts.hpp"
+#include "georithm/Contains.hpp"
+#include "georithm/Executor.hpp"
+#include "georithm/GeometricTraits.hpp"
+#include "georithm/Overlaps.hpp"
+#include "georithm/Rect.hpp"
+#include "georithm/ThreadPool.hpp"
+
+/* Batch queries run a whole range of queries against one of the spatial indexes (Bvh, PackedRTree, PackedRTreeView, UniformGrid,
+ * DynamicAABBTree) in parallel on an Executor. All const member functions of those indexes only read the index and keep their traversal state on
+ * the stack, thus any number of threads may query the same index concurrently, as long as nobody modifies it (insert, remove, move,
+ * rebuild, refit) at the same time.
+ * The same holds for the geometries, which batchContains, batchOverlaps and batchRaycast test: any thread may read any of them. Geometries
+ * with lazy caches (CachedRect or a Rect with an AffineChain) update those on their first read after a change, thus fill the caches before
+ * the batch query (e.g. by reading a vertex of each geometry); otherwise the threads race on them.
+ * The results of each query are in the order, the index visits them; this order only depends on the index and the query, thus the
+ * results are identical for any number of threads.
+ */
+
+namespace georithm
+{
+	/* Results of a batch query in a single array, where the results of each query directly follow the ones of the previous query.
+	 * offsets holds the begin of each query's results and the end of the last one.
+	 */
+	template <class TValue>
+	class BatchQueryResult
+	{
+	public:
+		using ValueType = TValue;
+
+		BatchQueryResult() noexcept :
+			m_Offsets{ 0 }
+		{
+		}
+
+		BatchQueryResult(std::vector<std::size_t> offsets, std::vector<TValue> values) noexcept :
+			m_Offsets{ std::move(offsets) },
+			m_Values{ std::move(values) }
+		{
+			assert(!std::empty(m_Offsets) && m_Offsets.back() == std::size(m_Values));
+		}
+
+		// count of queries
+		[[nodiscard]] std::size_t size() const noexcept
+		{
+			return std::size(m_Offsets) - 1;
+		}
+
+		[[nodiscard]] bool empty() const noexcept
+		{
+			return size() == 0;
+		}
+
+		// results of the query at queryIndex
+		[[nodiscard]] std::span<const TValue> operator [](std::size_t queryIndex) const noexcept
+		{
+			assert(queryIndex < size());
+			return std::span{ std::data(m_Values) + m_Offsets[queryIndex], std::data(m_Values) + m_Offsets[queryIndex + 1] };
+		}
+
+		[[nodiscard]] std::span<const std::size_t> offsets() const noexcept
+		{
+			return m_Offsets;
+		}
+
+		[[nodiscard]] std::span<const TValue> values() const noexcept
+		{
+			return m_Values;
+		}
+
+		[[nodiscard]] bool operator ==(const BatchQueryResult&) const = default;
+
+	private:
+		std::vector<std::size_t> m_Offsets;
+		std::vector<TValue> m_Values;
+	};
+
+	template <class T>
+	struct RaycastHit
+	{
+		std::size_t index = 0;
+		T lineDist{};
+
+		[[nodiscard]] constexpr bool operator ==(const RaycastHit&) const noexcept = default;
+	};
+}
+
+namespace georithm::detail
+{
+	constexpr std::size_t batchQueryGrainSize = 64;
+
+	/* Invokes query(queryIndex, out) for each query, which appends the results of that query to out. Each chunk of queries collects
+	 * its results in its own buffer, thus the threads never share any output. The counts are written directly to the offsets, which
+	 * get accumulated afterwards; the buffers are then copied to their final position in parallel. Chunks have fixed bounds, thus
+	 * the merged results don't depend on which thread processed which chunk.
+	 */
+	template <class TValue, class TQuery>
+	[[nodiscard]] BatchQueryResult<TValue> runBatchQuery(std::size_t queryCount, Executor& executor, TQuery query)
+	{
+		auto chunkCount = (queryCount + batchQueryGrainSize - 1) / batchQueryGrainSize;
+		std::vector<std::vector<TValue>> chunkValues(chunkCount);
+		std::vector<std::size_t> offsets(queryCount + 1);
+		executor.parallelFor(queryCount, batchQueryGrainSize, [&](std::size_t begin, std::size_t end)
+			{
+				auto& out = chunkValues[begin / batchQueryGrainSize];
+				for (auto i = begin; i < end; ++i)
+				{
+					auto previousSize = std::size(out);
+					query(i, out);
+					offsets[i + 1] = std::size(out) - previousSize;
+				}
+			}
+		);
+
+		for (std::size_t i = 1; i <= queryCount; ++i)
+			offsets[i] += offsets[i - 1];
+
+		std::vector<TValue> values(offsets.back());
+		executor.parallelFor(chunkCount, 1, [&](std::size_t chunk, std::size_t)
+			{
+				std::ranges::copy(chunkValues[chunk], std::begin(values) + offsets[chunk * batchQueryGrainSize]);
+			}
+		);
+		return { std::move(offsets), std::move(values) };
+	}
+
+	template <class TIndex, class TObject>
+	concept BoundsQueryable = requires(const TIndex& index, const TObject& object)
+	{
+		index.query(object, [](std::size_t) { return true; });
+	};
+}
+
+namespace georithm
+{
+	/* Collects the indices of all objects, whose bounds intersect (or touch) the bounding rect of each query object, as
+	 * index.query(object, callback) would report them.
+	 */
+	template <class TIndex, std::ranges::random_access_range TObjects>
+	requires BoundedObject<std::ranges::range_value_t<TObjects>> && detail::BoundsQueryable<TIndex, std::ranges::range_value_t<TObjects>>
+	[[nodiscard]] BatchQueryResult<std::size_t> batchQuery(const TIndex& index, const TObjects& objects,
+															Executor& executor = defaultExecutor())
+	{
+		return detail::runBatchQuery<std::size_t>(static_cast<std::size_t>(std::ranges::size(objects)), executor,
+			[&](std::size_t queryIndex, std::vector<std::size_t>& out)
+			{
+				index.query(std::ranges::begin(objects)[queryIndex], [&](std::size_t objectIndex) { out.emplace_back(objectIndex); });
+			}
+		);
+	}
+
+	/* Collects the indices of all geometries, which contain each of the points. geometries must be the range, the index refers to.
+	 * Only geometries, whose bounds contain a point (as reported by index.queryPoint), are tested at all. The geometries are shared
+	 * between the threads, thus their lazy caches must be filled beforehand (see above).
+	 */
+	template <class TIndex, std::ranges::random_access_range TGeometries, std::ranges::random_access_range TPoints>
+	requires NDimensionalVectorObject<std::ranges::range_value_t<TPoints>, 2> &&
+	requires(const TIndex& index, const std::ranges::range_value_t<TGeometries>& geometry, const std::ranges::range_value_t<TPoints>& point)
+	{
+		index.queryPoint(point, [](std::size_t) { return true; });
+		{ contains(geometry, point) } -> std::convertible_to<bool>;
+	}
+	[[nodiscard]] BatchQueryResult<std::size_t> batchContains(const TIndex& index, const TGeometries& geometries, const TPoints& points,
+															Executor& executor = defaultExecutor())
+	{
+		using Point_t = std::ranges::range_value_t<TPoints>;
+
+		return detail::runBatchQuery<std::size_t>(static_cast<std::size_t>(std::ranges::size(points)), executor,
+			[&](std::size_t queryIndex, std::vector<std::size_t>& out)
+			{
+				const Point_t& point = std::ranges::begin(points)[queryIndex];
+				index.queryPoint(point, [&](std::size_t objectIndex)
+					{
+						if (contains(std::ranges::begin(geometries)[objectIndex], point))
+							out.emplace_back(objectIndex);
+					}
+				);
+			}
+		);
+	}
+
+	/* Collects the indices of all geometries, which overlap each of the query objects (e.g. rects). geometries must be the range, the
+	 * index refers to. Only geometries, whose bounds intersect the bounding rect of a query object, are tested at all. The geometries are
+	 * shared between the threads, thus their lazy caches must be filled beforehand (see above).
+	 */
+	template <class TIndex, std::ranges::random_access_range TGeometries, std::ranges::random_access_range TObjects>
+	requires NDimensionalObject<std::ranges::range_value_t<TGeometries>, 2> && NDimensionalObject<std::ranges::range_value_t<TObjects>, 2> &&
+	detail::BoundsQueryable<TIndex, std::ranges::range_value_t<TObjects>>
+	[[nodiscard]] BatchQueryResult<std::size_t> batchOverlaps(const TIndex& index, const TGeometries& geometries, const TObjects& objects,
+															Executor& executor = defaultExecutor())
+	{
+		return detail::runBatchQuery<std::size_t>(static_cast<std::size_t>(std::ranges::size(objects)), executor,
+			[&](std::size_t queryIndex, std::vector<std::size_t>& out)
+			{
+				auto& object = std::ranges::begin(objects)[queryIndex];
+				index.query(object, [&](std::size_t objectIndex)
+					{
+						if (overlaps(std::ranges::begin(geometries)[objectIndex], object))
+							out.emplace_back(objectIndex);
+					}
+				);
+			}
+		);
+	}
+
+	/* Collects the hits of each line with the polygonal geometries, as index.raycast(geometries, line, callback) would report them;
+	 * thus only indexes with a raycast member (Bvh, PackedRTree and its view) are supported. The geometries are shared between the threads,
+	 * thus their lazy caches must be filled beforehand (see above).
+	 */
+	template <class TIndex, std::ranges::random_access_range TGeometries, std::ranges::random_access_range TLines>
+	requires NDimensionalPolygonalObject<std::ranges::range_value_t<TGeometries>, 2> &&
+	NDimensionalLineObject<std::ranges::range_value_t<TLines>, 2> &&
+	requires(const TIndex& index, const TGeometries& geometries, const std::ranges::range_value_t<TLines>& line)
+	{
+		index.raycast(geometries, line, [](std::size_t, typename GeometricTraits<std::ranges::range_value_t<TLines>>::ValueType) {});
+	}
+	[[nodiscard]] auto batchRaycast(const TIndex& index, const TGeometries& geometries, const TLines& lines, Executor& executor = defaultExecutor())
+	{
+		using T = typename GeometricTraits<std::ranges::range_value_t<TLines>>::ValueType;
+		using Hit_t = RaycastHit<T>;
+
+		return detail::runBatchQuery<Hit_t>(static_cast<std::size_t>(std::ranges::size(lines)), executor,
+			[&](std::size_t queryIndex, std::vector<Hit_t>& out)
+			{
+				index.raycast(geometries, std::ranges::begin(lines)[queryIndex], [&](std::size_t objectIndex, T lineDist)
+					{
+						out.push_back({ objectIndex, lineDist });
+					}
+				);
+			}
+		);
+	}
+}
+
+#endif
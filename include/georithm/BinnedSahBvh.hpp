@@ -0,0 +1,214 @@
+//          Copyright Dominic Koepke 2017 - 2020.
+// Distributed under the Boost Software License, Version 1.0.
+//    (See accompanying file LICENSE_1_0.txt or copy at
+//          https://www.boost.org/LICENSE_1_0.txt)
+
+#ifndef GEORITHM_BINNED_SAH_BVH_HPP
+#define GEORITHM_BINNED_SAH_BVH_HPP
+
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cassert>
+#include <cstddef>
+#include <limits>
+#include <numeric>
+#include <optional>
+#include <ranges>
+#include <vector>
+
+#include "georithm/Bounding.hpp"
+#include "georithm/Bvh.hpp"
+#include "georithm/Concepts.hpp"
+#include "georithm/GeometricTraits.hpp"
+#include "georithm/Rect.hpp"
+
+namespace georithm::detail
+{
+	constexpr std::size_t sahBinCount = 16;
+
+	template <class T>
+	struct SahBin
+	{
+		std::optional<AABB_t<T>> bounds;
+		std::size_t count = 0;
+
+		void add(const AABB_t<T>& objectBounds) noexcept
+		{
+			bounds = bounds ? detail::boundingRect(*bounds, objectBounds) : objectBounds;
+			++count;
+		}
+
+		void add(const SahBin& other) noexcept
+		{
+			if (other.bounds)
+				bounds = bounds ? detail::boundingRect(*bounds, *other.bounds) : other.bounds;
+			count += other.count;
+		}
+
+		[[nodiscard]] double cost() const noexcept
+		{
+			return bounds ? halfPerimeter(*bounds) * static_cast<double>(count) : 0.;
+		}
+	};
+}
+
+namespace georithm
+{
+	/* Builds a BVH over the bounding rects of objects, which minimizes the expected traversal cost of random rays. Every range of
+	 * objects is split where the surface area heuristic (perimeter heuristic in 2d) is lowest, which gets evaluated on a fixed number
+	 * of bins along both axes. Ranges become leafs with up to maxLeafSize objects, if testing all of them is cheaper than splitting.
+	 * The build is considerably slower than the one of buildLinearBvh, thus it suits static scenes, which mainly get queried by rays.
+	 */
+	template <std::ranges::random_access_range TObjects>
+	requires BoundedObject<std::ranges::range_value_t<TObjects>>
+	[[nodiscard]] Bvh<typename GeometricTraits<std::ranges::range_value_t<TObjects>>::ValueType> buildBinnedSahBvh(const TObjects& objects,
+																												std::size_t maxLeafSize = 4)
+	{
+		using T = typename GeometricTraits<std::ranges::range_value_t<TObjects>>::ValueType;
+		using Bvh_t = Bvh<T>;
+		using Node_t = typename Bvh_t::NodeType;
+		using Index_t = typename Bvh_t::IndexType;
+		using Bounds_t = typename Bvh_t::AABBType;
+		using Bin_t = detail::SahBin<T>;
+
+		assert(0 < maxLeafSize);
+
+		auto count = static_cast<std::size_t>(std::ranges::size(objects));
+		if (count == 0)
+			return {};
+		assert(count < std::numeric_limits<Index_t>::max() / 2);
+
+		std::vector<Bounds_t> objectBounds(count);
+		std::vector<std::array<double, 2>> centres(count);
+		for (std::size_t i = 0; i < count; ++i)
+		{
+			auto& bounds = objectBounds[i] = boundingRect(std::ranges::begin(objects)[i]);
+			centres[i] = {
+				static_cast<double>(bounds.position().x()) + static_cast<double>(bounds.span().x()) / 2,
+				static_cast<double>(bounds.position().y()) + static_cast<double>(bounds.span().y()) / 2
+			};
+		}
+
+		std::vector<Index_t> objectIndices(count);
+		std::iota(std::begin(objectIndices), std::end(objectIndices), Index_t{ 0 });
+
+		// the hierarchy never exceeds 2 * count - 1 nodes, thus the nodes don't move while being built
+		std::vector<Node_t> nodes;
+		nodes.reserve(2 * count - 1);
+		nodes.emplace_back();
+
+		struct PendingRange
+		{
+			Index_t node;
+			std::size_t begin;
+			std::size_t end;
+		};
+		std::vector<PendingRange> pending{ { 0, 0, count } };
+		while (!std::empty(pending))
+		{
+			auto [nodeIndex, begin, end] = pending.back();
+			pending.pop_back();
+
+			auto rangeCount = end - begin;
+			auto bounds = objectBounds[objectIndices[begin]];
+			constexpr auto max = std::numeric_limits<double>::max();
+			std::array<double, 2> centreMin{ max, max };
+			std::array<double, 2> centreMax{ -max, -max };
+			for (auto i = begin; i < end; ++i)
+			{
+				auto index = objectIndices[i];
+				bounds = detail::boundingRect(bounds, objectBounds[index]);
+				for (std::size_t axis = 0; axis < 2; ++axis)
+				{
+					centreMin[axis] = std::min(centreMin[axis], centres[index][axis]);
+					centreMax[axis] = std::max(centreMax[axis], centres[index][axis]);
+				}
+			}
+			nodes[nodeIndex].bounds = bounds;
+
+			// the split is described by its axis and the first bin of the second child
+			auto leafCost = detail::sahIntersectionCost * static_cast<double>(rangeCount);
+			auto bestCost = max;
+			std::size_t bestAxis = 0;
+			std::size_t bestSplit = 0;
+			auto binOf = [&](std::size_t axis, Index_t index)
+			{
+				auto scale = static_cast<double>(detail::sahBinCount) / (centreMax[axis] - centreMin[axis]);
+				auto bin = static_cast<std::size_t>((centres[index][axis] - centreMin[axis]) * scale);
+				return std::min(bin, detail::sahBinCount - 1);
+			};
+			if (1 < rangeCount)
+			{
+				for (std::size_t axis = 0; axis < 2; ++axis)
+				{
+					if (centreMin[axis] == centreMax[axis])
+						continue;
+
+					std::array<Bin_t, detail::sahBinCount> bins{};
+					for (auto i = begin; i < end; ++i)
+						bins[binOf(axis, objectIndices[i])].add(objectBounds[objectIndices[i]]);
+
+					// costs of all first children, accumulated from the left; then sweep from the right
+					std::array<double, detail::sahBinCount> firstCosts{};
+					Bin_t accumulated;
+					for (std::size_t split = 1; split < detail::sahBinCount; ++split)
+					{
+						accumulated.add(bins[split - 1]);
+						firstCosts[split] = accumulated.cost();
+					}
+					accumulated = {};
+					for (auto split = detail::sahBinCount - 1; 0 < split; --split)
+					{
+						accumulated.add(bins[split]);
+						if (auto cost = firstCosts[split] + accumulated.cost(); cost < bestCost && accumulated.count < rangeCount &&
+							0 < accumulated.count)
+						{
+							bestCost = cost;
+							bestAxis = axis;
+							bestSplit = split;
+						}
+					}
+				}
+				bestCost = detail::sahTraversalCost + detail::sahIntersectionCost * bestCost / std::max(detail::halfPerimeter(bounds),
+																										std::numeric_limits<double>::min());
+			}
+
+			if (rangeCount == 1 || (rangeCount <= maxLeafSize && leafCost <= bestCost))
+			{
+				auto& node = nodes[nodeIndex];
+				node.child1 = static_cast<Index_t>(begin);
+				node.objectCount = static_cast<Index_t>(rangeCount);
+				continue;
+			}
+
+			auto first = std::begin(objectIndices) + begin;
+			auto last = std::begin(objectIndices) + end;
+			// without a split, all centres coincide and any split is as good as the others
+			std::size_t middle = begin + rangeCount / 2;
+			if (bestSplit != 0)
+			{
+				auto partitionEnd = std::partition(first, last, [&](Index_t index) { return binOf(bestAxis, index) < bestSplit; });
+				middle = static_cast<std::size_t>(partitionEnd - std::begin(objectIndices));
+			}
+			assert(begin < middle && middle < end);
+
+			auto child1 = static_cast<Index_t>(std::size(nodes));
+			auto child2 = static_cast<Index_t>(child1 + 1);
+			nodes.resize(std::size(nodes) + 2);
+			nodes[child1].parent = nodeIndex;
+			nodes[child2].parent = nodeIndex;
+			nodes[nodeIndex].child1 = child1;
+			nodes[nodeIndex].child2 = child2;
+			pending.push_back({ child2, middle, end });
+			pending.push_back({ child1, begin, middle });
+		}
+
+		std::vector<Bounds_t> sortedBounds(count);
+		std::ranges::transform(objectIndices, std::begin(sortedBounds), [&](Index_t index) { return objectBounds[index]; });
+		return { std::move(nodes), std::move(objectIndices), std::move(sortedBounds) };
+	}
+}
+
+#endif
@@ -9,11 +9,20 @@
 #pragma once
 
 #include <algorithm>
+#include <cassert>
+#include <concepts>
+#include <cstddef>
+#include <iterator>
+#include <ranges>
+#include <span>
+#include <type_traits>
 
 #include "georithm/Concepts.hpp"
 #include "georithm/Defines.hpp"
+#include "georithm/Execution.hpp"
 #include "georithm/GeometricTraits.hpp"
 #include "georithm/Rect.hpp"
+#include "georithm/Simd.hpp"
 #include "georithm/Utility.hpp"
 #include "georithm/Vector.hpp"
 
@@ -93,132 +102,144 @@ namespace georithm::detail
 		return { topLeft, bottomRight - topLeft };
 	}
 
+	/*#####
+	 * min max kernel
+	 *#####*/
+	template <NDimensionalVectorObject<2> TVector>
+	struct MinMax
+	{
+		TVector min;
+		TVector max;
+	};
+
+	// single pass over all points; all polygon and point range bounding functions are built on top of this
+	template <NDimensionalVectorObject<2> TVector>
+	[[nodiscard]] constexpr MinMax<TVector> minMax(std::span<const TVector> points) noexcept
+	{
+		assert(!std::empty(points));
+
+#ifdef GEORITHM_SIMD_SSE
+		using T = typename TVector::ValueType;
+		if constexpr ((std::is_same_v<T, float> || std::is_same_v<T, double>) && sizeof(TVector) == 2 * sizeof(T))
+		{
+			if (!std::is_constant_evaluated())
+			{
+				MinMax<TVector> result;
+				simd::minMax2(&points[0][0], std::size(points), &result.min[0], &result.max[0]);
+				return result;
+			}
+		}
+#endif
+
+		auto xMin = points[0].x();
+		auto yMin = points[0].y();
+		auto xMax = xMin;
+		auto yMax = yMin;
+		for (std::size_t i = 1, count = std::size(points); i < count; ++i)
+		{
+			auto x = points[i].x();
+			auto y = points[i].y();
+			xMin = x < xMin ? x : xMin;
+			yMin = y < yMin ? y : yMin;
+			xMax = xMax < x ? x : xMax;
+			yMax = yMax < y ? y : yMax;
+		}
+		return { TVector{ xMin, yMin }, TVector{ xMax, yMax } };
+	}
+
+	// evaluates each vertex exactly once
+	template <NDimensionalPolygonalObject<2> TPolygon>
+	[[nodiscard]] constexpr MinMax<typename GeometricTraits<TPolygon>::VectorType> minMax(const TPolygon& polygon) noexcept
+	{
+		using Vector_t = typename GeometricTraits<TPolygon>::VectorType;
+		assert(!isNull(polygon) && 2 < vertexCount(polygon));
+
+		if constexpr (requires { std::span<const Vector_t>{ polygon.vertices() }; })
+			return minMax(std::span<const Vector_t>{ polygon.vertices() });
+		else if constexpr (0 < StaticVertexCount_v<TPolygon>)
+		{
+			auto vertices = collectVertices(polygon);
+			return minMax(std::span<const Vector_t>{ vertices });
+		}
+		else
+		{
+			auto curVertex = vertex(polygon, 0);
+			MinMax<Vector_t> result{ curVertex, curVertex };
+			for (VertexIndex_t i = 1, count = vertexCount(polygon); i < count; ++i)
+			{
+				curVertex = vertex(polygon, i);
+				result.min = { std::min(result.min.x(), curVertex.x()), std::min(result.min.y(), curVertex.y()) };
+				result.max = { std::max(result.max.x(), curVertex.x()), std::max(result.max.y(), curVertex.y()) };
+			}
+			return result;
+		}
+	}
+
+	template <NDimensionalVectorObject<2> TVector>
+	[[nodiscard]] constexpr AABB_t<typename TVector::ValueType> boundingRect(std::span<const TVector> points) noexcept
+	{
+		auto [min, max] = minMax(points);
+		return { min, max - min };
+	}
+
 	/*#####
 	 * generic polygon overloads
 	 *#####*/
 	template <NDimensionalPolygonalObject<2> TPolygon>
 	[[nodiscard]] constexpr typename GeometricTraits<TPolygon>::ValueType leftBounding(const TPolygon& polygon) noexcept
 	{
-		auto count = vertexCount(polygon);
-		assert(!isNull(polygon) && 2 < count);
-		auto min = vertex(polygon, 0).x();
-
-		for (VertexIndex_t i = 1; i < count; ++i)
-			min = std::min(min, vertex(polygon, i).x());
-		return min;
+		return minMax(polygon).min.x();
 	}
 
 	template <NDimensionalPolygonalObject<2> TPolygon>
 	[[nodiscard]] constexpr typename GeometricTraits<TPolygon>::ValueType topBounding(const TPolygon& polygon) noexcept
 	{
-		auto count = vertexCount(polygon);
-		assert(!isNull(polygon) && 2 < count);
-		auto min = vertex(polygon, 0).y();
-
-		for (VertexIndex_t i = 1; i < count; ++i)
-			min = std::min(min, vertex(polygon, i).y());
-		return min;
+		return minMax(polygon).min.y();
 	}
 
 	template <NDimensionalPolygonalObject<2> TPolygon>
 	[[nodiscard]] constexpr typename GeometricTraits<TPolygon>::ValueType rightBounding(const TPolygon& polygon) noexcept
 	{
-		auto count = vertexCount(polygon);
-		assert(!isNull(polygon) && 2 < count);
-		auto max = vertex(polygon, 0).x();
-
-		for (VertexIndex_t i = 1; i < count; ++i)
-			max = std::max(max, vertex(polygon, i).x());
-		return max;
+		return minMax(polygon).max.x();
 	}
 
 	template <NDimensionalPolygonalObject<2> TPolygon>
 	[[nodiscard]] constexpr typename GeometricTraits<TPolygon>::ValueType bottomBounding(const TPolygon& polygon) noexcept
 	{
-		auto count = vertexCount(polygon);
-		assert(!isNull(polygon) && 2 < count);
-		auto max = vertex(polygon, 0).y();
-
-		for (VertexIndex_t i = 1; i < count; ++i)
-			max = std::max(max, vertex(polygon, i).y());
-		return max;
+		return minMax(polygon).max.y();
 	}
 
 	template <NDimensionalPolygonalObject<2> TObj>
 	[[nodiscard]] constexpr typename GeometricTraits<TObj>::VectorType topLeftBounding(const TObj& polygon) noexcept
 	{
-		auto count = vertexCount(polygon);
-		assert(!isNull(polygon) && 2 < count);
-		auto curVertex = vertex(polygon, 0);
-		auto xMin = curVertex.x();
-		auto yMin = curVertex.y();
-
-		for (VertexIndex_t i = 1; i < count; ++i)
-		{
-			curVertex = vertex(polygon, i);
-			xMin = std::min(xMin, curVertex.x());
-			yMin = std::min(yMin, curVertex.y());
-		}
-		return { xMin, yMin };
+		return minMax(polygon).min;
 	}
 
 	template <NDimensionalPolygonalObject<2> TObj>
 	[[nodiscard]] constexpr typename GeometricTraits<TObj>::VectorType topRightBounding(const TObj& polygon) noexcept
 	{
-		auto count = vertexCount(polygon);
-		assert(!isNull(polygon) && 2 < count);
-		auto curVertex = vertex(polygon, 0);
-		auto xMax = curVertex.x();
-		auto yMin = curVertex.y();
-
-		for (VertexIndex_t i = 1; i < count; ++i)
-		{
-			curVertex = vertex(polygon, i);
-			xMax = std::max(xMax, curVertex.x());
-			yMin = std::min(yMin, curVertex.y());
-		}
-		return { xMax, yMin };
+		auto [min, max] = minMax(polygon);
+		return { max.x(), min.y() };
 	}
 
 	template <NDimensionalPolygonalObject<2> TObj>
 	[[nodiscard]] constexpr typename GeometricTraits<TObj>::VectorType bottomLeftBounding(const TObj& polygon) noexcept
 	{
-		auto count = vertexCount(polygon);
-		assert(!isNull(polygon) && 2 < count);
-		auto curVertex = vertex(polygon, 0);
-		auto xMin = curVertex.x();
-		auto yMax = curVertex.y();
+		auto [min, max] = minMax(polygon);
+		return { min.x(), max.y() };
+	}
 
-		for (VertexIndex_t i = 1; i < count; ++i)
-		{
-			curVertex = vertex(polygon, i);
-			xMin = std::min(xMin, curVertex.x());
-			yMax = std::max(yMax, curVertex.y());
-		}
-		return { xMin, yMax };
+	template <NDimensionalPolygonalObject<2> TObj>
+	[[nodiscard]] constexpr typename GeometricTraits<TObj>::VectorType bottomRightBounding(const TObj& polygon) noexcept
+	{
+		return minMax(polygon).max;
 	}
 
 	template <NDimensionalPolygonalObject<2> TPolygon>
 	[[nodiscard]] constexpr AABB_t<typename GeometricTraits<TPolygon>::ValueType> boundingRect(const TPolygon& polygon) noexcept
 	{
-		auto count = vertexCount(polygon);
-		assert(!isNull(polygon) && 2 < count);
-		auto curVertex = vertex(polygon, 0);
-		auto xMin = curVertex.x();
-		auto yMin = curVertex.y();
-		auto xMax = curVertex.x();
-		auto yMax = curVertex.y();
-
-		for (VertexIndex_t i = 1; i < count; ++i)
-		{
-			curVertex = vertex(polygon, i);
-			xMin = std::min(xMin, curVertex.x());
-			yMin = std::min(yMin, curVertex.y());
-			xMax = std::max(xMax, curVertex.x());
-			yMax = std::max(yMax, curVertex.y());
-		}
-		Vector position{ xMin, yMin };
-		return { position, Vector{ xMax, yMax } - position };
+		auto [min, max] = minMax(polygon);
+		return { min, max - min };
 	}
 
 	/*#####
@@ -257,15 +278,91 @@ namespace georithm::detail
 		return { position, bottomRightBounding(object) - position };
 	}
 
+	// conversions from floating point to integral rects round outwards, thus the converted rect still encloses the original one
+	template <class T, class T2>
+	[[nodiscard]] constexpr AABB_t<T> convertBounds(const AABB_t<T2>& rect) noexcept
+	{
+		if constexpr (std::is_same_v<T, T2>)
+			return rect;
+		else if constexpr (std::integral<T> && std::floating_point<T2>)
+		{
+			auto topLeft = static_cast<Vector<T, 2>>(floor(rect.position()));
+			auto bottomRight = static_cast<Vector<T, 2>>(ceil(rect.position() + rect.span()));
+			return { topLeft, bottomRight - topLeft };
+		}
+		else
+			return { static_cast<Vector<T, 2>>(rect.position()), static_cast<Vector<T, 2>>(rect.span()) };
+	}
+
+	// bounds in the value type of a spatial index, which only has to be convertible from the one of object (see BoundedObject)
+	template <class T, NDimensionalObject<2> TObject>
+	[[nodiscard]] constexpr AABB_t<T> boundingRectAs(const TObject& object) noexcept
+	{
+		return convertBounds<T>(boundingRect(object));
+	}
+
 	template <NDimensionalVectorObject<2> TVector>
 	[[nodiscard]] constexpr AABB_t<typename TVector::ValueType> boundingRect(const TVector& vector1, const TVector& vector2) noexcept
 	{
 		return { transmuteElementWise(vector1, vector2, [](const auto& lhs, const auto& rhs) { return std::min(lhs, rhs); }), abs(vector1 - vector2) };
 	}
+
+	// expects normalized rects (non-negative spans), as they are returned by boundingRect; returns the smallest rect enclosing both
+	template <class T>
+	[[nodiscard]] constexpr AABB_t<T> boundingRect(const AABB_t<T>& lhs, const AABB_t<T>& rhs) noexcept
+	{
+		auto& lhsPos = lhs.position();
+		auto& rhsPos = rhs.position();
+		Vector<T, 2> topLeft{ std::min(lhsPos.x(), rhsPos.x()), std::min(lhsPos.y(), rhsPos.y()) };
+		Vector<T, 2> bottomRight{
+			std::max(lhsPos.x() + lhs.span().x(), rhsPos.x() + rhs.span().x()),
+			std::max(lhsPos.y() + lhs.span().y(), rhsPos.y() + rhs.span().y())
+		};
+		return { topLeft, bottomRight - topLeft };
+	}
+
+	// expects a normalized rect
+	template <class T>
+	[[nodiscard]] constexpr T perimeter(const AABB_t<T>& rect) noexcept
+	{
+		return 2 * (rect.span().x() + rect.span().y());
+	}
+
+	// expects normalized rects; inner may touch the border of outer
+	template <class T>
+	[[nodiscard]] constexpr bool containsBounds(const AABB_t<T>& outer, const AABB_t<T>& inner) noexcept
+	{
+		auto& outerPos = outer.position();
+		auto& innerPos = inner.position();
+		return outerPos.x() <= innerPos.x() && outerPos.y() <= innerPos.y() &&
+			innerPos.x() + inner.span().x() <= outerPos.x() + outer.span().x() &&
+			innerPos.y() + inner.span().y() <= outerPos.y() + outer.span().y();
+	}
+
+	// expects normalized rects (non-negative spans), as they are returned by boundingRect; touching rects are treated as intersecting
+	template <class T>
+	[[nodiscard]] constexpr bool intersectsBounds(const AABB_t<T>& lhs, const AABB_t<T>& rhs) noexcept
+	{
+		auto& lhsPos = lhs.position();
+		auto& rhsPos = rhs.position();
+		return lhsPos.x() <= rhsPos.x() + rhs.span().x() && rhsPos.x() <= lhsPos.x() + lhs.span().x() &&
+			lhsPos.y() <= rhsPos.y() + rhs.span().y() && rhsPos.y() <= lhsPos.y() + lhs.span().y();
+	}
 }
 
 namespace georithm
 {
+	// objects, which have finite bounds
+	template <class T, class TValueType = typename GeometricTraits<T>::ValueType>
+	concept BoundedObject = NDimensionalObject<T, 2> && std::convertible_to<typename GeometricTraits<T>::ValueType, TValueType> &&
+	requires(const std::remove_cvref_t<T>& object)
+	{
+		detail::leftBounding(object);
+		detail::rightBounding(object);
+		detail::topBounding(object);
+		detail::bottomBounding(object);
+	};
+
 	template <NDimensionalObject<2> TObj>
 	[[nodiscard]] constexpr typename GeometricTraits<TObj>::ValueType leftBounding(const TObj& obj) noexcept
 	{
@@ -325,6 +422,82 @@ namespace georithm
 	{
 		return detail::boundingRect(vector1, vector2);
 	}
+
+	// bounding rect of a non-empty contiguous range of points
+	template <std::ranges::contiguous_range TPoints>
+	requires NDimensionalVectorObject<std::ranges::range_value_t<TPoints>, 2>
+	[[nodiscard]] constexpr AABB_t<typename std::ranges::range_value_t<TPoints>::ValueType> boundingRect(const TPoints& points) noexcept
+	{
+		return detail::boundingRect(std::span<const std::ranges::range_value_t<TPoints>>{ points });
+	}
+
+	// writes the bounding rect of each object in order to out
+	template <std::ranges::input_range TObjects, class TOutIterator>
+	requires BoundedObject<std::ranges::range_value_t<TObjects>> &&
+	std::output_iterator<TOutIterator, AABB_t<typename GeometricTraits<std::ranges::range_value_t<TObjects>>::ValueType>>
+	constexpr TOutIterator boundingRects(const TObjects& objects, TOutIterator out)
+	{
+		for (const auto& object : objects)
+			*out++ = detail::boundingRect(object);
+		return out;
+	}
+
+	/* Bounding rect of a non-empty contiguous range of points. seq visits the points one by one, while the unsequenced policies run the
+	 * min max kernel (SIMD, if enabled); the parallel policies combine the bounds of their chunks. All policies yield the same rect.
+	 */
+	template <ExecutionPolicy TPolicy, std::ranges::contiguous_range TPoints>
+	requires NDimensionalVectorObject<std::ranges::range_value_t<TPoints>, 2>
+	[[nodiscard]] AABB_t<typename std::ranges::range_value_t<TPoints>::ValueType> boundingRect(const TPolicy& policy, const TPoints& points)
+	{
+		using Vector_t = std::ranges::range_value_t<TPoints>;
+		using MinMax_t = detail::MinMax<Vector_t>;
+
+		std::span<const Vector_t> span{ points };
+		assert(!std::empty(span));
+
+		auto [min, max] = detail::reduceChunks(policy, std::size(span), MinMax_t{ span[0], span[0] },
+			[span](std::size_t begin, std::size_t end)
+			{
+				if constexpr (detail::IsUnsequencedPolicy_v<TPolicy>)
+					return detail::minMax(span.subspan(begin, end - begin));
+				else
+				{
+					MinMax_t result{ span[begin], span[begin] };
+					for (auto i = begin + 1; i < end; ++i)
+					{
+						result.min = { std::min(result.min.x(), span[i].x()), std::min(result.min.y(), span[i].y()) };
+						result.max = { std::max(result.max.x(), span[i].x()), std::max(result.max.y(), span[i].y()) };
+					}
+					return result;
+				}
+			},
+			[](const MinMax_t& lhs, const MinMax_t& rhs)
+			{
+				return MinMax_t{
+					{ std::min(lhs.min.x(), rhs.min.x()), std::min(lhs.min.y(), rhs.min.y()) },
+					{ std::max(lhs.max.x(), rhs.max.x()), std::max(lhs.max.y(), rhs.max.y()) }
+				};
+			}
+		);
+		return { min, max - min };
+	}
+
+	// writes the bounding rect of each object to the same index of out; the parallel policies compute the rects of their chunks concurrently
+	template <ExecutionPolicy TPolicy, std::ranges::random_access_range TObjects, std::random_access_iterator TOutIterator>
+	requires BoundedObject<std::ranges::range_value_t<TObjects>> &&
+	std::output_iterator<TOutIterator, AABB_t<typename GeometricTraits<std::ranges::range_value_t<TObjects>>::ValueType>>
+	TOutIterator boundingRects(const TPolicy& policy, const TObjects& objects, TOutIterator out)
+	{
+		const auto count = static_cast<std::size_t>(std::ranges::size(objects));
+		detail::forEachChunk(policy, count, [&](std::size_t begin, std::size_t end)
+			{
+				auto objectIter = std::ranges::begin(objects);
+				for (auto i = begin; i < end; ++i)
+					out[i] = detail::boundingRect(objectIter[i]);
+			}
+		);
+		return out + count;
+	}
 }
 
 #endif
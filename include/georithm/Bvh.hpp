@@ -0,0 +1,376 @@
+//          Copyright Dominic Koepke 2017 - 2020.
+// Distributed under the Boost Software License, Version 1.0.
+//    (See accompanying file LICENSE_1_0.txt or copy at
+//          https://www.boost.org/LICENSE_1_0.txt)
+
+#ifndef GEORITHM_BVH_HPP
+#define GEORITHM_BVH_HPP
+
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cassert>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <ranges>
+#include <span>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "georithm/Bounding.hpp"
+#include "georithm/Concepts.hpp"
+#include "georithm/Executor.hpp"
+#include "georithm/GeometricTraits.hpp"
+#include "georithm/Intersection.hpp"
+#include "georithm/Intersects.hpp"
+#include "georithm/Rect.hpp"
+#include "georithm/Utility.hpp"
+
+namespace georithm::detail
+{
+	// costs of visiting a node and of testing a single object, relative to each other; a polygon test walks all of its edges
+	constexpr double sahTraversalCost = 1.;
+	constexpr double sahIntersectionCost = 2.;
+
+	// the 2d counterpart of the surface area; the factor of 2 is left out, because only ratios of it are ever used
+	template <class T>
+	[[nodiscard]] constexpr double halfPerimeter(const AABB_t<T>& bounds) noexcept
+	{
+		return static_cast<double>(bounds.span().x()) + static_cast<double>(bounds.span().y());
+	}
+}
+
+namespace georithm
+{
+	template <class T>
+	struct BvhNode
+	{
+		using IndexType = std::uint32_t;
+		constexpr static IndexType nullIndex = std::numeric_limits<IndexType>::max();
+
+		AABB_t<T> bounds;
+		IndexType parent = nullIndex;
+		// the children of inner nodes; leafs store the first position of their objects in child1
+		IndexType child1 = nullIndex;
+		IndexType child2 = nullIndex;
+		// 0 for inner nodes
+		IndexType objectCount = 0;
+
+		[[nodiscard]] constexpr bool isLeaf() const noexcept
+		{
+			return objectCount != 0;
+		}
+	};
+
+	/* Binary bounding volume hierarchy over the bounding rects of objects, which is produced by one of the BVH builders and doesn't
+	 * change its topology afterwards. The root is always node 0. Leafs refer to a consecutive range of the object indices, which hold
+	 * the index of each object in the range, the hierarchy has been built from. The bounds of the objects are kept in the same order,
+	 * thus leafs with multiple objects still test each of them.
+	 */
+	template <class T>
+	class Bvh
+	{
+	public:
+		using ValueType = T;
+		using AABBType = AABB_t<T>;
+		using NodeType = BvhNode<T>;
+		using IndexType = typename NodeType::IndexType;
+
+		Bvh() noexcept = default;
+
+		// expects a valid hierarchy, where each object index is referenced by exactly one leaf
+		Bvh(std::vector<NodeType> nodes, std::vector<IndexType> objectIndices, std::vector<AABBType> objectBounds) noexcept :
+			m_Nodes{ std::move(nodes) },
+			m_ObjectIndices{ std::move(objectIndices) },
+			m_ObjectBounds{ std::move(objectBounds) }
+		{
+			assert(std::empty(m_Nodes) == std::empty(m_ObjectIndices));
+			assert(std::size(m_ObjectIndices) == std::size(m_ObjectBounds));
+			assert(std::empty(m_Nodes) || m_Nodes.front().parent == NodeType::nullIndex);
+
+			m_BuildCost = sahCost();
+		}
+
+		[[nodiscard]] std::size_t size() const noexcept
+		{
+			return std::size(m_ObjectIndices);
+		}
+
+		[[nodiscard]] bool empty() const noexcept
+		{
+			return std::empty(m_ObjectIndices);
+		}
+
+		// bounds of the root node; must not be called on empty hierarchies
+		[[nodiscard]] const AABBType& bounds() const noexcept
+		{
+			assert(!empty());
+			return m_Nodes.front().bounds;
+		}
+
+		[[nodiscard]] std::span<const NodeType> nodes() const noexcept
+		{
+			return m_Nodes;
+		}
+
+		[[nodiscard]] std::span<NodeType> nodes() noexcept
+		{
+			return m_Nodes;
+		}
+
+		[[nodiscard]] std::span<const IndexType> objectIndices() const noexcept
+		{
+			return m_ObjectIndices;
+		}
+
+		// bounds of the objects in the order of objectIndices
+		[[nodiscard]] std::span<const AABBType> objectBounds() const noexcept
+		{
+			return m_ObjectBounds;
+		}
+
+		/* Expected cost of a random line hitting the root, by the surface area heuristic (perimeter heuristic in 2d). Computing it
+		 * visits each node once.
+		 */
+		[[nodiscard]] double sahCost() const noexcept
+		{
+			if (empty())
+				return 0.;
+
+			double cost = 0.;
+			for (auto& node : m_Nodes)
+			{
+				auto nodeCost = node.isLeaf() ? detail::sahIntersectionCost * static_cast<double>(node.objectCount) : detail::sahTraversalCost;
+				cost += detail::halfPerimeter(node.bounds) * nodeCost;
+			}
+			return cost / std::max(detail::halfPerimeter(bounds()), std::numeric_limits<double>::min());
+		}
+
+		/* Ratio of the current sahCost to the one directly after the build. Refitting keeps the topology, thus the ratio grows, as
+		 * objects move away from their former neighbours. Once it exceeds about 1.5, a rebuild usually pays off.
+		 */
+		[[nodiscard]] double sahCostRatio() const noexcept
+		{
+			return m_BuildCost <= 0. ? 1. : sahCost() / m_BuildCost;
+		}
+
+		/* Recomputes the bounds of all objects and propagates them bottom up, while the topology stays as it is. objects must be the
+		 * range, the hierarchy has been built from, in its current state. The objects are read in their own order, because visiting
+		 * them in leaf order would jump around in memory. The first refit orders the inner nodes by their depth once.
+		 */
+		template <std::ranges::random_access_range TObjects>
+		requires BoundedObject<std::ranges::range_value_t<TObjects>, T>
+		void refit(const TObjects& objects)
+		{
+			refitImpl(objects, [](std::size_t count, auto func) { func(0, count); });
+		}
+
+		// parallel refit, which processes the leafs and then each level of inner nodes in chunks on executor
+		template <std::ranges::random_access_range TObjects>
+		requires BoundedObject<std::ranges::range_value_t<TObjects>, T>
+		void refit(const TObjects& objects, Executor& executor)
+		{
+			refitImpl(objects, [&executor](std::size_t count, auto func) { executor.parallelFor(count, refitGrainSize, func); });
+		}
+
+		/* Invokes callback(index) for each object, whose bounds intersect (or touch) the bounding rect of object.
+		 * If callback returns false, the query stops early.
+		 */
+		template <BoundedObject<T> TObject, class TCallback>
+		requires std::invocable<TCallback&, std::size_t>
+		void query(const TObject& object, TCallback callback) const
+		{
+			auto queryBounds = detail::boundingRectAs<T>(object);
+			traverse([&](const AABBType& bounds) { return detail::intersectsBounds(bounds, queryBounds); }, callback);
+		}
+
+		/* Invokes callback(index) for each object, whose bounds contain point.
+		 * If callback returns false, the query stops early.
+		 */
+		template <NDimensionalVectorObject<2> TVector, class TCallback>
+		requires std::is_same_v<typename TVector::ValueType, T> && std::invocable<TCallback&, std::size_t>
+		void queryPoint(const TVector& point, TCallback callback) const
+		{
+			AABBType pointBounds{ { point.x(), point.y() }, { T{}, T{} } };
+			traverse([&](const AABBType& bounds) { return detail::intersectsBounds(bounds, pointBounds); }, callback);
+		}
+
+		/* Invokes callback(index, lineDist) for each polygonal geometry, which gets hit by line; lineDist is the same as the result of
+		 * intersection(line, geometry). The geometries aren't visited in order of their distance. If callback returns false, the query
+		 * stops early.
+		 */
+		template <std::ranges::random_access_range TGeometries, NDimensionalLineObject<2> TLine, class TCallback>
+		requires NDimensionalPolygonalObject<std::ranges::range_value_t<TGeometries>, 2> &&
+		std::invocable<TCallback&, std::size_t, typename GeometricTraits<TLine>::ValueType>
+		void raycast(const TGeometries& geometries, const TLine& line, TCallback callback) const
+		{
+			assert(std::ranges::size(geometries) == size());
+
+			auto filteredCallback = [&](std::size_t index)
+			{
+				auto dist = intersection(line, std::ranges::begin(geometries)[index]);
+				return !dist || detail::invokeTraversalCallback(callback, index, *dist);
+			};
+			traverse([&](const AABBType& bounds) { return detail::intersectsBounds(line, bounds); }, filteredCallback);
+		}
+
+		/* Invokes callback(index, lineDist, edge, edgeDist) for each intersection of line with an edge of one of the polygonal
+		 * geometries, as forEachIntersection(line, geometry, callback) would. Each geometry in the visited leafs is tested exactly once.
+		 */
+		template <std::ranges::random_access_range TGeometries, NDimensionalLineObject<2> TLine, class TCallback>
+		requires NDimensionalPolygonalObject<std::ranges::range_value_t<TGeometries>, 2>
+		void forEachIntersection(const TGeometries& geometries, const TLine& line, TCallback callback) const
+		{
+			assert(std::ranges::size(geometries) == size());
+
+			auto leafCallback = [&](std::size_t index)
+			{
+				detail::forEachIntersectionImpl(line, std::ranges::begin(geometries)[index],
+												[&](auto lineDist, const auto& edge, auto edgeDist) { callback(index, lineDist, edge, edgeDist); });
+			};
+			traverse([&](const AABBType& bounds) { return detail::intersectsBounds(line, bounds); }, leafCallback);
+		}
+
+	private:
+		std::vector<NodeType> m_Nodes;
+		std::vector<IndexType> m_ObjectIndices;
+		std::vector<AABBType> m_ObjectBounds;
+		double m_BuildCost = 0.;
+		// bounds of the objects in their own order, which are only kept to save the allocation on each refit
+		std::vector<AABBType> m_RefitBounds;
+		// inner nodes in breadth first order and the end of each level in it; empty until the first refit
+		std::vector<IndexType> m_RefitOrder;
+		std::vector<std::size_t> m_RefitLevelEnds;
+
+		constexpr static std::size_t refitGrainSize = 1 << 14;
+
+		template <class TPredicate, class TCallback>
+		void traverse(TPredicate predicate, TCallback& callback) const
+		{
+			if (!empty())
+				traverseSubtree(0, predicate, callback);
+		}
+
+		// deeper subtrees than the inline stack are traversed recursively, which only degenerated hierarchies ever need
+		template <class TPredicate, class TCallback>
+		bool traverseSubtree(IndexType root, TPredicate& predicate, TCallback& callback) const
+		{
+			constexpr std::size_t inlineStackSize = 64;
+			std::array<IndexType, inlineStackSize> stack;
+			std::size_t stackSize = 0;
+			stack[stackSize++] = root;
+			while (0 < stackSize)
+			{
+				auto& node = m_Nodes[stack[--stackSize]];
+				if (!predicate(node.bounds))
+					continue;
+
+				if (node.isLeaf())
+				{
+					// the bounds of a single object are the ones of its leaf
+					for (auto i = node.child1; i < node.child1 + node.objectCount; ++i)
+					{
+						if ((node.objectCount == 1 || predicate(m_ObjectBounds[i])) &&
+							!detail::invokeTraversalCallback(callback, static_cast<std::size_t>(m_ObjectIndices[i])))
+							return false;
+					}
+				}
+				else
+				{
+					for (auto child : { node.child2, node.child1 })
+					{
+						if (stackSize < inlineStackSize)
+							stack[stackSize++] = child;
+						else if (!traverseSubtree(child, predicate, callback))
+							return false;
+					}
+				}
+			}
+			return true;
+		}
+
+		template <class TObjects, class TParallelFor>
+		void refitImpl(const TObjects& objects, TParallelFor parallelFor)
+		{
+			assert(std::ranges::size(objects) == size());
+
+			if (empty())
+				return;
+
+			prepareRefit();
+			parallelFor(size(), [&](std::size_t begin, std::size_t end)
+				{
+					for (auto i = begin; i < end; ++i)
+						m_RefitBounds[i] = detail::boundingRectAs<T>(std::ranges::begin(objects)[i]);
+				}
+			);
+			parallelFor(std::size(m_Nodes), [&](std::size_t begin, std::size_t end)
+				{
+					for (auto index = begin; index < end; ++index)
+					{
+						if (auto& node = m_Nodes[index]; node.isLeaf())
+						{
+							auto first = node.child1;
+							auto bounds = m_ObjectBounds[first] = m_RefitBounds[m_ObjectIndices[first]];
+							for (auto i = first + 1; i < first + node.objectCount; ++i)
+								bounds = detail::boundingRect(bounds, m_ObjectBounds[i] = m_RefitBounds[m_ObjectIndices[i]]);
+							node.bounds = bounds;
+						}
+					}
+				}
+			);
+
+			// the nodes of a level only depend on deeper ones
+			for (auto level = std::ssize(m_RefitLevelEnds) - 1; 0 < level; --level)
+			{
+				auto levelBegin = m_RefitLevelEnds[level - 1];
+				parallelFor(m_RefitLevelEnds[level] - levelBegin, [&](std::size_t begin, std::size_t end)
+					{
+						for (auto i = levelBegin + begin; i < levelBegin + end; ++i)
+						{
+							auto& node = m_Nodes[m_RefitOrder[i]];
+							node.bounds = detail::boundingRect(m_Nodes[node.child1].bounds, m_Nodes[node.child2].bounds);
+						}
+					}
+				);
+			}
+		}
+
+		// collects the inner nodes breadth first, thus they are grouped by their depth
+		void prepareRefit()
+		{
+			m_RefitBounds.resize(size());
+			if (!std::empty(m_RefitLevelEnds))
+				return;
+
+			m_RefitLevelEnds.emplace_back(0);
+			if (!m_Nodes.front().isLeaf())
+				m_RefitOrder.emplace_back(0);
+			for (std::size_t levelBegin = 0; levelBegin < std::size(m_RefitOrder); )
+			{
+				auto levelEnd = std::size(m_RefitOrder);
+				for (auto i = levelBegin; i < levelEnd; ++i)
+				{
+					auto& node = m_Nodes[m_RefitOrder[i]];
+					for (auto child : { node.child1, node.child2 })
+					{
+						if (!m_Nodes[child].isLeaf())
+							m_RefitOrder.emplace_back(child);
+					}
+				}
+				m_RefitLevelEnds.emplace_back(levelEnd);
+				levelBegin = levelEnd;
+			}
+
+			// nodes of a level are independent of each other, thus they are visited in memory order
+			for (std::size_t level = 1; level < std::size(m_RefitLevelEnds); ++level)
+				std::sort(std::begin(m_RefitOrder) + m_RefitLevelEnds[level - 1], std::begin(m_RefitOrder) + m_RefitLevelEnds[level]);
+		}
+	};
+}
+
+#endif
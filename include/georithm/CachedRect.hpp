@@ -0,0 +1,184 @@
+//          Copyright Dominic Koepke 2017 - 2020.
+// Distributed under the Boost Software License, Version 1.0.
+//    (See accompanying file LICENSE_1_0.txt or copy at
+//          https://www.boost.org/LICENSE_1_0.txt)
+
+#ifndef GEORITHM_CACHED_RECT_HPP
+#define GEORITHM_CACHED_RECT_HPP
+
+#pragma once
+
+#include <array>
+#include <cassert>
+#include <type_traits>
+
+#include "georithm/Defines.hpp"
+#include "georithm/Line.hpp"
+#include "georithm/Rect.hpp"
+#include "georithm/Utility.hpp"
+
+namespace georithm
+{
+	/* Wraps a transformed Rect and computes its four world vertices only once. Each non-const accessor (position(), span(),
+	 * transformer<>() and rect()) invalidates the cache, thus the vertices are recomputed lazily on the next vertex access.
+	 * Do not hold on to references obtained by the non-const accessors, as changes made through them later on won't be noticed.
+	 * Because the cache is updated from const member functions, concurrent reading access is only safe after the vertices
+	 * have been computed (e.g. by calling vertices() once).
+	 */
+	template <class TRect>
+	requires detail::IsRect_v<TRect> && (0 < TRect::transformerCount)
+	class CachedRect
+	{
+	public:
+		using RectType = TRect;
+		using ValueType = typename TRect::ValueType;
+		using VectorType = typename TRect::VectorType;
+		constexpr static std::size_t transformerCount = TRect::transformerCount;
+
+		constexpr CachedRect() noexcept = default;
+		/*ToDo: c++20
+		constexpr */
+		~CachedRect() noexcept = default;
+
+		constexpr explicit CachedRect(const TRect& rect) noexcept :
+			m_Rect{ rect }
+		{
+		}
+
+		constexpr CachedRect(const CachedRect&) noexcept = default;
+		constexpr CachedRect& operator =(const CachedRect&) noexcept = default;
+		constexpr CachedRect(CachedRect&&) noexcept = default;
+		constexpr CachedRect& operator =(CachedRect&&) noexcept = default;
+
+		[[nodiscard]] constexpr bool operator ==(const CachedRect& other) const noexcept
+		{
+			return m_Rect == other.m_Rect;
+		}
+
+		[[nodiscard]] constexpr VertexIndex_t vertexCount() const noexcept
+		{
+			return 4u;
+		}
+
+		[[nodiscard]] constexpr VertexIndex_t edgeCount() const noexcept
+		{
+			return 4u;
+		}
+
+		[[nodiscard]] constexpr VectorType vertex(VertexIndex_t index) const noexcept
+		{
+			assert(index < vertexCount() && !isNull());
+
+			return vertices()[index];
+		}
+
+		[[nodiscard]] constexpr Segment<VectorType> edge(EdgeIndex_t index) const noexcept
+		{
+			assert(index < edgeCount() && !isNull());
+
+			auto& cache = vertices();
+			auto& first = cache[index];
+			return { first, cache[(index + 1) % vertexCount()] - first };
+		}
+
+		[[nodiscard]] constexpr const std::array<VectorType, 4>& vertices() const noexcept
+		{
+			assert(!isNull());
+
+			if (m_Dirty)
+			{
+				for (VertexIndex_t i = 0; i < vertexCount(); ++i)
+					m_Vertices[i] = m_Rect.vertex(i);
+				m_Dirty = false;
+			}
+			return m_Vertices;
+		}
+
+		[[nodiscard]] constexpr const TRect& rect() const noexcept
+		{
+			return m_Rect;
+		}
+
+		[[nodiscard]] constexpr TRect& rect() noexcept
+		{
+			invalidate();
+			return m_Rect;
+		}
+
+		[[nodiscard]] constexpr const VectorType& position() const noexcept
+		{
+			return m_Rect.position();
+		}
+
+		[[nodiscard]] constexpr VectorType& position() noexcept
+		{
+			invalidate();
+			return m_Rect.position();
+		}
+
+		[[nodiscard]] constexpr const VectorType& span() const noexcept
+		{
+			return m_Rect.span();
+		}
+
+		[[nodiscard]] constexpr VectorType& span() noexcept
+		{
+			invalidate();
+			return m_Rect.span();
+		}
+
+		template <class TTransformer>
+		requires std::is_base_of_v<TTransformer, TRect>
+		[[nodiscard]] constexpr const TTransformer& transformer() const noexcept
+		{
+			return static_cast<const TTransformer&>(m_Rect);
+		}
+
+		template <class TTransformer>
+		requires std::is_base_of_v<TTransformer, TRect>
+		[[nodiscard]] constexpr TTransformer& transformer() noexcept
+		{
+			invalidate();
+			return static_cast<TTransformer&>(m_Rect);
+		}
+
+		constexpr void invalidate() noexcept
+		{
+			m_Dirty = true;
+		}
+
+		[[nodiscard]] constexpr bool isNull() const noexcept
+		{
+			return m_Rect.isNull();
+		}
+
+	private:
+		TRect m_Rect{};
+		mutable std::array<VectorType, 4> m_Vertices{};
+		mutable bool m_Dirty = true;
+	};
+
+	template <class TRect>
+	struct StaticVertexCount<CachedRect<TRect>> :
+		std::integral_constant<VertexIndex_t, 4>
+	{
+	};
+
+	template <class TRect>
+	struct IsConvex<CachedRect<TRect>> :
+		IsConvex<TRect>
+	{
+	};
+}
+
+namespace georithm::detail
+{
+	// the cached vertices are in the same order as those of the wrapped Rect, thus all Rect algorithms are applicable
+	template <class TRect>
+	struct IsRect<CachedRect<TRect>> :
+		std::true_type
+	{
+	};
+}
+
+#endif
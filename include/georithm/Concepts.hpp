@@ -81,6 +81,29 @@ namespace georithm
 	template <class T, DimensionDescriptor_t TDim>
 	concept NDimensionalPolygonalObject = NDimensionalObject<T, TDim> && PolygonalObject<T>;
 
+	// specialize this for polygon types, whose instances are convex in any case
+	template <class T>
+	struct IsConvex :
+		std::false_type
+	{
+	};
+
+	template <class T>
+	constexpr bool IsConvex_v = IsConvex<std::remove_cvref_t<T>>::value;
+
+	template <class T, DimensionDescriptor_t TDim>
+	concept NDimensionalConvexPolygonalObject = NDimensionalPolygonalObject<T, TDim> && IsConvex_v<T>;
+
+	// specialize this for transform components, which are affine maps; those keep convex polygons convex
+	template <class T>
+	struct IsAffineTransformer :
+		std::false_type
+	{
+	};
+
+	template <class T>
+	constexpr bool IsAffineTransformer_v = IsAffineTransformer<std::remove_cvref_t<T>>::value;
+
 	//template <class T>
 	//concept Circular = GeometricObject && requires (T object)
 	//{
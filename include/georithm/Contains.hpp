@@ -8,32 +8,24 @@
 
 #pragma once
 
+#include <algorithm>
 #include <cassert>
+#include <cstddef>
+#include <iterator>
+#include <ranges>
+#include <type_traits>
+#include <vector>
 
 #include "georithm/Bounding.hpp"
 #include "georithm/Concepts.hpp"
+#include "georithm/Execution.hpp"
 #include "georithm/GeometricTraits.hpp"
+#include "georithm/Line.hpp"
 #include "georithm/Rect.hpp"
 #include "georithm/Utility.hpp"
 
 namespace georithm::detail
 {
-	// not sure if this would be right to expose to the general georithm namespace; possibly to concrete
-	template <class T>
-	struct IsRect :
-		std::false_type
-	{
-	};
-
-	template <class T, class... TTransformer>
-	struct IsRect<Rect<T, TTransformer...>> :
-		std::true_type
-	{
-	};
-
-	template <class T>
-	constexpr bool IsRect_v = IsRect<T>::value;
-
 	template <class T>
 	concept RectType = NDimensionalPolygonalObject<T, 2> && IsRect_v<T>;
 
@@ -53,7 +45,7 @@ namespace georithm::detail
 		auto outerTopLeft = topLeftBounding(outerRect);
 		auto innerTopLeft = topLeftBounding(innerRect);
 		auto outerBottomRight = bottomRightBounding(outerRect);
-		auto innerBottomRight = topLeftBounding(outerRect);
+		auto innerBottomRight = bottomRightBounding(innerRect);
 		return outerTopLeft.x() <= innerTopLeft.x() && outerTopLeft.y() <= innerTopLeft.y() &&
 			innerBottomRight.x() <= outerBottomRight.x() && innerBottomRight.y() <= outerBottomRight.y();
 	}
@@ -93,46 +85,108 @@ namespace georithm::detail
 		return true;
 	}
 
-	//template <NDimensionalPolygonalObject<2> TPolygon, NDimensionalVectorObject<2> TVector>
-	//requires (!IsRect_v<TPolygon>)
-	//constexpr bool contains(const TPolygon& polygon, const TVector& vector) noexcept
-	//{
-	//	assert(!isNull(polygon));
-
-	//	using Traits_t = GeometricTraits<TPolygon>;
-	//	using Vector_t = typename Traits_t::VectorType;
-	//	using Value_t = typename Traits_t::ValueType;
-	//	Ray<Vector_t> ray{ vector, { Value_t(1), Value_t(0) } };
-
-	//	auto count = 0;
-	//	//for (VertexIndex_t i = 0; i < vertexCount(polygon); ++i)
-	//	//{
-	//	//	auto segment = edge(polygon, i);
-	//	//	auto [result, dist] = intersection(ray, segment);
-	//	//	using enum LineIntersectionResult;
-	//	//	switch (result)
-	//	//	{
-	//	//	case intersecting:
-	//	//		++count;
-	//	//		break;
-	//	//	case collinear:
-	//	//	{
-	//	//		auto sqLength = lengthSq(vector - segment.firstVertex());
-	//	//		if (0 <= sqLength && sqLength < lengthSq(segment.direction()))
-	//	//			++count;
-	//	//	}
-	//	//	}
-	//	//}
-	//	forEachIntersection(ray, polygon,
-	//						[&count](auto rayDist, const auto& edge, auto edgeDist)
-	//						{
-	//							if (0 < rayDist)
-	//								++count;
-	//						}
-	//	);
-
-	//	return (count & 1) != 0;
-	//}
+	/*#####
+	 * generic polygon overloads
+	 *#####*/
+	// adds the contribution of the edge to the winding number; returns true, if the point lies on the edge
+	template <NDimensionalVectorObject<2> TVector>
+	[[nodiscard]] constexpr bool accumulateWinding(const TVector& first, const TVector& direction, const TVector& point, int& winding) noexcept
+	{
+		using T = typename TVector::ValueType;
+		auto local = point - first;
+		auto side = direction.x() * local.y() - direction.y() * local.x();
+		if (first.y() <= point.y())
+		{
+			if (point.y() < first.y() + direction.y() && T(0) < side)
+				++winding;
+		}
+		else if (first.y() + direction.y() <= point.y() && side < T(0))
+			--winding;
+
+		return side == T(0) &&
+			std::min(T(0), direction.x()) <= local.x() && local.x() <= std::max(T(0), direction.x()) &&
+			std::min(T(0), direction.y()) <= local.y() && local.y() <= std::max(T(0), direction.y());
+	}
+
+	/* Winding number test with the non-zero rule, thus it works for concave and self intersecting polygons, too. As for the other
+	 * contains overloads, points on the boundary are treated as contained.
+	 */
+	template <NDimensionalPolygonalObject<2> TPolygon, NDimensionalVectorObject<2> TVector>
+	requires (!IsRect_v<TPolygon>) && std::is_same_v<typename GeometricTraits<TPolygon>::ValueType, typename TVector::ValueType>
+	[[nodiscard]] constexpr bool contains(const TPolygon& polygon, const TVector& point) noexcept
+	{
+		assert(!isNull(polygon));
+
+		auto count = vertexCount(polygon);
+		auto first = vertex(polygon, count - 1);
+		int winding = 0;
+		for (VertexIndex_t i = 0; i < count; ++i)
+		{
+			auto second = vertex(polygon, i);
+			if (accumulateWinding(first, second - first, point, winding))
+				return true;
+			first = second;
+		}
+		return winding != 0;
+	}
+
+	template <NDimensionalPolygonalObject<2> TPolygon, std::ranges::input_range TPoints, std::output_iterator<bool> TOutIterator>
+	requires NDimensionalVectorObject<std::ranges::range_value_t<TPoints>, 2> &&
+	std::is_same_v<typename GeometricTraits<TPolygon>::ValueType, typename std::ranges::range_value_t<TPoints>::ValueType>
+	constexpr TOutIterator containsEach(const TPolygon& polygon, const TPoints& points, TOutIterator out)
+	{
+		assert(!isNull(polygon));
+
+		using Vector_t = typename GeometricTraits<TPolygon>::VectorType;
+		if constexpr (IsRect_v<TPolygon>)
+		{
+			if constexpr (TPolygon::transformerCount == 0)
+			{
+				for (const auto& point : points)
+					*out++ = contains(polygon, point);
+			}
+			else
+			{
+				auto vertex0 = vertex(polygon, 0);
+				auto AB = vertex(polygon, 1) - vertex0;
+				auto AD = vertex(polygon, 3) - vertex0;
+				auto lengthSqAB = scalarProduct(AB, AB);
+				auto lengthSqAD = scalarProduct(AD, AD);
+				for (const auto& point : points)
+				{
+					auto AM = point - vertex0;
+					auto projectionAB = scalarProduct(AM, AB);
+					auto projectionAD = scalarProduct(AM, AD);
+					*out++ = 0 <= projectionAB && projectionAB <= lengthSqAB && 0 <= projectionAD && projectionAD <= lengthSqAD;
+				}
+			}
+		}
+		else
+		{
+			auto vertices = collectVertices(polygon);
+			auto count = std::size(vertices);
+			std::vector<Segment<Vector_t>> edges;
+			edges.reserve(count);
+			for (std::size_t i = 0; i < count; ++i)
+				edges.emplace_back(vertices[i], vertices[(i + 1) % count] - vertices[i]);
+
+			for (const auto& point : points)
+			{
+				int winding = 0;
+				bool onBoundary = false;
+				for (const auto& curEdge : edges)
+				{
+					if (accumulateWinding(curEdge.location(), curEdge.direction(), point, winding))
+					{
+						onBoundary = true;
+						break;
+					}
+				}
+				*out++ = onBoundary || winding != 0;
+			}
+		}
+		return out;
+	}
 
 	//template <NDimensionalPolygonalObject<2> Poly, NDimensionalLineObject<2> Line>
 	//constexpr bool intersectsImpl(const Poly& polygon, const Line& line) noexcept
@@ -166,6 +220,48 @@ namespace georithm
 	{
 		return detail::contains(lhs, rhs);
 	}
+
+	/* Classifies each point of the range and writes the results in order to out. The edges of the polygon are computed only once
+	 * for the whole range, which is much cheaper than calling contains for each point, if vertex() is expensive.
+	 */
+	template <NDimensionalPolygonalObject<2> TPolygon, std::ranges::input_range TPoints, std::output_iterator<bool> TOutIterator>
+	requires NDimensionalVectorObject<std::ranges::range_value_t<TPoints>, 2> &&
+	std::is_same_v<typename GeometricTraits<TPolygon>::ValueType, typename std::ranges::range_value_t<TPoints>::ValueType>
+	constexpr TOutIterator contains(const TPolygon& polygon, const TPoints& points, TOutIterator out)
+	{
+		return detail::containsEach(polygon, points, out);
+	}
+
+	/* Classifies each point of the range and writes the result to the same index of out. seq calls contains for each point, while the
+	 * unsequenced policies compute the edges of the polygon once per chunk, as the overload above does. A vertex of the polygon is read
+	 * up front, which fills its lazy caches (see AffineChain and CachedRect), before the threads share it.
+	 */
+	template <ExecutionPolicy TPolicy, NDimensionalPolygonalObject<2> TPolygon, std::ranges::random_access_range TPoints,
+			std::random_access_iterator TOutIterator>
+	requires NDimensionalVectorObject<std::ranges::range_value_t<TPoints>, 2> &&
+	std::is_same_v<typename GeometricTraits<TPolygon>::ValueType, typename std::ranges::range_value_t<TPoints>::ValueType> &&
+	std::output_iterator<TOutIterator, bool> && detail::IsConcurrentlyWritable_v<TPolicy, TOutIterator>
+	TOutIterator contains(const TPolicy& policy, const TPolygon& polygon, const TPoints& points, TOutIterator out)
+	{
+		const auto count = static_cast<std::size_t>(std::ranges::size(points));
+		if (count == 0)
+			return out;
+
+		static_cast<void>(vertex(polygon, 0));
+		detail::forEachChunk(policy, count, [&](std::size_t begin, std::size_t end)
+			{
+				auto pointIter = std::ranges::begin(points);
+				if constexpr (detail::IsUnsequencedPolicy_v<TPolicy>)
+					detail::containsEach(polygon, std::ranges::subrange{ pointIter + begin, pointIter + end }, out + begin);
+				else
+				{
+					for (auto i = begin; i < end; ++i)
+						out[i] = detail::contains(polygon, pointIter[i]);
+				}
+			}
+		);
+		return out + count;
+	}
 }
 
 #endif
@@ -0,0 +1,463 @@
+//          Copyright Dominic Koepke 2017 - 2020.
+// Distributed under the Boost Software License, Version 1.0.
+//    (See accompanying file LICENSE_1_0.txt or copy at
+//          https://www.boost.org/LICENSE_1_0.txt)
+
+#ifndef GEORITHM_CONVEX_HULL_HPP
+#define GEORITHM_CONVEX_HULL_HPP
+
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cassert>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <map>
+#include <ranges>
+#include <span>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "georithm/Concepts.hpp"
+#include "georithm/Execution.hpp"
+#include "georithm/Polygon.hpp"
+#include "georithm/Vector.hpp"
+
+/* All hull algorithms produce the same polygon for the same set of points: the vertices of the convex hull in counter-clockwise
+ * order, starting at the lexicographically smallest point (smallest x, then smallest y). Points on the boundary between two
+ * vertices (thus collinear ones) and duplicates are omitted. Less than 3 distinct points or collinear points result in a hull with
+ * less than 3 vertices, which is a null polygon; check isNull() before passing it to contains or intersects.
+ * Orientations of integral points are computed in 64 bit, thus they are exact for coordinates of up to 30 bits.
+ */
+
+namespace georithm::detail
+{
+	template <class T>
+	using HullCross_t = std::conditional_t<std::integral<T>, std::int64_t, T>;
+
+	// positive, if point lies left of the line from origin through target; 0 if all three are collinear
+	template <NDimensionalVectorObject<2> TVector>
+	[[nodiscard]] constexpr HullCross_t<typename TVector::ValueType> orientation(const TVector& origin, const TVector& target, const TVector& point) noexcept
+	{
+		using Cross_t = HullCross_t<typename TVector::ValueType>;
+		return (static_cast<Cross_t>(target.x()) - origin.x()) * (static_cast<Cross_t>(point.y()) - origin.y()) -
+			(static_cast<Cross_t>(target.y()) - origin.y()) * (static_cast<Cross_t>(point.x()) - origin.x());
+	}
+
+	/* Quickhull splits at the point with the smallest key, which is the farthest point right of the line. Ties lie on a parallel to the
+	 * line; the one next to from is taken, because the others may lie between two hull vertices.
+	 */
+	template <NDimensionalVectorObject<2> TVector>
+	[[nodiscard]] constexpr std::pair<HullCross_t<typename TVector::ValueType>, HullCross_t<typename TVector::ValueType>>
+	farthestKey(const TVector& from, const TVector& to, const TVector& point) noexcept
+	{
+		using Cross_t = HullCross_t<typename TVector::ValueType>;
+		auto progress = (static_cast<Cross_t>(to.x()) - from.x()) * (static_cast<Cross_t>(point.x()) - from.x()) +
+			(static_cast<Cross_t>(to.y()) - from.y()) * (static_cast<Cross_t>(point.y()) - from.y());
+		return { orientation(from, to, point), progress };
+	}
+
+	template <NDimensionalVectorObject<2> TVector>
+	[[nodiscard]] constexpr bool lexicographicLess(const TVector& lhs, const TVector& rhs) noexcept
+	{
+		return lhs.x() < rhs.x() || (lhs.x() == rhs.x() && lhs.y() < rhs.y());
+	}
+
+	/*#####
+	 * monotone chain
+	 *#####*/
+	// Andrew's algorithm on lexicographically sorted points; the lower hull gets built from left to right, the upper one back again
+	template <NDimensionalVectorObject<2> TVector>
+	[[nodiscard]] std::vector<TVector> monotoneChain(std::span<const TVector> points)
+	{
+		assert(std::ranges::is_sorted(points, lexicographicLess<TVector>));
+
+		std::vector<TVector> hull;
+		for (auto& point : points)
+		{
+			if (!std::empty(hull) && hull.back() == point)
+				continue;
+			while (2 <= std::size(hull) && orientation(hull[std::size(hull) - 2], hull.back(), point) <= 0)
+				hull.pop_back();
+			hull.emplace_back(point);
+		}
+		if (std::size(hull) <= 1)
+			return hull;
+
+		const auto lowerSize = std::size(hull);
+		for (auto iter = std::next(std::rbegin(points)); iter != std::rend(points); ++iter)
+		{
+			if (hull.back() == *iter)
+				continue;
+			while (lowerSize < std::size(hull) && orientation(hull[std::size(hull) - 2], hull.back(), *iter) <= 0)
+				hull.pop_back();
+			hull.emplace_back(*iter);
+		}
+		// the upper hull ends at the first point
+		hull.pop_back();
+		return hull;
+	}
+
+	// hull of the union of two hulls
+	template <NDimensionalVectorObject<2> TVector>
+	[[nodiscard]] std::vector<TVector> mergeHulls(std::vector<TVector> lhs, const std::vector<TVector>& rhs)
+	{
+		lhs.insert(std::end(lhs), std::begin(rhs), std::end(rhs));
+		std::ranges::sort(lhs, lexicographicLess<TVector>);
+		return monotoneChain(std::span<const TVector>{ lhs });
+	}
+
+	/*#####
+	 * quickhull
+	 *#####*/
+	/* Appends the hull vertices between from and to (both exclusive) in counter-clockwise order to out; points must hold all points
+	 * strictly right of the line from from to to, which get reordered. Each step takes the farthest point, which is a hull vertex,
+	 * and drops all points of the triangle it spans with the line. The steps are kept on an explicit stack, because the recursion
+	 * gets as deep as the hull has vertices for unfavourable inputs.
+	 */
+	template <NDimensionalVectorObject<2> TVector>
+	void quickHullSide(std::span<TVector> points, const TVector& from, const TVector& to, std::vector<TVector>& out)
+	{
+		struct Step
+		{
+			TVector from;
+			TVector to;
+			std::size_t begin;
+			std::size_t end;
+			// only appends from to out
+			bool emit;
+		};
+
+		std::vector<Step> steps{ { from, to, 0, std::size(points), false } };
+		while (!std::empty(steps))
+		{
+			auto step = steps.back();
+			steps.pop_back();
+			if (step.emit)
+			{
+				out.emplace_back(step.from);
+				continue;
+			}
+			if (step.begin == step.end)
+				continue;
+
+			auto range = points.subspan(step.begin, step.end - step.begin);
+			auto farthest = std::ranges::min_element(range, std::less{},
+				[&](const TVector& point) { return farthestKey(step.from, step.to, point); });
+			const auto apex = *farthest;
+
+			auto fromSide = std::ranges::partition(range, [&](const TVector& point) { return orientation(step.from, apex, point) < 0; });
+			auto toSide = std::ranges::partition(fromSide, [&](const TVector& point) { return orientation(apex, step.to, point) < 0; });
+			const auto fromEnd = step.begin + static_cast<std::size_t>(std::ranges::distance(std::begin(range), std::begin(fromSide)));
+			const auto toEnd = fromEnd + static_cast<std::size_t>(std::ranges::distance(std::begin(fromSide), std::begin(toSide)));
+
+			steps.push_back({ apex, step.to, fromEnd, toEnd, false });
+			steps.push_back({ apex, apex, 0, 0, true });
+			steps.push_back({ step.from, apex, step.begin, fromEnd, false });
+		}
+	}
+
+	/* Quickhull, whose first two levels are done while streaming over the input; only points outside of the quadrilateral spanned by
+	 * the lexicographic extremes and the farthest points on both sides of their line are copied, which are usually few.
+	 */
+	template <std::ranges::forward_range TPoints>
+	[[nodiscard]] std::vector<std::ranges::range_value_t<TPoints>> quickHull(const TPoints& points)
+	{
+		using Vector_t = std::ranges::range_value_t<TPoints>;
+
+		std::vector<Vector_t> hull;
+		auto first = std::ranges::begin(points);
+		if (first == std::ranges::end(points))
+			return hull;
+
+		Vector_t min = *first;
+		Vector_t max = *first;
+		for (const Vector_t& point : points)
+		{
+			min = lexicographicLess(point, min) ? point : min;
+			max = lexicographicLess(max, point) ? point : max;
+		}
+		hull.emplace_back(min);
+		if (min == max)
+			return hull;
+
+		// the farthest points right of min -> max (lower) and right of max -> min (upper)
+		Vector_t lower = min;
+		Vector_t upper = max;
+		auto lowerKey = farthestKey(min, max, lower);
+		auto upperKey = farthestKey(max, min, upper);
+		for (const Vector_t& point : points)
+		{
+			auto side = orientation(min, max, point);
+			if (side < 0)
+			{
+				if (auto key = farthestKey(min, max, point); key < lowerKey)
+				{
+					lowerKey = key;
+					lower = point;
+				}
+			}
+			else if (0 < side)
+			{
+				if (auto key = farthestKey(max, min, point); key < upperKey)
+				{
+					upperKey = key;
+					upper = point;
+				}
+			}
+		}
+
+		const bool hasLower = lowerKey.first < 0;
+		const bool hasUpper = upperKey.first < 0;
+		std::array<std::vector<Vector_t>, 4> outside;
+		for (const Vector_t& point : points)
+		{
+			auto side = orientation(min, max, point);
+			if (side < 0)
+			{
+				if (orientation(min, lower, point) < 0)
+					outside[0].emplace_back(point);
+				else if (orientation(lower, max, point) < 0)
+					outside[1].emplace_back(point);
+			}
+			else if (0 < side)
+			{
+				if (orientation(max, upper, point) < 0)
+					outside[2].emplace_back(point);
+				else if (orientation(upper, min, point) < 0)
+					outside[3].emplace_back(point);
+			}
+		}
+
+		if (hasLower)
+		{
+			quickHullSide(std::span{ outside[0] }, min, lower, hull);
+			hull.emplace_back(lower);
+			quickHullSide(std::span{ outside[1] }, lower, max, hull);
+		}
+		hull.emplace_back(max);
+		if (hasUpper)
+		{
+			quickHullSide(std::span{ outside[2] }, max, upper, hull);
+			hull.emplace_back(upper);
+			quickHullSide(std::span{ outside[3] }, upper, min, hull);
+		}
+		return hull;
+	}
+
+	// points per chunk of the parallel hull; each chunk gets its own quickhull, whose (small) hulls are merged afterwards
+	constexpr std::size_t parallelHullGrainSize = 1 << 16;
+}
+
+namespace georithm
+{
+	// Andrew's monotone chain in O(n); points must be sorted lexicographically (by x, then by y), duplicates are allowed
+	template <std::ranges::contiguous_range TPoints>
+	requires NDimensionalVectorObject<std::ranges::range_value_t<TPoints>, 2>
+	[[nodiscard]] ConvexPolygon<std::ranges::range_value_t<TPoints>> convexHullSorted(const TPoints& points)
+	{
+		using Vector_t = std::ranges::range_value_t<TPoints>;
+		return ConvexPolygon<Vector_t>{ detail::monotoneChain(std::span<const Vector_t>{ points }) };
+	}
+
+	// quickhull in O(n log h) on average, where h is the count of hull vertices; the points are read three times, but never modified
+	template <std::ranges::forward_range TPoints>
+	requires NDimensionalVectorObject<std::ranges::range_value_t<TPoints>, 2>
+	[[nodiscard]] ConvexPolygon<std::ranges::range_value_t<TPoints>> convexHull(const TPoints& points)
+	{
+		return ConvexPolygon<std::ranges::range_value_t<TPoints>>{ detail::quickHull(points) };
+	}
+
+	/* The parallel policies split the points into chunks of 64Ki points, compute the hull of each chunk by quickhull on the executor
+	 * and merge the hulls of neighbouring chunks in order; smaller inputs run on the calling thread. Quickhull has no batch kernel,
+	 * thus the unsequenced policies behave as their sequenced counterparts.
+	 */
+	template <ExecutionPolicy TPolicy, std::ranges::random_access_range TPoints>
+	requires NDimensionalVectorObject<std::ranges::range_value_t<TPoints>, 2>
+	[[nodiscard]] ConvexPolygon<std::ranges::range_value_t<TPoints>> convexHull(const TPolicy& policy, const TPoints& points)
+	{
+		using Vector_t = std::ranges::range_value_t<TPoints>;
+
+		if constexpr (detail::IsParallelPolicy_v<TPolicy>)
+		{
+			auto hull = detail::executorOf(policy).parallelReduce(static_cast<std::size_t>(std::ranges::size(points)),
+				detail::parallelHullGrainSize,
+				std::vector<Vector_t>{},
+				[&](std::size_t begin, std::size_t end)
+				{
+					auto pointIter = std::ranges::begin(points);
+					return detail::quickHull(std::ranges::subrange{ pointIter + begin, pointIter + end });
+				},
+				[](std::vector<Vector_t> lhs, const std::vector<Vector_t>& rhs) { return detail::mergeHulls(std::move(lhs), rhs); }
+			);
+			return ConvexPolygon<Vector_t>{ std::move(hull) };
+		}
+		else
+			return convexHull(points);
+	}
+
+	/* Online convex hull of a stream of points, which are inserted one by one in O(log h) amortized. The upper and lower chain of the
+	 * hull are kept as maps from x to y; points inside the hull (or on its boundary) aren't stored at all, thus the memory only
+	 * depends on the count of hull vertices.
+	 */
+	template <NDimensionalVectorObject<2> TVectorType>
+	class IncrementalConvexHull
+	{
+	public:
+		using VectorType = TVectorType;
+		using ValueType = typename TVectorType::ValueType;
+
+		// returns whether the hull changed, thus false if the point lies inside or on the boundary of the hull
+		bool insert(const VectorType& point)
+		{
+			// both chains must be updated, thus no short circuit evaluation
+			return m_Upper.insert(point) | m_Lower.insert(point);
+		}
+
+		template <std::ranges::input_range TPoints>
+		requires std::convertible_to<std::ranges::range_value_t<TPoints>, VectorType>
+		void insert(const TPoints& points)
+		{
+			for (const VectorType& point : points)
+				insert(point);
+		}
+
+		// points on the boundary count as contained
+		[[nodiscard]] bool contains(const VectorType& point) const
+		{
+			return m_Upper.encloses(point) && m_Lower.encloses(point);
+		}
+
+		[[nodiscard]] bool empty() const noexcept
+		{
+			return m_Upper.empty();
+		}
+
+		void clear() noexcept
+		{
+			m_Upper.clear();
+			m_Lower.clear();
+		}
+
+		// the vertices of the current hull, in the same order as the other hull algorithms produce them
+		[[nodiscard]] ConvexPolygon<VectorType> hull() const
+		{
+			std::vector<VectorType> vertices;
+			m_Lower.appendAscending(vertices);
+			const auto lowerSize = std::size(vertices);
+			m_Upper.appendDescending(vertices);
+			// both chains share the leftmost and the rightmost point, if there is only one at the respective x
+			if (lowerSize < std::size(vertices) && vertices[lowerSize] == vertices[lowerSize - 1])
+				vertices.erase(std::begin(vertices) + static_cast<std::ptrdiff_t>(lowerSize));
+			if (1 < std::size(vertices) && vertices.back() == vertices.front())
+				vertices.pop_back();
+			return ConvexPolygon<VectorType>{ std::move(vertices) };
+		}
+
+	private:
+		// the vertices of the upper chain make right turns from left to right, those of the lower chain left turns
+		template <bool TUpper>
+		class Chain
+		{
+		public:
+			bool insert(const VectorType& point)
+			{
+				auto next = m_Points.lower_bound(point.x());
+				if (next != std::end(m_Points) && next->first == point.x())
+				{
+					if (!isBeyond(point.y(), next->second))
+						return false;
+					next = m_Points.erase(next);
+				}
+				else if (next != std::end(m_Points) && next != std::begin(m_Points) &&
+					turn(toVector(*std::prev(next)), point, toVector(*next)) <= 0)
+					return false;
+
+				auto current = m_Points.emplace_hint(next, point.x(), point.y());
+				for (auto succ = std::next(current); succ != std::end(m_Points) && std::next(succ) != std::end(m_Points);
+					succ = std::next(current))
+				{
+					if (0 < turn(point, toVector(*succ), toVector(*std::next(succ))))
+						break;
+					m_Points.erase(succ);
+				}
+				while (current != std::begin(m_Points) && std::prev(current) != std::begin(m_Points))
+				{
+					auto pred = std::prev(current);
+					if (0 < turn(toVector(*std::prev(pred)), toVector(*pred), point))
+						break;
+					m_Points.erase(pred);
+				}
+				return true;
+			}
+
+			[[nodiscard]] bool encloses(const VectorType& point) const
+			{
+				auto next = m_Points.lower_bound(point.x());
+				if (next == std::end(m_Points))
+					return false;
+				if (next->first == point.x())
+					return !isBeyond(point.y(), next->second);
+				return next != std::begin(m_Points) && turn(toVector(*std::prev(next)), point, toVector(*next)) <= 0;
+			}
+
+			[[nodiscard]] bool empty() const noexcept
+			{
+				return std::empty(m_Points);
+			}
+
+			void clear() noexcept
+			{
+				m_Points.clear();
+			}
+
+			void appendAscending(std::vector<VectorType>& out) const
+			{
+				for (auto& entry : m_Points)
+					out.emplace_back(toVector(entry));
+			}
+
+			void appendDescending(std::vector<VectorType>& out) const
+			{
+				for (auto iter = std::rbegin(m_Points); iter != std::rend(m_Points); ++iter)
+					out.emplace_back(toVector(*iter));
+			}
+
+		private:
+			std::map<ValueType, ValueType> m_Points;
+
+			// whether y lies outside of the chain vertex at the same x
+			[[nodiscard]] static bool isBeyond(ValueType y, ValueType chainY) noexcept
+			{
+				if constexpr (TUpper)
+					return chainY < y;
+				else
+					return y < chainY;
+			}
+
+			// positive, if middle is a convex vertex of the chain between first and last
+			[[nodiscard]] static detail::HullCross_t<ValueType> turn(const VectorType& first, const VectorType& middle, const VectorType& last) noexcept
+			{
+				auto side = detail::orientation(first, middle, last);
+				if constexpr (TUpper)
+					return -side;
+				else
+					return side;
+			}
+
+			[[nodiscard]] static VectorType toVector(const std::pair<const ValueType, ValueType>& entry) noexcept
+			{
+				return { entry.first, entry.second };
+			}
+		};
+
+		Chain<true> m_Upper;
+		Chain<false> m_Lower;
+	};
+}
+
+#endif
@@ -0,0 +1,468 @@
+//          Copyright Dominic Koepke 2017 - 2020.
+// Distributed under the Boost Software License, Version 1.0.
+//    (See accompanying file LICENSE_1_0.txt or copy at
+//          https://www.boost.org/LICENSE_1_0.txt)
+
+#ifndef GEORITHM_DYNAMIC_AABB_TREE_HPP
+#define GEORITHM_DYNAMIC_AABB_TREE_HPP
+
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cassert>
+#include <concepts>
+#include <cstddef>
+#include <functional>
+#include <limits>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "georithm/Bounding.hpp"
+#include "georithm/Concepts.hpp"
+#include "georithm/GeometricTraits.hpp"
+#include "georithm/Rect.hpp"
+#include "georithm/Utility.hpp"
+#include "georithm/Vector.hpp"
+
+namespace georithm
+{
+	/* Bounding volume hierarchy of axis aligned rects, which supports insertion, removal and movement of objects at any time.
+	 * Each object is stored as leaf with a fat bounding rect, which is the boundingRect of the object enlarged by the margin;
+	 * thus small movements don't require any restructuring of the tree. Insertions choose their sibling by the perimeter based
+	 * surface area heuristic and the tree is kept balanced by rotations.
+	 * Proxy ids are stable until the proxy gets removed; afterwards they may be reused.
+	 */
+	template <class T, std::semiregular TUserData = std::size_t>
+	class DynamicAABBTree
+	{
+	public:
+		using ValueType = T;
+		using UserDataType = TUserData;
+		using AABBType = AABB_t<T>;
+		using ProxyId = std::size_t;
+		constexpr static ProxyId nullProxy = std::numeric_limits<ProxyId>::max();
+
+		explicit DynamicAABBTree(T margin = T(0)) noexcept :
+			m_Margin{ margin }
+		{
+			assert(0 <= margin);
+		}
+
+		template <BoundedObject<T> TObject>
+		ProxyId insert(const TObject& object, TUserData userData)
+		{
+			auto proxyId = allocateNode();
+			auto& node = m_Nodes[proxyId];
+			node.bounds = fatten(detail::boundingRectAs<T>(object));
+			node.userData = std::move(userData);
+			node.height = 0;
+			insertLeaf(proxyId);
+			++m_ProxyCount;
+			return proxyId;
+		}
+
+		void remove(ProxyId proxyId) noexcept
+		{
+			assert(isLeaf(proxyId));
+
+			removeLeaf(proxyId);
+			freeNode(proxyId);
+			--m_ProxyCount;
+		}
+
+		/* Updates the proxy to the current bounds of object. The tree only gets restructured, if the new bounds leave the fat bounds;
+		 * in that case the new fat bounds are additionally enlarged in direction of displacement, which predicts the next movement.
+		 * Returns true if the proxy has been reinserted.
+		 */
+		template <BoundedObject<T> TObject>
+		bool move(ProxyId proxyId, const TObject& object, const Vector<T, 2>& displacement = Vector<T, 2>::zero())
+		{
+			assert(isLeaf(proxyId));
+
+			auto bounds = detail::boundingRectAs<T>(object);
+			if (detail::containsBounds(m_Nodes[proxyId].bounds, bounds))
+				return false;
+
+			removeLeaf(proxyId);
+
+			auto fatBounds = fatten(bounds);
+			auto position = fatBounds.position();
+			auto span = fatBounds.span();
+			for (DimensionDescriptor_t i = 0; i < 2; ++i)
+			{
+				if (displacement[i] < 0)
+					position[i] += displacement[i];
+				span[i] += displacement[i] < 0 ? -displacement[i] : displacement[i];
+			}
+			m_Nodes[proxyId].bounds = { position, span };
+
+			insertLeaf(proxyId);
+			return true;
+		}
+
+		void clear() noexcept
+		{
+			m_Nodes.clear();
+			m_Root = nullProxy;
+			m_FreeList = nullProxy;
+			m_ProxyCount = 0;
+		}
+
+		[[nodiscard]] const AABBType& fatBounds(ProxyId proxyId) const noexcept
+		{
+			assert(isLeaf(proxyId));
+			return m_Nodes[proxyId].bounds;
+		}
+
+		[[nodiscard]] const TUserData& userData(ProxyId proxyId) const noexcept
+		{
+			assert(isLeaf(proxyId));
+			return m_Nodes[proxyId].userData;
+		}
+
+		[[nodiscard]] TUserData& userData(ProxyId proxyId) noexcept
+		{
+			assert(isLeaf(proxyId));
+			return m_Nodes[proxyId].userData;
+		}
+
+		[[nodiscard]] T margin() const noexcept
+		{
+			return m_Margin;
+		}
+
+		[[nodiscard]] std::size_t size() const noexcept
+		{
+			return m_ProxyCount;
+		}
+
+		[[nodiscard]] bool empty() const noexcept
+		{
+			return m_ProxyCount == 0;
+		}
+
+		// height of the root node; a tree with a single proxy has height 0
+		[[nodiscard]] int height() const noexcept
+		{
+			return m_Root == nullProxy ? 0 : m_Nodes[m_Root].height;
+		}
+
+		/* Invokes callback(proxyId) for each proxy, whose fat bounds intersect (or touch) the bounding rect of object.
+		 * If callback returns false, the query stops early.
+		 */
+		template <BoundedObject<T> TObject, class TCallback>
+		requires std::invocable<TCallback&, ProxyId>
+		void query(const TObject& object, TCallback callback) const
+		{
+			queryImpl(detail::boundingRectAs<T>(object), callback);
+		}
+
+		/* Invokes callback(proxyId) for each proxy, whose fat bounds contain point.
+		 * If callback returns false, the query stops early.
+		 */
+		template <NDimensionalVectorObject<2> TVector, class TCallback>
+		requires std::is_same_v<typename TVector::ValueType, T> && std::invocable<TCallback&, ProxyId>
+		void queryPoint(const TVector& point, TCallback callback) const
+		{
+			queryImpl(AABBType{ { point.x(), point.y() }, { T{}, T{} } }, callback);
+		}
+
+		/* Invokes callback(lhsProxyId, rhsProxyId) once for each unordered pair of proxies with intersecting (or touching) fat bounds;
+		 * lhsProxyId is always less than rhsProxyId. If callback returns false, the enumeration stops early.
+		 */
+		template <class TCallback>
+		requires std::invocable<TCallback&, ProxyId, ProxyId>
+		void forEachOverlappingPair(TCallback callback) const
+		{
+			for (ProxyId proxyId = 0; proxyId < std::size(m_Nodes); ++proxyId)
+			{
+				if (!isLeaf(proxyId))
+					continue;
+
+				bool proceed = true;
+				auto pairCallback = [&](ProxyId other)
+				{
+					if (proxyId < other)
+						proceed = detail::invokeTraversalCallback(callback, proxyId, other);
+					return proceed;
+				};
+				queryImpl(m_Nodes[proxyId].bounds, pairCallback);
+				if (!proceed)
+					return;
+			}
+		}
+
+	private:
+		struct Node
+		{
+			AABBType bounds;
+			// next node of the free list, if the node isn't in use
+			ProxyId parent = nullProxy;
+			ProxyId child1 = nullProxy;
+			ProxyId child2 = nullProxy;
+			// -1 for free nodes, 0 for leafs
+			int height = -1;
+			TUserData userData{};
+		};
+
+		T m_Margin;
+		std::vector<Node> m_Nodes;
+		ProxyId m_Root = nullProxy;
+		ProxyId m_FreeList = nullProxy;
+		std::size_t m_ProxyCount = 0;
+
+		[[nodiscard]] bool isLeaf(ProxyId nodeId) const noexcept
+		{
+			return nodeId < std::size(m_Nodes) && m_Nodes[nodeId].height == 0;
+		}
+
+		// expects normalized bounds
+		[[nodiscard]] AABBType fatten(const AABBType& bounds) const noexcept
+		{
+			return { bounds.position() - m_Margin, bounds.span() + 2 * m_Margin };
+		}
+
+		ProxyId allocateNode()
+		{
+			if (m_FreeList == nullProxy)
+			{
+				m_Nodes.emplace_back();
+				return std::size(m_Nodes) - 1;
+			}
+
+			auto nodeId = m_FreeList;
+			m_FreeList = m_Nodes[nodeId].parent;
+			m_Nodes[nodeId] = Node{};
+			return nodeId;
+		}
+
+		void freeNode(ProxyId nodeId) noexcept
+		{
+			auto& node = m_Nodes[nodeId];
+			node.parent = m_FreeList;
+			node.height = -1;
+			node.userData = TUserData{};
+			m_FreeList = nodeId;
+		}
+
+		template <class TCallback>
+		void queryImpl(const AABBType& bounds, TCallback& callback) const
+		{
+			if (m_Root == nullProxy)
+				return;
+
+			// each traversed level leaves at most one pending node on the stack
+			constexpr std::size_t inlineStackSize = 64;
+			auto requiredStackSize = static_cast<std::size_t>(m_Nodes[m_Root].height) + 2;
+			if (requiredStackSize <= inlineStackSize)
+			{
+				std::array<ProxyId, inlineStackSize> stack;
+				traverse(bounds, callback, std::data(stack));
+			}
+			else
+			{
+				std::vector<ProxyId> stack(requiredStackSize);
+				traverse(bounds, callback, std::data(stack));
+			}
+		}
+
+		template <class TCallback>
+		void traverse(const AABBType& bounds, TCallback& callback, ProxyId* stack) const
+		{
+			std::size_t stackSize = 0;
+			stack[stackSize++] = m_Root;
+			while (0 < stackSize)
+			{
+				auto& node = m_Nodes[stack[--stackSize]];
+				if (!detail::intersectsBounds(node.bounds, bounds))
+					continue;
+
+				if (node.height == 0)
+				{
+					if (!detail::invokeTraversalCallback(callback, static_cast<ProxyId>(&node - std::data(m_Nodes))))
+						return;
+				}
+				else
+				{
+					stack[stackSize++] = node.child1;
+					stack[stackSize++] = node.child2;
+				}
+			}
+		}
+
+		void insertLeaf(ProxyId leaf)
+		{
+			if (m_Root == nullProxy)
+			{
+				m_Root = leaf;
+				m_Nodes[leaf].parent = nullProxy;
+				return;
+			}
+
+			// find the best sibling
+			auto leafBounds = m_Nodes[leaf].bounds;
+			auto index = m_Root;
+			while (m_Nodes[index].height != 0)
+			{
+				auto& node = m_Nodes[index];
+				auto combinedPerimeter = detail::perimeter(detail::boundingRect(node.bounds, leafBounds));
+
+				// cost of creating a new parent for this node and the new leaf
+				auto cost = 2 * combinedPerimeter;
+				// minimum cost of pushing the leaf further down the tree
+				auto inheritanceCost = 2 * (combinedPerimeter - detail::perimeter(node.bounds));
+
+				auto descendingCost = [&](ProxyId child)
+				{
+					auto& childNode = m_Nodes[child];
+					auto perimeter = detail::perimeter(detail::boundingRect(childNode.bounds, leafBounds));
+					if (childNode.height == 0)
+						return perimeter + inheritanceCost;
+					return perimeter - detail::perimeter(childNode.bounds) + inheritanceCost;
+				};
+				auto cost1 = descendingCost(node.child1);
+				auto cost2 = descendingCost(node.child2);
+
+				if (cost < cost1 && cost < cost2)
+					break;
+
+				index = cost1 < cost2 ? node.child1 : node.child2;
+			}
+			auto sibling = index;
+
+			// create a new parent
+			auto oldParent = m_Nodes[sibling].parent;
+			auto newParent = allocateNode();
+			{
+				auto& parentNode = m_Nodes[newParent];
+				parentNode.parent = oldParent;
+				parentNode.bounds = detail::boundingRect(leafBounds, m_Nodes[sibling].bounds);
+				parentNode.height = m_Nodes[sibling].height + 1;
+				parentNode.child1 = sibling;
+				parentNode.child2 = leaf;
+			}
+			m_Nodes[sibling].parent = newParent;
+			m_Nodes[leaf].parent = newParent;
+
+			if (oldParent == nullProxy)
+				m_Root = newParent;
+			else if (m_Nodes[oldParent].child1 == sibling)
+				m_Nodes[oldParent].child1 = newParent;
+			else
+				m_Nodes[oldParent].child2 = newParent;
+
+			refitAncestors(m_Nodes[leaf].parent);
+		}
+
+		void removeLeaf(ProxyId leaf) noexcept
+		{
+			if (leaf == m_Root)
+			{
+				m_Root = nullProxy;
+				return;
+			}
+
+			auto parent = m_Nodes[leaf].parent;
+			auto grandParent = m_Nodes[parent].parent;
+			auto sibling = m_Nodes[parent].child1 == leaf ? m_Nodes[parent].child2 : m_Nodes[parent].child1;
+
+			if (grandParent == nullProxy)
+			{
+				m_Root = sibling;
+				m_Nodes[sibling].parent = nullProxy;
+				freeNode(parent);
+				return;
+			}
+
+			if (m_Nodes[grandParent].child1 == parent)
+				m_Nodes[grandParent].child1 = sibling;
+			else
+				m_Nodes[grandParent].child2 = sibling;
+			m_Nodes[sibling].parent = grandParent;
+			freeNode(parent);
+
+			refitAncestors(grandParent);
+		}
+
+		// walks up to the root, while balancing the nodes and recomputing their heights and bounds
+		void refitAncestors(ProxyId index) noexcept
+		{
+			while (index != nullProxy)
+			{
+				index = balance(index);
+
+				auto& node = m_Nodes[index];
+				auto& child1 = m_Nodes[node.child1];
+				auto& child2 = m_Nodes[node.child2];
+				node.height = 1 + std::max(child1.height, child2.height);
+				node.bounds = detail::boundingRect(child1.bounds, child2.bounds);
+
+				index = node.parent;
+			}
+		}
+
+		// promotes the higher child of nodeA, if the heights of its children differ by more than one; returns the new subtree root
+		ProxyId balance(ProxyId iA) noexcept
+		{
+			auto& A = m_Nodes[iA];
+			if (A.height < 2)
+				return iA;
+
+			auto iB = A.child1;
+			auto iC = A.child2;
+			auto& B = m_Nodes[iB];
+			auto& C = m_Nodes[iC];
+			auto heightDiff = C.height - B.height;
+
+			auto rotateUp = [&](ProxyId iUp, Node& up, ProxyId& slotInA, Node& remaining)
+			{
+				auto iF = up.child1;
+				auto iG = up.child2;
+				auto& F = m_Nodes[iF];
+				auto& G = m_Nodes[iG];
+
+				// swap A and up
+				up.child1 = iA;
+				up.parent = A.parent;
+				A.parent = iUp;
+
+				if (up.parent == nullProxy)
+					m_Root = iUp;
+				else if (m_Nodes[up.parent].child1 == iA)
+					m_Nodes[up.parent].child1 = iUp;
+				else
+					m_Nodes[up.parent].child2 = iUp;
+
+				// the higher grandchild stays at up, the other one moves to A
+				auto [iHigh, iLow] = G.height < F.height ? std::pair{ iF, iG } : std::pair{ iG, iF };
+				auto& high = m_Nodes[iHigh];
+				auto& low = m_Nodes[iLow];
+				up.child2 = iHigh;
+				slotInA = iLow;
+				low.parent = iA;
+				A.bounds = detail::boundingRect(remaining.bounds, low.bounds);
+				up.bounds = detail::boundingRect(A.bounds, high.bounds);
+				A.height = 1 + std::max(remaining.height, low.height);
+				up.height = 1 + std::max(A.height, high.height);
+			};
+
+			if (1 < heightDiff)
+			{
+				rotateUp(iC, C, A.child2, B);
+				return iC;
+			}
+
+			if (heightDiff < -1)
+			{
+				rotateUp(iB, B, A.child1, C);
+				return iB;
+			}
+
+			return iA;
+		}
+	};
+}
+
+#endif
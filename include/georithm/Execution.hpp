@@ -0,0 +1,129 @@
+//          Copyright Dominic Koepke 2017 - 2020.
+// Distributed under the Boost Software License, Version 1.0.
+//    (See accompanying file LICENSE_1_0.txt or copy at
+//          https://www.boost.org/LICENSE_1_0.txt)
+
+#ifndef GEORITHM_EXECUTION_HPP
+#define GEORITHM_EXECUTION_HPP
+
+#pragma once
+
+#include <concepts>
+#include <cstddef>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "georithm/Executor.hpp"
+#include "georithm/ThreadPool.hpp"
+
+/* Execution policies of the range algorithms, named after the ones of <execution>. Those of the standard can't be used, because the
+ * standard library doesn't let anybody look into them (and libstdc++ requires TBB for them), thus georithm has its own:
+ *	seq			processes each element on its own by the scalar algorithm, in order
+ *	unseq		single threaded, but uses the batch kernels, which process several elements at once (SIMD) and share work between them
+ *	par			splits the range into chunks, which get processed by the scalar algorithm on an Executor
+ *	par_unseq	as par, but each chunk runs the batch kernel
+ * The parallel policies run on defaultExecutor(), unless they are bound to another one by on(executor).
+ */
+
+namespace georithm::execution
+{
+	struct SequencedPolicy
+	{
+	};
+
+	struct UnsequencedPolicy
+	{
+	};
+
+	struct ParallelPolicy
+	{
+		Executor* executor = nullptr;
+
+		[[nodiscard]] constexpr ParallelPolicy on(Executor& executor_) const noexcept
+		{
+			return { &executor_ };
+		}
+	};
+
+	struct ParallelUnsequencedPolicy
+	{
+		Executor* executor = nullptr;
+
+		[[nodiscard]] constexpr ParallelUnsequencedPolicy on(Executor& executor_) const noexcept
+		{
+			return { &executor_ };
+		}
+	};
+
+	inline constexpr SequencedPolicy seq{};
+	inline constexpr UnsequencedPolicy unseq{};
+	inline constexpr ParallelPolicy par{};
+	inline constexpr ParallelUnsequencedPolicy par_unseq{};
+}
+
+namespace georithm
+{
+	template <class T>
+	concept ExecutionPolicy = std::same_as<std::remove_cvref_t<T>, execution::SequencedPolicy> ||
+	std::same_as<std::remove_cvref_t<T>, execution::UnsequencedPolicy> ||
+	std::same_as<std::remove_cvref_t<T>, execution::ParallelPolicy> ||
+	std::same_as<std::remove_cvref_t<T>, execution::ParallelUnsequencedPolicy>;
+}
+
+namespace georithm::detail
+{
+	// elements per chunk of the parallel policies; the range algorithms are cheap per element, thus smaller chunks don't pay off
+	constexpr std::size_t policyGrainSize = 4096;
+
+	template <ExecutionPolicy TPolicy>
+	constexpr bool IsParallelPolicy_v = std::same_as<std::remove_cvref_t<TPolicy>, execution::ParallelPolicy> ||
+	std::same_as<std::remove_cvref_t<TPolicy>, execution::ParallelUnsequencedPolicy>;
+
+	// whether the batch kernels may be used
+	template <ExecutionPolicy TPolicy>
+	constexpr bool IsUnsequencedPolicy_v = std::same_as<std::remove_cvref_t<TPolicy>, execution::UnsequencedPolicy> ||
+	std::same_as<std::remove_cvref_t<TPolicy>, execution::ParallelUnsequencedPolicy>;
+
+	template <ExecutionPolicy TPolicy>
+	requires IsParallelPolicy_v<TPolicy>
+	[[nodiscard]] Executor& executorOf(const TPolicy& policy)
+	{
+		return policy.executor ? *policy.executor : defaultExecutor();
+	}
+
+	/* Invokes kernel(begin, end) for the whole range [0, count) on the calling thread, or for chunks of it on the executor of the
+	 * parallel policies. Kernels of distinct chunks may run concurrently, thus they must only write the elements of their own chunk.
+	 */
+	template <ExecutionPolicy TPolicy, class TKernel>
+	requires std::invocable<TKernel&, std::size_t, std::size_t>
+	void forEachChunk(const TPolicy& policy, std::size_t count, TKernel kernel)
+	{
+		if constexpr (IsParallelPolicy_v<TPolicy>)
+			executorOf(policy).parallelFor(count, policyGrainSize, std::move(kernel));
+		else if (0 < count)
+			kernel(0, count);
+	}
+
+	/* Same as forEachChunk, but combines the results of the kernel invocations in order with identity. The chunks never overlap and
+	 * are never empty.
+	 */
+	template <ExecutionPolicy TPolicy, class TValue, class TKernel, class TCombine>
+	requires std::invocable<TKernel&, std::size_t, std::size_t>
+	[[nodiscard]] TValue reduceChunks(const TPolicy& policy, std::size_t count, TValue identity, TKernel kernel, TCombine combine)
+	{
+		if constexpr (IsParallelPolicy_v<TPolicy>)
+			return executorOf(policy).parallelReduce(count, policyGrainSize, std::move(identity), std::move(kernel), std::move(combine));
+		else if (0 < count)
+			return combine(std::move(identity), kernel(0, count));
+		else
+			return identity;
+	}
+
+	// concurrent writes to distinct elements of std::vector<bool> are data races, thus the parallel policies can't write into it
+	template <ExecutionPolicy TPolicy, class TOutIterator>
+	constexpr bool IsConcurrentlyWritable_v = !IsParallelPolicy_v<TPolicy> ||
+	!std::same_as<TOutIterator, typename std::vector<bool>::iterator>;
+}
+
+#endif
@@ -0,0 +1,147 @@
+//          Copyright Dominic Koepke 2017 - 2020.
+// Distributed under the Boost Software License, Version 1.0.
+//    (See accompanying file LICENSE_1_0.txt or copy at
+//          https://www.boost.org/LICENSE_1_0.txt)
+
+#ifndef GEORITHM_EXECUTOR_HPP
+#define GEORITHM_EXECUTOR_HPP
+
+#pragma once
+
+#include <algorithm>
+#include <cassert>
+#include <concepts>
+#include <cstddef>
+#include <exception>
+#include <memory>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace georithm
+{
+	// non-owning reference to a callable, which gets invoked with the index of a chunk
+	class ChunkFunctionRef
+	{
+	public:
+		template <class TFunc>
+		requires std::invocable<TFunc&, std::size_t> && (!std::same_as<std::remove_cvref_t<TFunc>, ChunkFunctionRef>)
+		explicit ChunkFunctionRef(TFunc& func) noexcept :
+			m_Func{ std::addressof(func) },
+			m_Invoke{ [](void* func, std::size_t chunk) { (*static_cast<TFunc*>(func))(chunk); } }
+		{
+		}
+
+		void operator ()(std::size_t chunk) const
+		{
+			m_Invoke(m_Func, chunk);
+		}
+
+	private:
+		void* m_Func;
+		void (*m_Invoke)(void*, std::size_t);
+	};
+
+	/* Interface of everything, which runs the parallel algorithms of georithm. All of them take an Executor (defaultExecutor() unless
+	 * told otherwise; see ThreadPool.hpp), thus users may plug in their own threading by implementing runChunks, e.g. to forward the
+	 * work to the task system of their application or to limit the threads used by georithm.
+	 */
+	class Executor
+	{
+	public:
+		virtual ~Executor() noexcept = default;
+
+		// maximal count of threads, which process chunks at the same time; the algorithms size their chunks by it
+		[[nodiscard]] virtual std::size_t concurrency() const noexcept = 0;
+
+		/* Splits [0, count) into chunks of grainSize elements and invokes func(begin, end) for each of them, possibly in parallel.
+		 * Returns after all chunks have been processed; the first exception thrown by func is rethrown afterwards. Single chunks and
+		 * executors without concurrency run directly on the calling thread.
+		 */
+		template <class TFunc>
+		requires std::invocable<TFunc&, std::size_t, std::size_t>
+		void parallelFor(std::size_t count, std::size_t grainSize, TFunc func)
+		{
+			assert(0 < grainSize);
+
+			auto chunkCount = (count + grainSize - 1) / grainSize;
+			if (chunkCount <= 1 || concurrency() <= 1)
+			{
+				for (std::size_t begin = 0; begin < count; begin += grainSize)
+					func(begin, std::min(begin + grainSize, count));
+				return;
+			}
+
+			auto runChunk = [&func, count, grainSize](std::size_t chunk)
+			{
+				auto begin = chunk * grainSize;
+				func(begin, std::min(begin + grainSize, count));
+			};
+			runChunks(chunkCount, ChunkFunctionRef{ runChunk });
+		}
+
+		/* Invokes func(begin, end) for each chunk as parallelFor does and combines the results of all chunks with identity by
+		 * combine(lhs, rhs). The results are always combined in order of their chunks, thus the result only depends on grainSize, even
+		 * if combine isn't associative (e.g. floating point sums).
+		 */
+		template <class TValue, class TFunc, class TCombine>
+		requires std::invocable<TFunc&, std::size_t, std::size_t> &&
+		std::convertible_to<std::invoke_result_t<TFunc&, std::size_t, std::size_t>, TValue> &&
+		std::convertible_to<std::invoke_result_t<TCombine&, TValue, TValue>, TValue>
+		[[nodiscard]] TValue parallelReduce(std::size_t count, std::size_t grainSize, TValue identity, TFunc func, TCombine combine)
+		{
+			assert(0 < grainSize);
+
+			// wrapped, because the elements of std::vector<bool> can't be written concurrently
+			struct Partial
+			{
+				TValue value;
+			};
+			std::vector<Partial> partials((count + grainSize - 1) / grainSize, Partial{ identity });
+			parallelFor(count, grainSize, [&](std::size_t begin, std::size_t end) { partials[begin / grainSize].value = func(begin, end); });
+
+			for (auto& partial : partials)
+				identity = combine(std::move(identity), std::move(partial.value));
+			return identity;
+		}
+
+	protected:
+		/* Must invoke runChunk(chunk) exactly once for each chunk in [0, chunkCount) and return after all of them have finished.
+		 * Exceptions thrown by runChunk must not stop the other chunks; the first one has to be rethrown at the end.
+		 */
+		virtual void runChunks(std::size_t chunkCount, ChunkFunctionRef runChunk) = 0;
+	};
+
+	// runs everything on the calling thread
+	class SequentialExecutor final :
+		public Executor
+	{
+	public:
+		[[nodiscard]] std::size_t concurrency() const noexcept override
+		{
+			return 1;
+		}
+
+	protected:
+		void runChunks(std::size_t chunkCount, ChunkFunctionRef runChunk) override
+		{
+			std::exception_ptr exception;
+			for (std::size_t chunk = 0; chunk < chunkCount; ++chunk)
+			{
+				try
+				{
+					runChunk(chunk);
+				}
+				catch (...)
+				{
+					if (!exception)
+						exception = std::current_exception();
+				}
+			}
+			if (exception)
+				std::rethrow_exception(exception);
+		}
+	};
+}
+
+#endif
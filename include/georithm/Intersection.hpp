@@ -18,14 +18,14 @@
 
 namespace georithm::detail
 {
-	template <LineObject TLine>
-	constexpr bool isWithinRange(const TLine& line, typename GeometricTraits<TLine>::ValueType dist) noexcept
+	template <LineType TLineType, class T>
+	constexpr bool isWithinRange(T dist) noexcept
 	{
-		if constexpr (TLine::type == LineType::segment)
+		if constexpr (TLineType == LineType::segment)
 		{
 			return 0 <= dist && dist <= 1;
 		}
-		else if constexpr (TLine::type == LineType::ray)
+		else if constexpr (TLineType == LineType::ray)
 		{
 			return 0 <= dist;
 		}
@@ -33,6 +33,12 @@ namespace georithm::detail
 			return true;
 	}
 
+	template <LineObject TLine>
+	constexpr bool isWithinRange(const TLine&, typename GeometricTraits<TLine>::ValueType dist) noexcept
+	{
+		return isWithinRange<TLine::type>(dist);
+	}
+
 	template <NDimensionalLineObject<2> TLine1, NDimensionalLineObject<2> TLine2>
 	constexpr std::tuple<LineIntersectionResult, typename GeometricTraits<TLine1>::ValueType, typename GeometricTraits<TLine2>::ValueType> intersectionImpl(
 		const TLine1& lhs,
@@ -93,7 +99,7 @@ namespace georithm::detail
 		std::optional<Value_t> smallestDist;
 		forEachIntersectionImpl(line,
 								polygon,
-								[&smallestDist](Value_t lineDist, const TLine& edge, Value_t edgeDist)
+								[&smallestDist](Value_t lineDist, const auto& edge, Value_t edgeDist)
 								{
 									if (!smallestDist || std::abs(lineDist) < std::abs(*smallestDist))
 										smallestDist = lineDist;
@@ -8,12 +8,22 @@
 
 #pragma once
 
+#include <algorithm>
+#include <array>
 #include <cassert>
+#include <cstddef>
+#include <iterator>
+#include <ranges>
 #include <tuple>
 
+#include "georithm/Bounding.hpp"
 #include "georithm/Concepts.hpp"
+#include "georithm/Execution.hpp"
+#include "georithm/GeometricTraits.hpp"
+#include "georithm/Rect.hpp"
 #include "georithm/Utility.hpp"
 #include "georithm/Intersection.hpp"
+#include "georithm/Vector.hpp"
 
 namespace georithm::detail
 {
@@ -24,30 +34,194 @@ namespace georithm::detail
 		return std::get<0>(intersection(lhs, rhs)) == LineIntersectionResult::intersecting;
 	}
 
+	/* Conservative test, which only rejects lines that can't touch the bounds. Any line is rejected if all corners of the bounds lie
+	 * strictly on one side of it; segments must additionally overlap the bounds with their own bounds and rays must not have all
+	 * corners behind their origin.
+	 */
+	template <NDimensionalLineObject<2> TLine, class T>
+	[[nodiscard]] constexpr bool intersectsBounds(const TLine& line, const AABB_t<T>& bounds) noexcept
+	{
+		if constexpr (TLine::type == LineType::segment)
+		{
+			if (!intersectsBounds(detail::boundingRect(line.firstVertex(), line.secondVertex()), bounds))
+				return false;
+		}
+
+		auto& position = bounds.position();
+		auto& span = bounds.span();
+		std::array corners{
+			position,
+			Vector<T, 2>{ position.x() + span.x(), position.y() },
+			position + span,
+			Vector<T, 2>{ position.x(), position.y() + span.y() }
+		};
+
+		auto& direction = line.direction();
+		int leftCount = 0;
+		int rightCount = 0;
+		int behindCount = 0;
+		for (auto& corner : corners)
+		{
+			auto local = corner - line.location();
+			auto cross = direction.x() * local.y() - direction.y() * local.x();
+			leftCount += 0 < cross;
+			rightCount += cross < 0;
+			behindCount += scalarProduct(direction, local) < 0;
+		}
+
+		if (leftCount == 4 || rightCount == 4)
+			return false;
+		return TLine::type != LineType::ray || behindCount < 4;
+	}
+
 	template <NDimensionalLineObject<2> TLine, NDimensionalPolygonalObject<2> TPoly>
-	constexpr bool intersectsImpl(const TLine& line, const TPoly& polygon) noexcept
+	constexpr bool intersectsByEdges(const TLine& line, const TPoly& polygon) noexcept
 	{
 		assert(!isNull(line) && !isNull(polygon));
 		for (VertexIndex_t i = 0; i < edgeCount(polygon); ++i)
 		{
-			if (intersects(line, edge(polygon, i)))
+			if (intersectsImpl(line, edge(polygon, i)))
 				return true;
 		}
 		return false;
 	}
 
 	template <NDimensionalPolygonalObject<2> TPoly1, NDimensionalPolygonalObject<2> TPoly2>
-	constexpr bool intersectsImpl(const TPoly1& lhs, const TPoly2& rhs) noexcept
+	constexpr bool intersectsByEdges(const TPoly1& lhs, const TPoly2& rhs) noexcept
 	{
 		assert(!isNull(lhs) && !isNull(rhs));
 		for (VertexIndex_t i = 0; i < edgeCount(lhs); ++i)
 		{
-			if (intersects(edge(lhs, i), rhs))
+			if (intersectsByEdges(edge(lhs, i), rhs))
 				return true;
 		}
 		return false;
 	}
 
+	template <NDimensionalLineObject<2> TLine, NDimensionalPolygonalObject<2> TPoly>
+	constexpr bool intersectsImpl(const TLine& line, const TPoly& polygon, const AABB_t<typename GeometricTraits<TPoly>::ValueType>& polygonBounds) noexcept
+	{
+		return intersectsBounds(line, polygonBounds) && intersectsByEdges(line, polygon);
+	}
+
+	template <NDimensionalLineObject<2> TLine, NDimensionalPolygonalObject<2> TPoly>
+	constexpr bool intersectsImpl(const TLine& line, const TPoly& polygon) noexcept
+	{
+		return intersectsImpl(line, polygon, detail::boundingRect(polygon));
+	}
+
+	template <NDimensionalPolygonalObject<2> TPoly1, NDimensionalPolygonalObject<2> TPoly2, class T>
+	constexpr bool intersectsImpl(const TPoly1& lhs, const AABB_t<T>& lhsBounds, const TPoly2& rhs, const AABB_t<T>& rhsBounds) noexcept
+	{
+		return intersectsBounds(lhsBounds, rhsBounds) && intersectsByEdges(lhs, rhs);
+	}
+
+	template <NDimensionalPolygonalObject<2> TPoly1, NDimensionalPolygonalObject<2> TPoly2>
+	constexpr bool intersectsImpl(const TPoly1& lhs, const TPoly2& rhs) noexcept
+	{
+		return intersectsImpl(lhs, detail::boundingRect(lhs), rhs, detail::boundingRect(rhs));
+	}
+
+	/*#####
+	 * separating axis theorem
+	 *#####*/
+	struct SeparatingAxisResult
+	{
+		bool separated = false;
+		// the lhs lies completely in the interior of the rhs and vice versa
+		bool lhsInsideRhs = true;
+		bool rhsInsideLhs = true;
+	};
+
+	/* Opposing edges of transformed floating point rects are parallel, thus only two of them are necessary as separating axis.
+	 * Integral rects round each vertex on its own, which tilts opposing edges against each other, unless the rect is axis aligned.
+	 */
+	template <NDimensionalConvexPolygonalObject<2> TPolygon>
+	[[nodiscard]] constexpr VertexIndex_t separatingAxisCount(const TPolygon& polygon) noexcept
+	{
+		using T = typename GeometricTraits<TPolygon>::ValueType;
+		if constexpr (IsRect_v<TPolygon> && (std::floating_point<T> || std::same_as<TPolygon, AABB_t<T>>))
+			return 2;
+		else
+			return vertexCount(polygon);
+	}
+
+	template <class TVertices, NDimensionalVectorObject<2> TVector>
+	[[nodiscard]] constexpr std::pair<typename TVector::ValueType, typename TVector::ValueType> project(const TVertices& vertices, const TVector& axis) noexcept
+	{
+		assert(!std::empty(vertices));
+
+		auto min = scalarProduct(vertices[0], axis);
+		auto max = min;
+		for (std::size_t i = 1; i < std::size(vertices); ++i)
+		{
+			auto projection = scalarProduct(vertices[i], axis);
+			min = std::min(min, projection);
+			max = std::max(max, projection);
+		}
+		return { min, max };
+	}
+
+	/* Projects both vertex sets onto the normals of the first axisCount edges of the axisVertices. Touching intervals aren't
+	 * treated as separated, which matches the closed boundaries of the edge based intersection tests.
+	 */
+	template <class TAxisVertices, class TOtherVertices>
+	constexpr bool testSeparatingAxes(const TAxisVertices& axisVertices,
+									VertexIndex_t axisCount,
+									const TOtherVertices& otherVertices,
+									bool& otherInside
+	) noexcept
+	{
+		auto count = std::size(axisVertices);
+		for (VertexIndex_t i = 0; i < axisCount; ++i)
+		{
+			auto direction = axisVertices[(i + 1) % count] - axisVertices[i];
+			decltype(direction) normal{ -direction.y(), direction.x() };
+
+			auto [axisMin, axisMax] = project(axisVertices, normal);
+			auto [otherMin, otherMax] = project(otherVertices, normal);
+			if (axisMax < otherMin || otherMax < axisMin)
+				return true;
+			otherInside = otherInside && axisMin < otherMin && otherMax < axisMax;
+		}
+		return false;
+	}
+
+	template <class TVertices1, class TVertices2>
+	[[nodiscard]] constexpr SeparatingAxisResult separatingAxisTest(const TVertices1& lhsVertices,
+																	VertexIndex_t lhsAxisCount,
+																	const TVertices2& rhsVertices,
+																	VertexIndex_t rhsAxisCount
+	) noexcept
+	{
+		SeparatingAxisResult result;
+		result.separated = testSeparatingAxes(lhsVertices, lhsAxisCount, rhsVertices, result.rhsInsideLhs) ||
+			testSeparatingAxes(rhsVertices, rhsAxisCount, lhsVertices, result.lhsInsideRhs);
+		return result;
+	}
+
+	template <NDimensionalConvexPolygonalObject<2> TPoly1, NDimensionalConvexPolygonalObject<2> TPoly2>
+	[[nodiscard]] constexpr SeparatingAxisResult separatingAxisTest(const TPoly1& lhs, const TPoly2& rhs) noexcept
+	{
+		assert(!isNull(lhs) && !isNull(rhs));
+
+		return separatingAxisTest(collectVertices(lhs), separatingAxisCount(lhs), collectVertices(rhs), separatingAxisCount(rhs));
+	}
+
+	// convex polygons need only O(n + m) projections instead of O(n * m) edge tests; a polygon lying completely inside the other has no intersecting edges
+	template <NDimensionalConvexPolygonalObject<2> TPoly1, NDimensionalConvexPolygonalObject<2> TPoly2>
+	constexpr bool intersectsImpl(const TPoly1& lhs, const TPoly2& rhs) noexcept
+	{
+		auto result = separatingAxisTest(lhs, rhs);
+		return !result.separated && !result.lhsInsideRhs && !result.rhsInsideLhs;
+	}
+
+	template <NDimensionalConvexPolygonalObject<2> TPoly1, NDimensionalConvexPolygonalObject<2> TPoly2, class T>
+	constexpr bool intersectsImpl(const TPoly1& lhs, const AABB_t<T>& lhsBounds, const TPoly2& rhs, const AABB_t<T>& rhsBounds) noexcept
+	{
+		return intersectsBounds(lhsBounds, rhsBounds) && intersectsImpl(lhs, rhs);
+	}
+
 	// try to reverse the params
 	template <class TGeo1, class TGeo2>
 	constexpr bool intersectsImpl(const TGeo1& lhs, const TGeo2& rhs) noexcept
@@ -64,6 +238,64 @@ namespace georithm
 	{
 		return detail::intersectsImpl(lhs, rhs);
 	}
+
+	// the bounds have to be the (normalized) results of boundingRect; use this overload to avoid their recomputation on each call
+	template <NDimensionalPolygonalObject<2> TPoly1, NDimensionalPolygonalObject<2> TPoly2, class T>
+	constexpr bool intersects(const TPoly1& lhs, const AABB_t<T>& lhsBounds, const TPoly2& rhs, const AABB_t<T>& rhsBounds) noexcept
+	{
+		return detail::intersectsImpl(lhs, lhsBounds, rhs, rhsBounds);
+	}
+
+	// the bounds have to be the (normalized) result of boundingRect; use this overload to avoid their recomputation on each call
+	template <NDimensionalLineObject<2> TLine, NDimensionalPolygonalObject<2> TPoly>
+	constexpr bool intersects(const TLine& line, const TPoly& polygon, const AABB_t<typename GeometricTraits<TPoly>::ValueType>& polygonBounds) noexcept
+	{
+		return detail::intersectsImpl(line, polygon, polygonBounds);
+	}
+
+	/* Tests lhs against each object of the range and writes the result to the same index of out. seq calls intersects for each pair, while
+	 * the unsequenced policies reuse the bounds of a polygonal lhs, which are computed once up front, and reject most polygons by their
+	 * bounds alone. Computing them also fills the lazy caches of lhs (see AffineChain and CachedRect), before the threads share it.
+	 */
+	template <ExecutionPolicy TPolicy, NDimensionalObject<2> TGeo, std::ranges::random_access_range TObjects, std::random_access_iterator TOutIterator>
+	requires NDimensionalObject<std::ranges::range_value_t<TObjects>, 2> &&
+	std::output_iterator<TOutIterator, bool> && detail::IsConcurrentlyWritable_v<TPolicy, TOutIterator>
+	TOutIterator intersects(const TPolicy& policy, const TGeo& lhs, const TObjects& objects, TOutIterator out)
+	{
+		using Object_t = std::ranges::range_value_t<TObjects>;
+
+		const auto count = static_cast<std::size_t>(std::ranges::size(objects));
+		if (count == 0)
+			return out;
+
+		if constexpr (NDimensionalPolygonalObject<TGeo, 2>)
+		{
+			const auto lhsBounds = detail::boundingRect(lhs);
+			detail::forEachChunk(policy, count, [&](std::size_t begin, std::size_t end)
+				{
+					auto objectIter = std::ranges::begin(objects);
+					for (auto i = begin; i < end; ++i)
+					{
+						if constexpr (detail::IsUnsequencedPolicy_v<TPolicy> && NDimensionalPolygonalObject<Object_t, 2>)
+							out[i] = detail::intersectsImpl(lhs, lhsBounds, objectIter[i], detail::boundingRect(objectIter[i]));
+						else
+							out[i] = detail::intersectsImpl(lhs, objectIter[i]);
+					}
+				}
+			);
+		}
+		else
+		{
+			detail::forEachChunk(policy, count, [&](std::size_t begin, std::size_t end)
+				{
+					auto objectIter = std::ranges::begin(objects);
+					for (auto i = begin; i < end; ++i)
+						out[i] = detail::intersectsImpl(lhs, objectIter[i]);
+				}
+			);
+		}
+		return out + count;
+	}
 }
 
 #endif
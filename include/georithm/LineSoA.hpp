@@ -0,0 +1,341 @@
+//          Copyright Dominic Koepke 2017 - 2020.
+// Distributed under the Boost Software License, Version 1.0.
+//    (See accompanying file LICENSE_1_0.txt or copy at
+//          https://www.boost.org/LICENSE_1_0.txt)
+
+#ifndef GEORITHM_LINE_SOA_HPP
+#define GEORITHM_LINE_SOA_HPP
+
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cassert>
+#include <concepts>
+#include <cstddef>
+#include <ranges>
+#include <span>
+#include <tuple>
+
+#include "georithm/Concepts.hpp"
+#include "georithm/Defines.hpp"
+#include "georithm/Execution.hpp"
+#include "georithm/GeometricTraits.hpp"
+#include "georithm/Intersection.hpp"
+#include "georithm/Line.hpp"
+#include "georithm/Vector.hpp"
+#include "georithm/VectorSoA.hpp"
+
+namespace georithm
+{
+	/* Stores a collection of 2 dimensional lines of the same type as structure of arrays; locations and directions are held in
+	 * separate VectorSoA containers.
+	 */
+	template <ValueType T, LineType TLineType>
+	class LineSoA
+	{
+	public:
+		using ValueType = T;
+		using VectorType = Vector<T, 2>;
+		using LineObjectType = BasicLine<VectorType, TLineType>;
+		constexpr static LineType type{ TLineType };
+
+		LineSoA() noexcept = default;
+		~LineSoA() noexcept = default;
+
+		template <std::ranges::input_range TRange>
+		requires std::convertible_to<std::ranges::range_value_t<TRange>, LineObjectType>
+		explicit LineSoA(const TRange& lines)
+		{
+			if constexpr (std::ranges::sized_range<TRange>)
+				reserve(std::ranges::size(lines));
+
+			for (const LineObjectType& line : lines)
+				push_back(line);
+		}
+
+		LineSoA(const LineSoA&) = default;
+		LineSoA& operator =(const LineSoA&) = default;
+		LineSoA(LineSoA&&) noexcept = default;
+		LineSoA& operator =(LineSoA&&) noexcept = default;
+
+		[[nodiscard]] bool operator ==(const LineSoA&) const = default;
+
+		[[nodiscard]] std::size_t size() const noexcept
+		{
+			return std::size(m_Locations);
+		}
+
+		[[nodiscard]] bool empty() const noexcept
+		{
+			return std::empty(m_Locations);
+		}
+
+		void resize(std::size_t size)
+		{
+			m_Locations.resize(size);
+			m_Directions.resize(size);
+		}
+
+		void reserve(std::size_t size)
+		{
+			m_Locations.reserve(size);
+			m_Directions.reserve(size);
+		}
+
+		void clear() noexcept
+		{
+			m_Locations.clear();
+			m_Directions.clear();
+		}
+
+		void push_back(const LineObjectType& line)
+		{
+			m_Locations.push_back(line.location());
+			m_Directions.push_back(line.direction());
+		}
+
+		[[nodiscard]] LineObjectType operator [](std::size_t index) const noexcept
+		{
+			return { m_Locations[index], m_Directions[index] };
+		}
+
+		void set(std::size_t index, const LineObjectType& line) noexcept
+		{
+			m_Locations.set(index, line.location());
+			m_Directions.set(index, line.direction());
+		}
+
+		[[nodiscard]] const VectorSoA<T, 2>& locations() const noexcept
+		{
+			return m_Locations;
+		}
+
+		[[nodiscard]] VectorSoA<T, 2>& locations() noexcept
+		{
+			return m_Locations;
+		}
+
+		[[nodiscard]] const VectorSoA<T, 2>& directions() const noexcept
+		{
+			return m_Directions;
+		}
+
+		[[nodiscard]] VectorSoA<T, 2>& directions() noexcept
+		{
+			return m_Directions;
+		}
+
+	private:
+		VectorSoA<T, 2> m_Locations;
+		VectorSoA<T, 2> m_Directions;
+	};
+
+	template <ValueType T>
+	using SegmentSoA = LineSoA<T, LineType::segment>;
+}
+
+namespace georithm::detail
+{
+	static_assert(static_cast<int>(LineIntersectionResult::none) == 0 && static_cast<int>(LineIntersectionResult::intersecting) == 1 &&
+		static_cast<int>(LineIntersectionResult::parallel) == 2 && static_cast<int>(LineIntersectionResult::collinear) == 3,
+		"intersectionBatch composes the results from these values");
+
+	constexpr std::size_t intersectionBlockSize = 64;
+
+	// 1 or 0 in the value type, which lets the mask share the vector lanes with the values
+	template <class T>
+	constexpr T mask(bool condition) noexcept
+	{
+		return condition ? T(1) : T(0);
+	}
+
+	/* Non-negative, if the dist lies within the range of the line type; 1 - dist always has the correct sign. This merges both range
+	 * checks into a single ordered comparison, because the compiler doesn't speculate a second one (it may trap on NaN) and thus
+	 * would have to branch.
+	 */
+	template <LineType TLineType, class T>
+	constexpr T rangeDistance(T dist) noexcept
+	{
+		if constexpr (TLineType == LineType::segment)
+			return std::min(dist, T(1) - dist);
+		else if constexpr (TLineType == LineType::ray)
+			return dist;
+		else
+			return T(1);
+	}
+
+	/* Same computation as intersectionImpl for two lines, but without any branches in the loop body; all conditions are evaluated
+	 * unconditionally and only select between values, while the divisor is replaced for parallel lines. The block is written into local buffers first, which can't alias the
+	 * input lanes, thus the compiler is able to vectorize the loop without any runtime alias checks.
+	 */
+	template <LineType TRhsLineType, NDimensionalLineObject<2> TLine>
+	void intersectionBlock(const TLine& lhs,
+							const typename GeometricTraits<TLine>::ValueType* rhsXs,
+							const typename GeometricTraits<TLine>::ValueType* rhsYs,
+							const typename GeometricTraits<TLine>::ValueType* rhsDirXs,
+							const typename GeometricTraits<TLine>::ValueType* rhsDirYs,
+							std::size_t count,
+							LineIntersectionResult* results,
+							typename GeometricTraits<TLine>::ValueType* lhsDistances,
+							typename GeometricTraits<TLine>::ValueType* rhsDistances
+	) noexcept
+	{
+		using T = typename GeometricTraits<TLine>::ValueType;
+		assert(count <= intersectionBlockSize);
+
+		const auto lhsX = lhs.location().x();
+		const auto lhsY = lhs.location().y();
+		const auto lhsDirX = lhs.direction().x();
+		const auto lhsDirY = lhs.direction().y();
+		std::array<T, intersectionBlockSize> resultBlock;
+		std::array<T, intersectionBlockSize> lhsDistanceBlock;
+		std::array<T, intersectionBlockSize> rhsDistanceBlock;
+		for (std::size_t i = 0; i < count; ++i)
+		{
+			auto localX = lhsX - rhsXs[i];
+			auto localY = lhsY - rhsYs[i];
+			auto denominator = rhsDirYs[i] * lhsDirX - rhsDirXs[i] * lhsDirY;
+			auto numeratorA = rhsDirXs[i] * localY - rhsDirYs[i] * localX;
+			auto numeratorB = lhsDirX * localY - lhsDirY * localX;
+
+			bool parallel = denominator == T(0);
+			bool touching = (numeratorA == T(0)) | (numeratorB == T(0));
+			auto divisor = denominator + mask<T>(parallel);
+			auto lhsDist = numeratorA / divisor;
+			auto rhsDist = numeratorB / divisor;
+			bool withinRange = T(0) <= std::min(rangeDistance<TLine::type>(lhsDist), rangeDistance<TRhsLineType>(rhsDist));
+			bool intersecting = !parallel & withinRange;
+
+			resultBlock[i] = parallel ? (touching ? T(3) : T(2)) : mask<T>(withinRange);
+			lhsDistanceBlock[i] = intersecting ? lhsDist : T(0);
+			rhsDistanceBlock[i] = intersecting ? rhsDist : T(0);
+		}
+
+		for (std::size_t i = 0; i < count; ++i)
+			results[i] = static_cast<LineIntersectionResult>(static_cast<int>(resultBlock[i]));
+		std::copy_n(std::begin(lhsDistanceBlock), count, lhsDistances);
+		std::copy_n(std::begin(rhsDistanceBlock), count, rhsDistances);
+	}
+
+	// the single intersection for each line of [begin, end)
+	template <LineType TRhsLineType, NDimensionalLineObject<2> TLine>
+	void intersectionSequenced(const TLine& lhs,
+								const LineSoA<typename GeometricTraits<TLine>::ValueType, TRhsLineType>& rhs,
+								std::size_t begin,
+								std::size_t end,
+								LineIntersectionResult* results,
+								typename GeometricTraits<TLine>::ValueType* lhsDistances,
+								typename GeometricTraits<TLine>::ValueType* rhsDistances
+	) noexcept
+	{
+		for (auto i = begin; i < end; ++i)
+			std::tie(results[i], lhsDistances[i], rhsDistances[i]) = intersectionImpl(lhs, rhs[i]);
+	}
+
+	// intersects lhs with the lines [begin, end) of rhs; the outputs are indexed as rhs
+	template <LineType TRhsLineType, NDimensionalLineObject<2> TLine>
+	void intersectionBatch(const TLine& lhs,
+							const LineSoA<typename GeometricTraits<TLine>::ValueType, TRhsLineType>& rhs,
+							std::size_t begin,
+							std::size_t end,
+							LineIntersectionResult* results,
+							typename GeometricTraits<TLine>::ValueType* lhsDistances,
+							typename GeometricTraits<TLine>::ValueType* rhsDistances
+	) noexcept
+	{
+		assert(!isNull(lhs) && begin <= end && end <= std::size(rhs));
+
+		using T = typename GeometricTraits<TLine>::ValueType;
+		// integer divisions have no vector instructions, thus skipping them in the branches of the single test is cheaper
+		if constexpr (std::integral<T>)
+		{
+			intersectionSequenced(lhs, rhs, begin, end, results, lhsDistances, rhsDistances);
+			return;
+		}
+
+		const auto* rhsXs = std::data(rhs.locations().lane(0));
+		const auto* rhsYs = std::data(rhs.locations().lane(1));
+		const auto* rhsDirXs = std::data(rhs.directions().lane(0));
+		const auto* rhsDirYs = std::data(rhs.directions().lane(1));
+		for (auto i = begin; i < end; i += intersectionBlockSize)
+		{
+			intersectionBlock<TRhsLineType>(lhs,
+											rhsXs + i,
+											rhsYs + i,
+											rhsDirXs + i,
+											rhsDirYs + i,
+											std::min(intersectionBlockSize, end - i),
+											results + i,
+											lhsDistances + i,
+											rhsDistances + i
+			);
+		}
+	}
+}
+
+namespace georithm
+{
+	/* Intersects the line with each line of the batch. As for the single intersection, the results and both distances are written
+	 * to the index of the batch line; the distances are 0 if the lines don't intersect.
+	 */
+	template <NDimensionalLineObject<2> TLine, LineType TLineType>
+	void intersection(const TLine& line,
+					const LineSoA<typename GeometricTraits<TLine>::ValueType, TLineType>& lines,
+					std::span<LineIntersectionResult> results,
+					std::span<typename GeometricTraits<TLine>::ValueType> lineDistances,
+					std::span<typename GeometricTraits<TLine>::ValueType> batchDistances
+	) noexcept
+	{
+		assert(std::size(results) == std::size(lines) && std::size(lineDistances) == std::size(lines) && std::size(batchDistances) == std::size(lines));
+
+		detail::intersectionBatch(line, lines, 0, std::size(lines), std::data(results), std::data(lineDistances), std::data(batchDistances));
+	}
+
+	/* Same as above, but seq intersects the lines one by one as the single intersection does, while the unsequenced policies run the
+	 * branchless batch kernel; the parallel policies split the batch into chunks. All policies yield the same results.
+	 */
+	template <ExecutionPolicy TPolicy, NDimensionalLineObject<2> TLine, LineType TLineType>
+	void intersection(const TPolicy& policy,
+					const TLine& line,
+					const LineSoA<typename GeometricTraits<TLine>::ValueType, TLineType>& lines,
+					std::span<LineIntersectionResult> results,
+					std::span<typename GeometricTraits<TLine>::ValueType> lineDistances,
+					std::span<typename GeometricTraits<TLine>::ValueType> batchDistances
+	)
+	{
+		assert(std::size(results) == std::size(lines) && std::size(lineDistances) == std::size(lines) && std::size(batchDistances) == std::size(lines));
+
+		detail::forEachChunk(policy, std::size(lines), [&](std::size_t begin, std::size_t end)
+			{
+				if constexpr (detail::IsUnsequencedPolicy_v<TPolicy>)
+					detail::intersectionBatch(line, lines, begin, end, std::data(results), std::data(lineDistances), std::data(batchDistances));
+				else
+					detail::intersectionSequenced(line, lines, begin, end, std::data(results), std::data(lineDistances), std::data(batchDistances));
+			}
+		);
+	}
+
+	/* Intersects each pair of both batches. The result of lhs[i] and rhs[j] is stored at index i * size(rhs) + j, thus the
+	 * output spans must be able to hold size(lhs) * size(rhs) elements.
+	 */
+	template <class T, LineType TLhsLineType, LineType TRhsLineType>
+	void intersection(const LineSoA<T, TLhsLineType>& lhs,
+					const LineSoA<T, TRhsLineType>& rhs,
+					std::span<LineIntersectionResult> results,
+					std::span<T> lhsDistances,
+					std::span<T> rhsDistances
+	) noexcept
+	{
+		const auto rhsCount = std::size(rhs);
+		assert(std::size(results) == std::size(lhs) * rhsCount && std::size(lhsDistances) == std::size(results) && std::size(rhsDistances) == std::size(results));
+
+		for (std::size_t i = 0; i < std::size(lhs); ++i)
+		{
+			auto offset = i * rhsCount;
+			detail::intersectionBatch(lhs[i], rhs, 0, rhsCount, std::data(results) + offset, std::data(lhsDistances) + offset, std::data(rhsDistances) + offset);
+		}
+	}
+}
+
+#endif
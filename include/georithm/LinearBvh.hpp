@@ -0,0 +1,270 @@
+//          Copyright Dominic Koepke 2017 - 2020.
+// Distributed under the Boost Software License, Version 1.0.
+//    (See accompanying file LICENSE_1_0.txt or copy at
+//          https://www.boost.org/LICENSE_1_0.txt)
+
+#ifndef GEORITHM_LINEAR_BVH_HPP
+#define GEORITHM_LINEAR_BVH_HPP
+
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <bit>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <limits>
+#include <ranges>
+#include <utility>
+#include <vector>
+
+#include "georithm/Bounding.hpp"
+#include "georithm/Bvh.hpp"
+#include "georithm/Concepts.hpp"
+#include "georithm/Executor.hpp"
+#include "georithm/GeometricTraits.hpp"
+#include "georithm/Rect.hpp"
+#include "georithm/ThreadPool.hpp"
+#include "georithm/Utility.hpp"
+
+namespace georithm::detail
+{
+	constexpr std::size_t bvhGrainSize = 1 << 14;
+
+	[[nodiscard]] inline std::size_t chunkCountOf(std::size_t count, const Executor& executor) noexcept
+	{
+		return std::clamp<std::size_t>((count + bvhGrainSize - 1) / bvhGrainSize, 1, 4 * executor.concurrency());
+	}
+
+	/* Parallel LSD radix sort by 8 bit digits, which carries the values along; equal codes keep their order. Each chunk counts its
+	 * digits first; the exclusive prefix sum over all digits and chunks then yields the scatter position of each chunk and digit.
+	 * Passes, whose digit is equal for all codes, are skipped.
+	 */
+	inline void radixSort(std::vector<std::uint32_t>& codes, std::vector<std::uint32_t>& values, Executor& executor)
+	{
+		assert(std::size(codes) == std::size(values));
+
+		constexpr std::size_t radix = 256;
+		auto count = std::size(codes);
+		auto chunkCount = chunkCountOf(count, executor);
+		auto chunkSize = (count + chunkCount - 1) / chunkCount;
+		std::vector<std::array<std::size_t, radix>> offsets(chunkCount);
+		std::vector<std::uint32_t> codeBuffer(count);
+		std::vector<std::uint32_t> valueBuffer(count);
+		for (std::uint32_t shift = 0; shift < 32; shift += 8)
+		{
+			executor.parallelFor(chunkCount, 1, [&](std::size_t chunk, std::size_t)
+				{
+					auto& histogram = offsets[chunk];
+					histogram.fill(0);
+					for (std::size_t i = chunk * chunkSize, end = std::min(i + chunkSize, count); i < end; ++i)
+						++histogram[(codes[i] >> shift) & (radix - 1)];
+				}
+			);
+
+			std::size_t offset = 0;
+			bool isSorted = false;
+			for (std::size_t digit = 0; digit < radix; ++digit)
+			{
+				auto digitBegin = offset;
+				for (auto& histogram : offsets)
+					offset += std::exchange(histogram[digit], offset);
+				isSorted |= offset - digitBegin == count;
+			}
+			if (isSorted)
+				continue;
+
+			executor.parallelFor(chunkCount, 1, [&](std::size_t chunk, std::size_t)
+				{
+					auto& chunkOffsets = offsets[chunk];
+					for (std::size_t i = chunk * chunkSize, end = std::min(i + chunkSize, count); i < end; ++i)
+					{
+						auto position = chunkOffsets[(codes[i] >> shift) & (radix - 1)]++;
+						codeBuffer[position] = codes[i];
+						valueBuffer[position] = values[i];
+					}
+				}
+			);
+			std::swap(codes, codeBuffer);
+			std::swap(values, valueBuffer);
+		}
+	}
+
+	/* Length of the common prefix of the sorted codes at i and j, or -1 if j is out of range. The position is appended to each code,
+	 * thus equal codes still have distinct keys.
+	 */
+	[[nodiscard]] inline int commonPrefix(const std::vector<std::uint32_t>& codes, std::int64_t i, std::int64_t j) noexcept
+	{
+		if (j < 0 || std::ssize(codes) <= j)
+			return -1;
+		auto lhs = static_cast<std::uint64_t>(codes[i]) << 32 | static_cast<std::uint64_t>(i);
+		auto rhs = static_cast<std::uint64_t>(codes[j]) << 32 | static_cast<std::uint64_t>(j);
+		return std::countl_zero(lhs ^ rhs);
+	}
+
+	/* Determines the range of leafs covered by inner node i and the position, where that range splits into both children
+	 * (see "Maximizing Parallelism in the Construction of BVHs, Octrees, and k-d Trees" by Tero Karras). Returns the first and last
+	 * leaf of the range and the split, which is the last leaf of the first child.
+	 */
+	[[nodiscard]] inline std::array<std::int64_t, 3> karrasRange(const std::vector<std::uint32_t>& codes, std::int64_t i) noexcept
+	{
+		auto direction = commonPrefix(codes, i, i + 1) < commonPrefix(codes, i, i - 1) ? -1 : 1;
+
+		// the range extends into direction, as long as the prefix is longer than the one with the other neighbour
+		auto minPrefix = commonPrefix(codes, i, i - direction);
+		std::int64_t maxLength = 2;
+		while (minPrefix < commonPrefix(codes, i, i + maxLength * direction))
+			maxLength *= 2;
+		std::int64_t length = 0;
+		for (auto step = maxLength / 2; 0 < step; step /= 2)
+		{
+			if (minPrefix < commonPrefix(codes, i, i + (length + step) * direction))
+				length += step;
+		}
+		auto j = i + length * direction;
+
+		// the split is the last position, which still shares more than the prefix of the whole range with i
+		auto nodePrefix = commonPrefix(codes, i, j);
+		std::int64_t split = 0;
+		for (std::int64_t divisor = 2, step = (length + 1) / 2; ; divisor *= 2, step = (length + divisor - 1) / divisor)
+		{
+			if (nodePrefix < commonPrefix(codes, i, i + (split + step) * direction))
+				split += step;
+			if (step <= 1)
+				break;
+		}
+		auto gamma = i + split * direction + std::min(direction, 0);
+		return { std::min(i, j), std::max(i, j), gamma };
+	}
+}
+
+namespace georithm
+{
+	/* Builds a linear BVH (LBVH) over the bounding rects of objects. The centres of the bounds are mapped to 32 bit morton codes,
+	 * which are radix sorted; each leaf holds a single object and the inner nodes are emitted independently of each other by the
+	 * construction of Karras. Finally the bounds are propagated bottom up, where the second thread arriving at a node computes its
+	 * bounds. Every stage runs in parallel on executor, thus the build scales with the core count and is fast enough to rebuild the
+	 * hierarchy of dynamic scenes from scratch. The node quality is lower than the one of the binned SAH builder, though.
+	 */
+	template <std::ranges::random_access_range TObjects>
+	requires BoundedObject<std::ranges::range_value_t<TObjects>>
+	[[nodiscard]] Bvh<typename GeometricTraits<std::ranges::range_value_t<TObjects>>::ValueType> buildLinearBvh(const TObjects& objects,
+																											Executor& executor = defaultExecutor())
+	{
+		using T = typename GeometricTraits<std::ranges::range_value_t<TObjects>>::ValueType;
+		using Bvh_t = Bvh<T>;
+		using Node_t = typename Bvh_t::NodeType;
+		using Index_t = typename Bvh_t::IndexType;
+		using Bounds_t = typename Bvh_t::AABBType;
+
+		auto count = static_cast<std::size_t>(std::ranges::size(objects));
+		if (count == 0)
+			return {};
+		assert(count < std::numeric_limits<Index_t>::max() / 2);
+
+		// bounds of the objects and of their centres, which become the domain of the morton codes
+		auto chunkCount = detail::chunkCountOf(count, executor);
+		auto chunkSize = (count + chunkCount - 1) / chunkCount;
+		std::vector<Bounds_t> objectBounds(count);
+		auto centreOf = [&](std::size_t i)
+		{
+			auto& bounds = objectBounds[i];
+			return std::array{
+				static_cast<double>(bounds.position().x()) + static_cast<double>(bounds.span().x()) / 2,
+				static_cast<double>(bounds.position().y()) + static_cast<double>(bounds.span().y()) / 2
+			};
+		};
+		using CentreBounds_t = std::array<double, 4>;
+		constexpr auto max = std::numeric_limits<double>::max();
+		auto domain = executor.parallelReduce(chunkCount, 1, CentreBounds_t{ max, max, -max, -max }, [&](std::size_t chunk, std::size_t)
+			{
+				CentreBounds_t bounds{ max, max, -max, -max };
+				for (std::size_t i = chunk * chunkSize, end = std::min(i + chunkSize, count); i < end; ++i)
+				{
+					objectBounds[i] = boundingRect(std::ranges::begin(objects)[i]);
+					auto [x, y] = centreOf(i);
+					bounds = { std::min(bounds[0], x), std::min(bounds[1], y), std::max(bounds[2], x), std::max(bounds[3], y) };
+				}
+				return bounds;
+			},
+			[](const CentreBounds_t& lhs, const CentreBounds_t& rhs)
+			{
+				return CentreBounds_t{ std::min(lhs[0], rhs[0]), std::min(lhs[1], rhs[1]), std::max(lhs[2], rhs[2]), std::max(lhs[3], rhs[3]) };
+			}
+		);
+
+		constexpr double maxCell = (1u << 16) - 1;
+		auto scaleX = domain[2] == domain[0] ? 0. : maxCell / (domain[2] - domain[0]);
+		auto scaleY = domain[3] == domain[1] ? 0. : maxCell / (domain[3] - domain[1]);
+		std::vector<std::uint32_t> codes(count);
+		std::vector<std::uint32_t> objectIndices(count);
+		executor.parallelFor(count, detail::bvhGrainSize, [&](std::size_t begin, std::size_t end)
+			{
+				for (auto i = begin; i < end; ++i)
+				{
+					auto [x, y] = centreOf(i);
+					auto cellX = static_cast<std::uint32_t>((x - domain[0]) * scaleX);
+					auto cellY = static_cast<std::uint32_t>((y - domain[1]) * scaleY);
+					codes[i] = detail::interleaveBits(cellX) | detail::interleaveBits(cellY) << 1;
+					objectIndices[i] = static_cast<Index_t>(i);
+				}
+			}
+		);
+		detail::radixSort(codes, objectIndices, executor);
+
+		// inner nodes occupy [0, count - 1) with the root at 0, followed by the leafs in order of their codes
+		auto leafOffset = count - 1;
+		std::vector<Node_t> nodes(2 * count - 1);
+		std::vector<Bounds_t> sortedBounds(count);
+		executor.parallelFor(count, detail::bvhGrainSize, [&](std::size_t begin, std::size_t end)
+			{
+				for (auto i = begin; i < end; ++i)
+				{
+					auto& leaf = nodes[leafOffset + i];
+					leaf.bounds = sortedBounds[i] = objectBounds[objectIndices[i]];
+					leaf.child1 = static_cast<Index_t>(i);
+					leaf.objectCount = 1;
+				}
+			}
+		);
+		executor.parallelFor(count - 1, detail::bvhGrainSize, [&](std::size_t begin, std::size_t end)
+			{
+				for (auto i = begin; i < end; ++i)
+				{
+					auto [first, last, split] = detail::karrasRange(codes, static_cast<std::int64_t>(i));
+					auto child1 = static_cast<Index_t>(first == split ? leafOffset + split : split);
+					auto child2 = static_cast<Index_t>(last == split + 1 ? leafOffset + split + 1 : split + 1);
+					auto& node = nodes[i];
+					node.child1 = child1;
+					node.child2 = child2;
+					nodes[child1].parent = static_cast<Index_t>(i);
+					nodes[child2].parent = static_cast<Index_t>(i);
+				}
+			}
+		);
+
+		std::vector<std::atomic<std::uint32_t>> arrivals(count - 1);
+		executor.parallelFor(count, detail::bvhGrainSize, [&](std::size_t begin, std::size_t end)
+			{
+				for (auto i = begin; i < end; ++i)
+				{
+					for (auto index = nodes[leafOffset + i].parent; index != Node_t::nullIndex; index = nodes[index].parent)
+					{
+						// the first arriving thread stops, because the bounds of the other child may still be missing
+						if (arrivals[index].fetch_add(1, std::memory_order_acq_rel) == 0)
+							break;
+						auto& node = nodes[index];
+						node.bounds = detail::boundingRect(nodes[node.child1].bounds, nodes[node.child2].bounds);
+					}
+				}
+			}
+		);
+
+		return { std::move(nodes), std::move(objectIndices), std::move(sortedBounds) };
+	}
+}
+
+#endif
@@ -9,19 +9,154 @@
 #pragma once
 
 #include <cassert>
+#include <cstddef>
+#include <iterator>
+#include <ranges>
+#include <span>
+#include <type_traits>
 
+#include "georithm/Bounding.hpp"
 #include "georithm/Concepts.hpp"
-#include "georithm/Intersects.hpp"
 #include "georithm/Contains.hpp"
+#include "georithm/Execution.hpp"
+#include "georithm/GeometricTraits.hpp"
+#include "georithm/Intersects.hpp"
+#include "georithm/Line.hpp"
+#include "georithm/Utility.hpp"
 
 namespace georithm::detail
 {
+	template <class TVertices>
+	[[nodiscard]] constexpr auto boundingRectOfVertices(const TVertices& vertices) noexcept
+	{
+		using Vector_t = std::remove_cvref_t<decltype(vertices[0])>;
+		return detail::boundingRect(std::span<const Vector_t>{ std::data(vertices), std::size(vertices) });
+	}
+
+	// same as the generic contains overload, but on already collected vertices
+	template <class TVertices, NDimensionalVectorObject<2> TVector>
+	[[nodiscard]] constexpr bool containsByWinding(const TVertices& vertices, const TVector& point) noexcept
+	{
+		auto count = std::size(vertices);
+		int winding = 0;
+		for (std::size_t i = 0; i < count; ++i)
+		{
+			auto& first = vertices[i];
+			if (accumulateWinding(first, vertices[(i + 1) % count] - first, point, winding))
+				return true;
+		}
+		return winding != 0;
+	}
+
+	// lhs edges, whose bounds don't touch the rhs bounds, are skipped before they are tested against each rhs edge
+	template <class TVertices1, class TVertices2, class T>
+	[[nodiscard]] constexpr bool intersectsByEdges(const TVertices1& lhsVertices, const TVertices2& rhsVertices, const AABB_t<T>& rhsBounds) noexcept
+	{
+		using Vector_t = std::remove_cvref_t<decltype(lhsVertices[0])>;
+		auto lhsCount = std::size(lhsVertices);
+		auto rhsCount = std::size(rhsVertices);
+		for (std::size_t i = 0; i < lhsCount; ++i)
+		{
+			auto& first = lhsVertices[i];
+			auto& second = lhsVertices[(i + 1) % lhsCount];
+			if (!intersectsBounds(detail::boundingRect(first, second), rhsBounds))
+				continue;
+
+			Segment<Vector_t> lhsEdge{ first, second - first };
+			for (std::size_t j = 0; j < rhsCount; ++j)
+			{
+				auto& rhsFirst = rhsVertices[j];
+				if (intersectsImpl(lhsEdge, Segment<Vector_t>{ rhsFirst, rhsVertices[(j + 1) % rhsCount] - rhsFirst }))
+					return true;
+			}
+		}
+		return false;
+	}
+
+	/* If no edges intersect, the polygons are either disjoint or one of them lies completely inside the other one. In the latter
+	 * case every vertex of the inner polygon is contained by the outer one, thus testing a single vertex of each is sufficient.
+	 */
+	template <class TVertices1, class TVertices2, class T>
+	[[nodiscard]] constexpr bool overlapsVertices(const TVertices1& lhsVertices, const TVertices2& rhsVertices, const AABB_t<T>& rhsBounds) noexcept
+	{
+		return intersectsByEdges(lhsVertices, rhsVertices, rhsBounds) ||
+			containsByWinding(rhsVertices, lhsVertices[0]) ||
+			containsByWinding(lhsVertices, rhsVertices[0]);
+	}
+
+	// fallback for objects, which aren't handled by the fused overloads below
 	template <NDimensionalObject<2> TGeo1, NDimensionalObject<2> TGeo2>
 	constexpr bool overlaps(const TGeo1& lhs, const TGeo2& rhs) noexcept
 	{
 		assert(!isNull(lhs) && !isNull(rhs));
 		return intersects(lhs, rhs) || contains(lhs, rhs) || contains(rhs, lhs);
 	}
+
+	/* Each vertex is computed only once and shared by the bounds, the edge tests and the containment tests. Disjoint polygons are
+	 * usually already rejected by their bounds.
+	 */
+	template <NDimensionalPolygonalObject<2> TPoly1, NDimensionalPolygonalObject<2> TPoly2>
+	constexpr bool overlaps(const TPoly1& lhs, const TPoly2& rhs) noexcept
+	{
+		assert(!isNull(lhs) && !isNull(rhs));
+
+		auto lhsVertices = collectVertices(lhs);
+		auto rhsVertices = collectVertices(rhs);
+		auto rhsBounds = boundingRectOfVertices(rhsVertices);
+		return intersectsBounds(boundingRectOfVertices(lhsVertices), rhsBounds) && overlapsVertices(lhsVertices, rhsVertices, rhsBounds);
+	}
+
+	template <NDimensionalPolygonalObject<2> TPoly1, NDimensionalPolygonalObject<2> TPoly2, class T>
+	constexpr bool overlaps(const TPoly1& lhs, const AABB_t<T>& lhsBounds, const TPoly2& rhs, const AABB_t<T>& rhsBounds) noexcept
+	{
+		assert(!isNull(lhs) && !isNull(rhs));
+		return intersectsBounds(lhsBounds, rhsBounds) && overlapsVertices(collectVertices(lhs), collectVertices(rhs), rhsBounds);
+	}
+
+	// a single SAT pass covers intersection and containment of convex polygons, because only a separating axis proves their disjointness
+	template <NDimensionalConvexPolygonalObject<2> TPoly1, NDimensionalConvexPolygonalObject<2> TPoly2>
+	constexpr bool overlaps(const TPoly1& lhs, const TPoly2& rhs) noexcept
+	{
+		assert(!isNull(lhs) && !isNull(rhs));
+
+		auto lhsVertices = collectVertices(lhs);
+		auto rhsVertices = collectVertices(rhs);
+		return intersectsBounds(boundingRectOfVertices(lhsVertices), boundingRectOfVertices(rhsVertices)) &&
+			!separatingAxisTest(lhsVertices, separatingAxisCount(lhs), rhsVertices, separatingAxisCount(rhs)).separated;
+	}
+
+	template <NDimensionalConvexPolygonalObject<2> TPoly1, NDimensionalConvexPolygonalObject<2> TPoly2, class T>
+	constexpr bool overlaps(const TPoly1& lhs, const AABB_t<T>& lhsBounds, const TPoly2& rhs, const AABB_t<T>& rhsBounds) noexcept
+	{
+		assert(!isNull(lhs) && !isNull(rhs));
+		return intersectsBounds(lhsBounds, rhsBounds) && !separatingAxisTest(lhs, rhs).separated;
+	}
+
+	template <class T>
+	constexpr bool overlaps(const AABB_t<T>& lhs, const AABB_t<T>& rhs) noexcept
+	{
+		assert(!isNull(lhs) && !isNull(rhs));
+		return intersectsBounds(detail::boundingRect(lhs), detail::boundingRect(rhs));
+	}
+
+	/* Same as overlaps(lhs, rhs) for polygons, but on the already collected vertices and bounds of lhs, thus the range overload
+	 * computes them only once for all rhs polygons.
+	 */
+	template <NDimensionalPolygonalObject<2> TPoly1, class TVertices1, class T, NDimensionalPolygonalObject<2> TPoly2>
+	constexpr bool overlapsPrepared(const TPoly1& lhs, const TVertices1& lhsVertices, const AABB_t<T>& lhsBounds, const TPoly2& rhs) noexcept
+	{
+		assert(!isNull(lhs) && !isNull(rhs));
+
+		auto rhsVertices = collectVertices(rhs);
+		auto rhsBounds = boundingRectOfVertices(rhsVertices);
+		if (!intersectsBounds(lhsBounds, rhsBounds))
+			return false;
+
+		if constexpr (NDimensionalConvexPolygonalObject<TPoly1, 2> && NDimensionalConvexPolygonalObject<TPoly2, 2>)
+			return !separatingAxisTest(lhsVertices, separatingAxisCount(lhs), rhsVertices, separatingAxisCount(rhs)).separated;
+		else
+			return overlapsVertices(lhsVertices, rhsVertices, rhsBounds);
+	}
 }
 
 namespace georithm
@@ -31,6 +166,58 @@ namespace georithm
 	{
 		return detail::overlaps(lhs, rhs);
 	}
+
+	// the bounds have to be the (normalized) results of boundingRect; use this overload to avoid their recomputation on each call
+	template <NDimensionalPolygonalObject<2> TPoly1, NDimensionalPolygonalObject<2> TPoly2, class T>
+	[[nodiscard]] constexpr bool overlaps(const TPoly1& lhs, const AABB_t<T>& lhsBounds, const TPoly2& rhs, const AABB_t<T>& rhsBounds) noexcept
+	{
+		return detail::overlaps(lhs, lhsBounds, rhs, rhsBounds);
+	}
+
+	/* Tests lhs against each object of the range and writes the result to the same index of out. seq calls overlaps for each pair, while
+	 * the unsequenced policies reuse the vertices and bounds of a polygonal lhs, which are collected once up front. Collecting them also
+	 * fills the lazy caches of lhs (see AffineChain and CachedRect), before the threads share it.
+	 */
+	template <ExecutionPolicy TPolicy, NDimensionalObject<2> TGeo, std::ranges::random_access_range TObjects, std::random_access_iterator TOutIterator>
+	requires NDimensionalObject<std::ranges::range_value_t<TObjects>, 2> &&
+	std::output_iterator<TOutIterator, bool> && detail::IsConcurrentlyWritable_v<TPolicy, TOutIterator>
+	TOutIterator overlaps(const TPolicy& policy, const TGeo& lhs, const TObjects& objects, TOutIterator out)
+	{
+		using Object_t = std::ranges::range_value_t<TObjects>;
+
+		const auto count = static_cast<std::size_t>(std::ranges::size(objects));
+		if (count == 0)
+			return out;
+
+		if constexpr (NDimensionalPolygonalObject<TGeo, 2>)
+		{
+			const auto lhsVertices = detail::collectVertices(lhs);
+			const auto lhsBounds = detail::boundingRectOfVertices(lhsVertices);
+			detail::forEachChunk(policy, count, [&](std::size_t begin, std::size_t end)
+				{
+					auto objectIter = std::ranges::begin(objects);
+					for (auto i = begin; i < end; ++i)
+					{
+						if constexpr (detail::IsUnsequencedPolicy_v<TPolicy> && NDimensionalPolygonalObject<Object_t, 2>)
+							out[i] = detail::overlapsPrepared(lhs, lhsVertices, lhsBounds, objectIter[i]);
+						else
+							out[i] = detail::overlaps(lhs, objectIter[i]);
+					}
+				}
+			);
+		}
+		else
+		{
+			detail::forEachChunk(policy, count, [&](std::size_t begin, std::size_t end)
+				{
+					auto objectIter = std::ranges::begin(objects);
+					for (auto i = begin; i < end; ++i)
+						out[i] = detail::overlaps(lhs, objectIter[i]);
+				}
+			);
+		}
+		return out + count;
+	}
 }
 
 #endif
@@ -0,0 +1,432 @@
+//          Copyright Dominic Koepke 2017 - 2020.
+// Distributed under the Boost Software License, Version 1.0.
+//    (See accompanying file LICENSE_1_0.txt or copy at
+//          https://www.boost.org/LICENSE_1_0.txt)
+
+#ifndef GEORITHM_PACKED_R_TREE_HPP
+#define GEORITHM_PACKED_R_TREE_HPP
+
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cassert>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <numeric>
+#include <ranges>
+#include <span>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "georithm/Bounding.hpp"
+#include "georithm/Concepts.hpp"
+#include "georithm/GeometricTraits.hpp"
+#include "georithm/Intersection.hpp"
+#include "georithm/Intersects.hpp"
+#include "georithm/Overlaps.hpp"
+#include "georithm/Rect.hpp"
+#include "georithm/Utility.hpp"
+#include "georithm/Vector.hpp"
+
+namespace georithm::detail
+{
+	constexpr std::uint32_t hilbertOrder = 16;
+
+	/* Distance of the cell (x, y) along the hilbert curve, which fills a grid of 2^hilbertOrder cells per dimension. Instead of
+	 * descending the curve bit by bit, the orientation of all levels is computed at once as parallel prefix over the bits, which
+	 * avoids any branches (see "Fast Hilbert curve generation" by rawrunprotected).
+	 */
+	[[nodiscard]] constexpr std::uint32_t hilbertIndex(std::uint32_t x, std::uint32_t y) noexcept
+	{
+		constexpr std::uint32_t mask = (1u << hilbertOrder) - 1;
+		assert(x <= mask && y <= mask);
+
+		auto a = x ^ y;
+		auto b = mask ^ a;
+		auto c = mask ^ (x | y);
+		auto d = x & (y ^ mask);
+
+		auto A = a | (b >> 1);
+		auto B = (a >> 1) ^ a;
+		auto C = ((c >> 1) ^ (b & (d >> 1))) ^ c;
+		auto D = ((a & (c >> 1)) ^ (d >> 1)) ^ d;
+
+		for (std::uint32_t shift = 2; shift <= 4; shift *= 2)
+		{
+			a = A;
+			b = B;
+			c = C;
+			d = D;
+			A = (a & (a >> shift)) ^ (b & (b >> shift));
+			B = (a & (b >> shift)) ^ (b & ((a ^ b) >> shift));
+			C ^= (a & (c >> shift)) ^ (b & (d >> shift));
+			D ^= (b & (c >> shift)) ^ ((a ^ b) & (d >> shift));
+		}
+
+		a = A;
+		b = B;
+		c = C;
+		d = D;
+		C ^= (a & (c >> 8)) ^ (b & (d >> 8));
+		D ^= (b & (c >> 8)) ^ ((a ^ b) & (d >> 8));
+
+		a = C ^ (C >> 1);
+		b = D ^ (D >> 1);
+		auto i0 = x ^ y;
+		auto i1 = b | (mask ^ (i0 | a));
+		return (interleaveBits(i1) << 1) | interleaveBits(i0);
+	}
+}
+
+namespace georithm
+{
+	/* Non-owning, read only view of the flat arrays of a PackedRTree, which provides all queries. Views either refer to a PackedRTree
+	 * or to memory, which holds a serialized tree (e.g. a memory mapped file; see PackedRTreeFormat.hpp); the viewed memory must
+	 * outlive the view.
+	 * The bounds array begins with the leafs and ends with the root; the indices hold the object index for leafs and the position of
+	 * the first child otherwise. levelEnds holds the end position of each level, beginning with the leafs.
+	 */
+	template <class T, std::size_t NodeSize = 16>
+	requires (2 <= NodeSize)
+	class PackedRTreeView
+	{
+	public:
+		using ValueType = T;
+		using AABBType = AABB_t<T>;
+		using IndexType = std::uint32_t;
+		constexpr static std::size_t nodeSize = NodeSize;
+
+		constexpr PackedRTreeView() noexcept = default;
+
+		constexpr PackedRTreeView(std::span<const AABBType> nodeBounds, std::span<const IndexType> nodeIndices, std::span<const IndexType> levelEnds) noexcept :
+			m_Bounds{ nodeBounds },
+			m_Indices{ nodeIndices },
+			m_LevelEnds{ levelEnds }
+		{
+			assert(std::size(m_Bounds) == std::size(m_Indices));
+			assert(std::empty(m_LevelEnds) || m_LevelEnds.back() == std::size(m_Bounds));
+		}
+
+		[[nodiscard]] std::size_t size() const noexcept
+		{
+			return std::empty(m_LevelEnds) ? 0 : m_LevelEnds.front();
+		}
+
+		[[nodiscard]] bool empty() const noexcept
+		{
+			return std::empty(m_LevelEnds);
+		}
+
+		// bounds of the root node; must not be called on empty trees
+		[[nodiscard]] const AABBType& bounds() const noexcept
+		{
+			assert(!empty());
+			return m_Bounds.back();
+		}
+
+		// leafs count as level 0
+		[[nodiscard]] std::size_t levelCount() const noexcept
+		{
+			return std::size(m_LevelEnds);
+		}
+
+		[[nodiscard]] std::span<const AABBType> nodeBounds() const noexcept
+		{
+			return m_Bounds;
+		}
+
+		[[nodiscard]] std::span<const IndexType> nodeIndices() const noexcept
+		{
+			return m_Indices;
+		}
+
+		[[nodiscard]] std::span<const IndexType> levelEnds() const noexcept
+		{
+			return m_LevelEnds;
+		}
+
+		/* Invokes callback(index) for each object, whose bounds intersect (or touch) the bounding rect of object.
+		 * If callback returns false, the query stops early.
+		 */
+		template <BoundedObject<T> TObject, class TCallback>
+		requires std::invocable<TCallback&, std::size_t>
+		void query(const TObject& object, TCallback callback) const
+		{
+			auto queryBounds = detail::boundingRectAs<T>(object);
+			traverse([&](const AABBType& bounds) { return detail::intersectsBounds(bounds, queryBounds); }, callback);
+		}
+
+		/* Invokes callback(index) for each object, whose bounds contain point.
+		 * If callback returns false, the query stops early.
+		 */
+		template <NDimensionalVectorObject<2> TVector, class TCallback>
+		requires std::is_same_v<typename TVector::ValueType, T> && std::invocable<TCallback&, std::size_t>
+		void queryPoint(const TVector& point, TCallback callback) const
+		{
+			AABBType pointBounds{ { point.x(), point.y() }, { T{}, T{} } };
+			traverse([&](const AABBType& bounds) { return detail::intersectsBounds(bounds, pointBounds); }, callback);
+		}
+
+		/* Invokes callback(index) for each geometry, which overlaps object. Only geometries, whose bounds intersect the bounding rect
+		 * of object, are tested at all. If callback returns false, the query stops early.
+		 */
+		template <std::ranges::random_access_range TGeometries, NDimensionalObject<2> TObject, class TCallback>
+		requires NDimensionalObject<std::ranges::range_value_t<TGeometries>, 2> && std::invocable<TCallback&, std::size_t>
+		void queryOverlapping(const TGeometries& geometries, const TObject& object, TCallback callback) const
+		{
+			assert(std::ranges::size(geometries) == size());
+
+			auto queryBounds = detail::boundingRectAs<T>(object);
+			auto filteredCallback = [&](std::size_t index)
+			{
+				return !overlaps(std::ranges::begin(geometries)[index], object) || detail::invokeTraversalCallback(callback, index);
+			};
+			traverse([&](const AABBType& bounds) { return detail::intersectsBounds(bounds, queryBounds); }, filteredCallback);
+		}
+
+		/* Invokes callback(index, lineDist) for each polygonal geometry, which gets hit by line; lineDist is the same as the result of
+		 * intersection(line, geometry). Nodes are pruned by the conservative line bounds test, thus only geometries near the line are
+		 * tested at all. The geometries aren't visited in order of their distance. If callback returns false, the query stops early.
+		 */
+		template <std::ranges::random_access_range TGeometries, NDimensionalLineObject<2> TLine, class TCallback>
+		requires NDimensionalPolygonalObject<std::ranges::range_value_t<TGeometries>, 2> &&
+		std::invocable<TCallback&, std::size_t, typename GeometricTraits<TLine>::ValueType>
+		void raycast(const TGeometries& geometries, const TLine& line, TCallback callback) const
+		{
+			assert(std::ranges::size(geometries) == size());
+
+			auto filteredCallback = [&](std::size_t index)
+			{
+				auto dist = intersection(line, std::ranges::begin(geometries)[index]);
+				return !dist || detail::invokeTraversalCallback(callback, index, *dist);
+			};
+			traverse([&](const AABBType& bounds) { return detail::intersectsBounds(line, bounds); }, filteredCallback);
+		}
+
+	private:
+		struct PendingNode
+		{
+			// position of the first child
+			IndexType position;
+			IndexType level;
+		};
+
+		std::span<const AABBType> m_Bounds;
+		std::span<const IndexType> m_Indices;
+		std::span<const IndexType> m_LevelEnds;
+
+		template <class TPredicate, class TCallback>
+		void traverse(TPredicate predicate, TCallback& callback) const
+		{
+			if (empty())
+				return;
+
+			// each level leaves at most NodeSize pending nodes on the stack
+			constexpr std::size_t inlineStackSize = 256;
+			auto requiredStackSize = levelCount() * NodeSize;
+			if (requiredStackSize <= inlineStackSize)
+			{
+				std::array<PendingNode, inlineStackSize> stack;
+				traverse(predicate, callback, std::data(stack));
+			}
+			else
+			{
+				std::vector<PendingNode> stack(requiredStackSize);
+				traverse(predicate, callback, std::data(stack));
+			}
+		}
+
+		template <class TPredicate, class TCallback>
+		void traverse(TPredicate& predicate, TCallback& callback, PendingNode* stack) const
+		{
+			std::size_t stackSize = 0;
+			stack[stackSize++] = { static_cast<IndexType>(std::size(m_Bounds) - 1), static_cast<IndexType>(levelCount() - 1) };
+			while (0 < stackSize)
+			{
+				auto [first, level] = stack[--stackSize];
+				auto last = std::min<std::size_t>(first + NodeSize, m_LevelEnds[level]);
+				for (std::size_t position = first; position < last; ++position)
+				{
+					if (!predicate(m_Bounds[position]))
+						continue;
+
+					if (level == 0)
+					{
+						if (!detail::invokeTraversalCallback(callback, static_cast<std::size_t>(m_Indices[position])))
+							return;
+					}
+					else
+						stack[stackSize++] = { m_Indices[position], level - 1 };
+				}
+			}
+		}
+	};
+
+	/* Immutable R-tree over the bounding rects of objects, which suits datasets that are loaded once and queried often.
+	 * The tree gets bulk loaded by sorting the objects along the hilbert curve through the centres of their bounds; each consecutive
+	 * run of NodeSize entries forms a node of the next level. Nodes aren't allocated individually; the bounds of all levels are stored
+	 * in a single array, accompanied by an array of indices (see PackedRTreeView for the layout).
+	 * Objects are identified by their index in the range, the tree has been built from. The queries with geometry filter expect
+	 * exactly that range.
+	 */
+	template <class T, std::size_t NodeSize = 16>
+	requires (2 <= NodeSize)
+	class PackedRTree
+	{
+	public:
+		using ValueType = T;
+		using AABBType = AABB_t<T>;
+		using ViewType = PackedRTreeView<T, NodeSize>;
+		using IndexType = typename ViewType::IndexType;
+		constexpr static std::size_t nodeSize = NodeSize;
+
+		PackedRTree() noexcept = default;
+
+		template <std::ranges::input_range TObjects>
+		requires BoundedObject<std::ranges::range_value_t<TObjects>, T>
+		explicit PackedRTree(const TObjects& objects)
+		{
+			std::vector<AABBType> objectBounds;
+			if constexpr (std::ranges::sized_range<TObjects>)
+				objectBounds.reserve(std::ranges::size(objects));
+			for (const auto& object : objects)
+				objectBounds.emplace_back(detail::boundingRectAs<T>(object));
+			assert(std::size(objectBounds) < std::numeric_limits<IndexType>::max());
+
+			build(objectBounds);
+		}
+
+		[[nodiscard]] ViewType view() const noexcept
+		{
+			return { m_Bounds, m_Indices, m_LevelEnds };
+		}
+
+		[[nodiscard]] std::size_t size() const noexcept
+		{
+			return view().size();
+		}
+
+		[[nodiscard]] bool empty() const noexcept
+		{
+			return view().empty();
+		}
+
+		// bounds of the root node; must not be called on empty trees
+		[[nodiscard]] const AABBType& bounds() const noexcept
+		{
+			return view().bounds();
+		}
+
+		// leafs count as level 0
+		[[nodiscard]] std::size_t levelCount() const noexcept
+		{
+			return view().levelCount();
+		}
+
+		// see PackedRTreeView::query
+		template <BoundedObject<T> TObject, class TCallback>
+		requires std::invocable<TCallback&, std::size_t>
+		void query(const TObject& object, TCallback callback) const
+		{
+			view().query(object, std::move(callback));
+		}
+
+		// see PackedRTreeView::queryPoint
+		template <NDimensionalVectorObject<2> TVector, class TCallback>
+		requires std::is_same_v<typename TVector::ValueType, T> && std::invocable<TCallback&, std::size_t>
+		void queryPoint(const TVector& point, TCallback callback) const
+		{
+			view().queryPoint(point, std::move(callback));
+		}
+
+		// see PackedRTreeView::queryOverlapping
+		template <std::ranges::random_access_range TGeometries, NDimensionalObject<2> TObject, class TCallback>
+		requires NDimensionalObject<std::ranges::range_value_t<TGeometries>, 2> && std::invocable<TCallback&, std::size_t>
+		void queryOverlapping(const TGeometries& geometries, const TObject& object, TCallback callback) const
+		{
+			view().queryOverlapping(geometries, object, std::move(callback));
+		}
+
+		// see PackedRTreeView::raycast
+		template <std::ranges::random_access_range TGeometries, NDimensionalLineObject<2> TLine, class TCallback>
+		requires NDimensionalPolygonalObject<std::ranges::range_value_t<TGeometries>, 2> &&
+		std::invocable<TCallback&, std::size_t, typename GeometricTraits<TLine>::ValueType>
+		void raycast(const TGeometries& geometries, const TLine& line, TCallback callback) const
+		{
+			view().raycast(geometries, line, std::move(callback));
+		}
+
+	private:
+		std::vector<AABBType> m_Bounds;
+		std::vector<IndexType> m_Indices;
+		std::vector<IndexType> m_LevelEnds;
+
+		[[nodiscard]] static AABBType unite(const AABBType* first, const AABBType* last) noexcept
+		{
+			assert(first != last);
+			return std::accumulate(first + 1, last, *first, [](const AABBType& lhs, const AABBType& rhs) { return detail::boundingRect(lhs, rhs); });
+		}
+
+		void build(const std::vector<AABBType>& objectBounds)
+		{
+			auto leafCount = std::size(objectBounds);
+			if (leafCount == 0)
+				return;
+
+			// the hilbert index occupies the upper half of the keys, thus sorting them orders the object indices along the curve
+			auto totalBounds = unite(std::data(objectBounds), std::data(objectBounds) + leafCount);
+			auto& origin = totalBounds.position();
+			auto& span = totalBounds.span();
+			constexpr double maxCell = (1u << detail::hilbertOrder) - 1;
+			auto scaleX = span.x() == 0 ? 0. : maxCell / static_cast<double>(span.x());
+			auto scaleY = span.y() == 0 ? 0. : maxCell / static_cast<double>(span.y());
+			std::vector<std::uint64_t> keys(leafCount);
+			for (std::size_t i = 0; i < leafCount; ++i)
+			{
+				auto& bounds = objectBounds[i];
+				auto centreX = static_cast<double>(bounds.position().x() - origin.x()) + static_cast<double>(bounds.span().x()) / 2;
+				auto centreY = static_cast<double>(bounds.position().y() - origin.y()) + static_cast<double>(bounds.span().y()) / 2;
+				auto hilbert = detail::hilbertIndex(static_cast<std::uint32_t>(centreX * scaleX), static_cast<std::uint32_t>(centreY * scaleY));
+				keys[i] = static_cast<std::uint64_t>(hilbert) << 32 | i;
+			}
+			std::ranges::sort(keys);
+
+			auto nodeCount = leafCount;
+			for (auto levelSize = leafCount; 1 < levelSize;)
+			{
+				levelSize = (levelSize + NodeSize - 1) / NodeSize;
+				nodeCount += levelSize;
+			}
+			m_Bounds.resize(nodeCount);
+			m_Indices.resize(nodeCount);
+			m_LevelEnds.clear();
+
+			for (std::size_t i = 0; i < leafCount; ++i)
+			{
+				auto index = static_cast<IndexType>(keys[i]);
+				m_Bounds[i] = objectBounds[index];
+				m_Indices[i] = index;
+			}
+			m_LevelEnds.emplace_back(static_cast<IndexType>(leafCount));
+
+			for (std::size_t levelBegin = 0, levelEnd = leafCount, position = leafCount; 1 < levelEnd - levelBegin;)
+			{
+				for (auto child = levelBegin; child < levelEnd; child += NodeSize, ++position)
+				{
+					auto childEnd = std::min(child + NodeSize, levelEnd);
+					m_Bounds[position] = unite(std::data(m_Bounds) + child, std::data(m_Bounds) + childEnd);
+					m_Indices[position] = static_cast<IndexType>(child);
+				}
+				levelBegin = std::exchange(levelEnd, position);
+				m_LevelEnds.emplace_back(static_cast<IndexType>(levelEnd));
+			}
+			assert(m_LevelEnds.back() == nodeCount);
+		}
+	};
+}
+
+#endif
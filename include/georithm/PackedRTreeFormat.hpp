@@ -0,0 +1,313 @@
+//          Copyright Dominic Koepke 2017 - 2020.
+// Distributed under the Boost Software License, Version 1.0.
+//    (See accompanying file LICENSE_1_0.txt or copy at
+//          https://www.boost.org/LICENSE_1_0.txt)
+
+#ifndef GEORITHM_PACKED_R_TREE_FORMAT_HPP
+#define GEORITHM_PACKED_R_TREE_FORMAT_HPP
+
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cassert>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <optional>
+#include <ostream>
+#include <span>
+#include <type_traits>
+
+#include "georithm/PackedRTree.hpp"
+#include "georithm/Rect.hpp"
+
+namespace georithm::detail
+{
+	constexpr std::array<char, 8> packedRTreeMagic{ 'G', 'E', 'O', 'R', 'T', 'R', 'E', 'E' };
+	constexpr std::uint32_t packedRTreeVersion = 1;
+	// sections begin at cache line boundaries of the (page aligned) mapping
+	constexpr std::uint64_t packedRTreeSectionAlignment = 64;
+
+	// all members are stored in little endian
+	struct PackedRTreeHeader
+	{
+		std::array<char, 8> magic;
+		std::uint32_t version;
+		std::uint32_t valueType;
+		std::uint32_t nodeSize;
+		std::uint32_t levelCount;
+		std::uint64_t nodeCount;
+		std::uint64_t boundsOffset;
+		std::uint64_t indicesOffset;
+		std::uint64_t levelEndsOffset;
+		std::uint64_t fileSize;
+	};
+
+	static_assert(sizeof(PackedRTreeHeader) == 64 && std::is_trivially_copyable_v<PackedRTreeHeader>);
+
+	// kind of the value type (0 unsigned, 1 signed, 2 floating point) in the second byte, its size in bytes in the first one
+	template <class T>
+	[[nodiscard]] constexpr std::uint32_t packedRTreeValueType() noexcept
+	{
+		std::uint32_t kind = std::floating_point<T> ? 2 : std::signed_integral<T> ? 1 : 0;
+		return kind << 8 | static_cast<std::uint32_t>(sizeof(T));
+	}
+
+	template <class T>
+	[[nodiscard]] constexpr T byteSwap(T value) noexcept
+	{
+		auto bytes = std::bit_cast<std::array<std::byte, sizeof(T)>>(value);
+		std::ranges::reverse(bytes);
+		return std::bit_cast<T>(bytes);
+	}
+
+	// converts in both directions
+	template <class T>
+	[[nodiscard]] constexpr T littleEndian(T value) noexcept
+	{
+		if constexpr (std::endian::native == std::endian::little)
+			return value;
+		else
+			return byteSwap(value);
+	}
+
+	[[nodiscard]] constexpr std::uint64_t alignSection(std::uint64_t offset) noexcept
+	{
+		return (offset + packedRTreeSectionAlignment - 1) / packedRTreeSectionAlignment * packedRTreeSectionAlignment;
+	}
+
+	// header members in native byte order
+	template <class T, std::size_t NodeSize>
+	[[nodiscard]] constexpr PackedRTreeHeader makePackedRTreeHeader(std::uint64_t nodeCount, std::uint32_t levelCount) noexcept
+	{
+		PackedRTreeHeader header{};
+		header.magic = packedRTreeMagic;
+		header.version = packedRTreeVersion;
+		header.valueType = packedRTreeValueType<T>();
+		header.nodeSize = static_cast<std::uint32_t>(NodeSize);
+		header.levelCount = levelCount;
+		header.nodeCount = nodeCount;
+		header.boundsOffset = alignSection(sizeof(PackedRTreeHeader));
+		header.indicesOffset = alignSection(header.boundsOffset + nodeCount * sizeof(AABB_t<T>));
+		header.levelEndsOffset = alignSection(header.indicesOffset + nodeCount * sizeof(std::uint32_t));
+		header.fileSize = header.levelEndsOffset + levelCount * sizeof(std::uint32_t);
+		return header;
+	}
+
+	[[nodiscard]] constexpr PackedRTreeHeader littleEndian(PackedRTreeHeader header) noexcept
+	{
+		header.version = littleEndian(header.version);
+		header.valueType = littleEndian(header.valueType);
+		header.nodeSize = littleEndian(header.nodeSize);
+		header.levelCount = littleEndian(header.levelCount);
+		header.nodeCount = littleEndian(header.nodeCount);
+		header.boundsOffset = littleEndian(header.boundsOffset);
+		header.indicesOffset = littleEndian(header.indicesOffset);
+		header.levelEndsOffset = littleEndian(header.levelEndsOffset);
+		header.fileSize = littleEndian(header.fileSize);
+		return header;
+	}
+
+	inline void writePadding(std::ostream& out, std::uint64_t count)
+	{
+		constexpr std::array<char, packedRTreeSectionAlignment> zeros{};
+		assert(count <= std::size(zeros));
+		out.write(std::data(zeros), static_cast<std::streamsize>(count));
+	}
+
+	// writes the values in little endian; on little endian platforms the whole range is written at once
+	template <class T>
+	void writeLittleEndian(std::ostream& out, std::span<const T> values)
+	{
+		if constexpr (std::endian::native == std::endian::little)
+			out.write(reinterpret_cast<const char*>(std::data(values)), static_cast<std::streamsize>(values.size_bytes()));
+		else
+		{
+			for (auto& value : values)
+			{
+				auto converted = littleEndian(value);
+				out.write(reinterpret_cast<const char*>(&converted), sizeof(T));
+			}
+		}
+	}
+
+	template <class T>
+	void writeLittleEndian(std::ostream& out, std::span<const AABB_t<T>> rects)
+	{
+		if constexpr (std::endian::native == std::endian::little)
+			out.write(reinterpret_cast<const char*>(std::data(rects)), static_cast<std::streamsize>(rects.size_bytes()));
+		else
+		{
+			for (auto& rect : rects)
+			{
+				std::array values{ rect.position().x(), rect.position().y(), rect.span().x(), rect.span().y() };
+				writeLittleEndian(out, std::span<const T>{ values });
+			}
+		}
+	}
+
+	// the section has to lie within the bytes and has to be aligned for direct access
+	template <class TElement>
+	[[nodiscard]] std::optional<std::span<const TElement>> sectionOf(std::span<const std::byte> bytes, std::uint64_t offset, std::uint64_t count) noexcept
+	{
+		if (std::size(bytes) < offset || (std::size(bytes) - offset) / sizeof(TElement) < count)
+			return std::nullopt;
+
+		auto* first = std::data(bytes) + offset;
+		if (reinterpret_cast<std::uintptr_t>(first) % alignof(TElement) != 0)
+			return std::nullopt;
+		return std::span<const TElement>{ reinterpret_cast<const TElement*>(first), static_cast<std::size_t>(count) };
+	}
+
+	// leafs have to refer to one of the objects, inner nodes to the first node of their run of children; expects a valid level structure
+	template <std::size_t NodeSize, class TIndex>
+	[[nodiscard]] bool hasValidIndices(std::span<const TIndex> nodeIndices, std::span<const TIndex> levelEnds) noexcept
+	{
+		if (std::empty(levelEnds))
+			return true;
+
+		auto leafCount = levelEnds.front();
+		if (!std::ranges::all_of(nodeIndices.first(leafCount), [leafCount](TIndex index) { return index < leafCount; }))
+			return false;
+
+		for (std::size_t level = 1; level < std::size(levelEnds); ++level)
+		{
+			std::uint64_t childBegin = level == 1 ? 0 : levelEnds[level - 2];
+			for (std::uint64_t position = levelEnds[level - 1]; position < levelEnds[level]; ++position)
+			{
+				if (nodeIndices[position] != childBegin + (position - levelEnds[level - 1]) * NodeSize)
+					return false;
+			}
+		}
+		return true;
+	}
+}
+
+namespace georithm
+{
+	// how thoroughly openPackedRTree checks the file
+	enum class PackedRTreeValidation
+	{
+		structure,
+		full
+	};
+
+	/* Flat, pointer free file format of PackedRTree, which is meant to be memory mapped instead of rebuilding the tree on startup.
+	 * All values are stored in little endian:
+	 *  - 64 byte header: magic "GEORTREE", format version, value type tag, node size, level count, node count, the byte offsets of
+	 *    the three sections and the total size
+	 *  - bounds section: position.x, position.y, span.x and span.y of each node as value type
+	 *  - indices section: uint32 object index of each leaf or first child position of each inner node
+	 *  - level ends section: uint32 end position of each level, beginning with the leafs
+	 * Each section begins at a multiple of 64 bytes, padded with zeros.
+	 */
+	template <class T, std::size_t NodeSize>
+	[[nodiscard]] std::uint64_t serializedSize(const PackedRTreeView<T, NodeSize>& tree) noexcept
+	{
+		return detail::makePackedRTreeHeader<T, NodeSize>(std::size(tree.nodeBounds()), static_cast<std::uint32_t>(tree.levelCount())).fileSize;
+	}
+
+	template <class T, std::size_t NodeSize>
+	[[nodiscard]] std::uint64_t serializedSize(const PackedRTree<T, NodeSize>& tree) noexcept
+	{
+		return serializedSize(tree.view());
+	}
+
+	// writes the tree in the format described at serializedSize; errors are reported by the stream state
+	template <class T, std::size_t NodeSize>
+	void serialize(const PackedRTreeView<T, NodeSize>& tree, std::ostream& out)
+	{
+		static_assert(std::is_standard_layout_v<AABB_t<T>> && sizeof(AABB_t<T>) == 4 * sizeof(T), "rects must consist of exactly four values");
+
+		auto header = detail::makePackedRTreeHeader<T, NodeSize>(std::size(tree.nodeBounds()), static_cast<std::uint32_t>(tree.levelCount()));
+		auto fileHeader = detail::littleEndian(header);
+		out.write(reinterpret_cast<const char*>(&fileHeader), sizeof(fileHeader));
+
+		std::uint64_t offset = sizeof(fileHeader);
+		auto writeSection = [&](std::uint64_t sectionOffset, const auto& values)
+		{
+			detail::writePadding(out, sectionOffset - offset);
+			detail::writeLittleEndian(out, values);
+			offset = sectionOffset + values.size_bytes();
+		};
+		writeSection(header.boundsOffset, tree.nodeBounds());
+		writeSection(header.indicesOffset, tree.nodeIndices());
+		writeSection(header.levelEndsOffset, tree.levelEnds());
+		assert(offset == header.fileSize);
+	}
+
+	template <class T, std::size_t NodeSize>
+	void serialize(const PackedRTree<T, NodeSize>& tree, std::ostream& out)
+	{
+		serialize(tree.view(), out);
+	}
+
+	/* Views the tree, which has been written by serialize, directly in bytes (e.g. a memory mapped file) without copying it. Returns
+	 * nullopt, if the header doesn't match the expected tree type or format version, if any section exceeds the bytes or isn't
+	 * aligned for direct access (page aligned mappings always are) or on big endian platforms, which can't access the values in place.
+	 * PackedRTreeValidation::structure only validates the header and the level structure, which doesn't touch the sections besides
+	 * the level ends. The indices are trusted then: queries on a corrupted file may read out of bounds, and leaf indices beyond
+	 * levelEnds().front() make the queries with geometry filter (queryOverlapping, raycast) index the geometries out of range.
+	 * PackedRTreeValidation::full additionally checks each index once, which costs O(n) and reads the whole indices section.
+	 */
+	template <class T, std::size_t NodeSize>
+	[[nodiscard]] std::optional<PackedRTreeView<T, NodeSize>> openPackedRTree(std::span<const std::byte> bytes,
+																			PackedRTreeValidation validation = PackedRTreeValidation::structure) noexcept
+	{
+		static_assert(std::is_standard_layout_v<AABB_t<T>> && sizeof(AABB_t<T>) == 4 * sizeof(T), "rects must consist of exactly four values");
+
+		using View_t = PackedRTreeView<T, NodeSize>;
+		using Index_t = typename View_t::IndexType;
+
+		if constexpr (std::endian::native != std::endian::little)
+			return std::nullopt;
+
+		detail::PackedRTreeHeader header;
+		if (std::size(bytes) < sizeof(header))
+			return std::nullopt;
+		std::memcpy(&header, std::data(bytes), sizeof(header));
+		header = detail::littleEndian(header);
+
+		if (header.magic != detail::packedRTreeMagic || header.version != detail::packedRTreeVersion ||
+			header.valueType != detail::packedRTreeValueType<T>() || header.nodeSize != NodeSize ||
+			std::numeric_limits<Index_t>::max() < header.nodeCount || std::size(bytes) < header.fileSize)
+			return std::nullopt;
+
+		auto nodeBounds = detail::sectionOf<AABB_t<T>>(bytes, header.boundsOffset, header.nodeCount);
+		auto nodeIndices = detail::sectionOf<Index_t>(bytes, header.indicesOffset, header.nodeCount);
+		auto levelEnds = detail::sectionOf<Index_t>(bytes, header.levelEndsOffset, header.levelCount);
+		if (!nodeBounds || !nodeIndices || !levelEnds)
+			return std::nullopt;
+
+		// each level has to consist of the nodes for its child level, up to the single root
+		if (std::empty(*levelEnds))
+		{
+			if (header.nodeCount != 0)
+				return std::nullopt;
+		}
+		else
+		{
+			std::uint64_t levelSize = levelEnds->front();
+			for (std::size_t level = 1; level < std::size(*levelEnds); ++level)
+			{
+				auto expectedSize = (levelSize + NodeSize - 1) / NodeSize;
+				if ((*levelEnds)[level] < (*levelEnds)[level - 1] || (*levelEnds)[level] - (*levelEnds)[level - 1] != expectedSize)
+					return std::nullopt;
+				levelSize = expectedSize;
+			}
+			if (levelSize != 1 || levelEnds->back() != header.nodeCount)
+				return std::nullopt;
+		}
+
+		if (validation == PackedRTreeValidation::full && !detail::hasValidIndices<NodeSize>(*nodeIndices, *levelEnds))
+			return std::nullopt;
+
+		return View_t{ *nodeBounds, *nodeIndices, *levelEnds };
+	}
+}
+
+#endif
@@ -0,0 +1,131 @@
+//          Copyright Dominic Koepke 2017 - 2020.
+// Distributed under the Boost Software License, Version 1.0.
+//    (See accompanying file LICENSE_1_0.txt or copy at
+//          https://www.boost.org/LICENSE_1_0.txt)
+
+#ifndef GEORITHM_POLYGON_HPP
+#define GEORITHM_POLYGON_HPP
+
+#pragma once
+
+#include <cassert>
+#include <concepts>
+#include <initializer_list>
+#include <iterator>
+#include <ranges>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "georithm/Concepts.hpp"
+#include "georithm/Defines.hpp"
+#include "georithm/Line.hpp"
+#include "georithm/Utility.hpp"
+#include "georithm/Vector.hpp"
+
+namespace georithm
+{
+	/* Simple polygon, which is defined by an arbitrary sequence of vertices; the last vertex is implicitly connected with the
+	 * first one. No assumptions about orientation or convexity are made.
+	 */
+	template <NDimensionalVectorObject<2> TVectorType>
+	class Polygon
+	{
+	public:
+		using VectorType = TVectorType;
+		using ValueType = typename VectorType::ValueType;
+
+		Polygon() noexcept = default;
+		~Polygon() noexcept = default;
+
+		Polygon(std::initializer_list<VectorType> vertices) :
+			m_Vertices{ vertices }
+		{
+		}
+
+		explicit Polygon(std::vector<VectorType>&& vertices) noexcept :
+			m_Vertices{ std::move(vertices) }
+		{
+		}
+
+		template <std::ranges::input_range TRange>
+		requires std::convertible_to<std::ranges::range_value_t<TRange>, VectorType>
+		explicit Polygon(const TRange& vertices) :
+			m_Vertices(std::ranges::begin(vertices), std::ranges::end(vertices))
+		{
+		}
+
+		Polygon(const Polygon&) = default;
+		Polygon& operator =(const Polygon&) = default;
+		Polygon(Polygon&&) noexcept = default;
+		Polygon& operator =(Polygon&&) noexcept = default;
+
+		[[nodiscard]] bool operator ==(const Polygon&) const = default;
+
+		[[nodiscard]] VertexIndex_t vertexCount() const noexcept
+		{
+			return std::size(m_Vertices);
+		}
+
+		[[nodiscard]] EdgeIndex_t edgeCount() const noexcept
+		{
+			return std::size(m_Vertices);
+		}
+
+		[[nodiscard]] VectorType vertex(VertexIndex_t index) const noexcept
+		{
+			assert(index < vertexCount());
+			return m_Vertices[index];
+		}
+
+		[[nodiscard]] Segment<VectorType> edge(EdgeIndex_t index) const noexcept
+		{
+			assert(index < edgeCount() && !isNull());
+
+			auto& first = m_Vertices[index];
+			auto& second = m_Vertices[(index + 1) % vertexCount()];
+			return { first, second - first };
+		}
+
+		[[nodiscard]] const std::vector<VectorType>& vertices() const noexcept
+		{
+			return m_Vertices;
+		}
+
+		[[nodiscard]] std::vector<VectorType>& vertices() noexcept
+		{
+			return m_Vertices;
+		}
+
+		// polygons with less than 3 vertices don't enclose any area
+		[[nodiscard]] bool isNull() const noexcept
+		{
+			return std::size(m_Vertices) < 3;
+		}
+
+	private:
+		std::vector<VectorType> m_Vertices;
+	};
+
+	/* Polygon, whose vertices form a convex polygon in counter-clockwise order; the convex hull algorithms (see ConvexHull.hpp)
+	 * produce these. The convexity isn't checked, but it's relied on: intersects and overlaps use the separating axis test for
+	 * convex polygons, thus keep the vertices convex when modifying them.
+	 */
+	template <NDimensionalVectorObject<2> TVectorType>
+	class ConvexPolygon :
+		public Polygon<TVectorType>
+	{
+	public:
+		using Polygon<TVectorType>::Polygon;
+
+		[[nodiscard]] bool operator ==(const ConvexPolygon&) const = default;
+	};
+
+	template <NDimensionalVectorObject<2> TVectorType>
+	struct IsConvex<ConvexPolygon<TVectorType>> :
+		std::true_type
+	{
+	};
+}
+
+#endif
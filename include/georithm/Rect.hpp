@@ -9,10 +9,12 @@
 #pragma once
 
 #include <cassert>
+#include <type_traits>
 
 #include "georithm/Concepts.hpp"
 #include "georithm/Defines.hpp"
 #include "georithm/Line.hpp"
+#include "georithm/Utility.hpp"
 #include "georithm/Vector.hpp"
 
 namespace georithm
@@ -131,6 +133,38 @@ namespace georithm
 
 	template <ValueType T>
 	using AABB_t = Rect<T>;
+
+	template <class T, class... TTransformer>
+	struct StaticVertexCount<Rect<T, TTransformer...>> :
+		std::integral_constant<VertexIndex_t, 4>
+	{
+	};
+
+	// a rect stays convex, as long as all of its transformers are affine (or it has none at all)
+	template <class T, class... TTransformer>
+	struct IsConvex<Rect<T, TTransformer...>> :
+		std::bool_constant<(IsAffineTransformer_v<TTransformer> && ...)>
+	{
+	};
+}
+
+namespace georithm::detail
+{
+	// not sure if this would be right to expose to the general georithm namespace; possibly to concrete
+	template <class T>
+	struct IsRect :
+		std::false_type
+	{
+	};
+
+	template <class T, class... TTransformer>
+	struct IsRect<Rect<T, TTransformer...>> :
+		std::true_type
+	{
+	};
+
+	template <class T>
+	constexpr bool IsRect_v = IsRect<T>::value;
 }
 
 #endif
@@ -0,0 +1,285 @@
+//          Copyright Dominic Koepke 2017 - 2020.
+// Distributed under the Boost Software License, Version 1.0.
+//    (See accompanying file LICENSE_1_0.txt or copy at
+//          https://www.boost.org/LICENSE_1_0.txt)
+
+#ifndef GEORITHM_SIMD_HPP
+#define GEORITHM_SIMD_HPP
+
+#pragma once
+
+#include <array>
+#include <cstddef>
+
+#include "georithm/Defines.hpp"
+
+#if defined(GEORITHM_SIMD) && (defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2))
+#define GEORITHM_SIMD_SSE
+#include <immintrin.h>
+#endif
+
+#if defined(GEORITHM_SIMD_SSE) && defined(__AVX__)
+#define GEORITHM_SIMD_AVX
+#endif
+
+namespace georithm::detail::simd
+{
+	/* Describes how the values of a Vector<T, TDim> are stored. Types without a register specialization are stored as plain
+	 * array. Register specializations provide an aligned and possibly padded storage, which is always loaded as a whole; padding
+	 * lanes must stay zero, otherwise comparisons would be affected.
+	 */
+	template <class T, DimensionDescriptor_t TDim>
+	struct Register
+	{
+		constexpr static bool supported = false;
+		constexpr static DimensionDescriptor_t storageSize = TDim;
+		constexpr static std::size_t alignment = alignof(std::array<T, TDim>);
+	};
+
+#ifdef GEORITHM_SIMD_SSE
+	namespace sse
+	{
+		[[nodiscard]] inline float horizontalAdd(__m128 value) noexcept
+		{
+			auto shuffled = _mm_shuffle_ps(value, value, _MM_SHUFFLE(2, 3, 0, 1));
+			auto sums = _mm_add_ps(value, shuffled);
+			shuffled = _mm_movehl_ps(shuffled, sums);
+			return _mm_cvtss_f32(_mm_add_ss(sums, shuffled));
+		}
+
+		[[nodiscard]] inline double horizontalAdd(__m128d value) noexcept
+		{
+			return _mm_cvtsd_f64(_mm_add_sd(value, _mm_unpackhi_pd(value, value)));
+		}
+	}
+
+	template <>
+	struct Register<float, 4>
+	{
+		using Type = __m128;
+		constexpr static bool supported = true;
+		constexpr static DimensionDescriptor_t storageSize = 4;
+		constexpr static std::size_t alignment = 16;
+
+		[[nodiscard]] static Type load(const float* values) noexcept
+		{
+			return _mm_load_ps(values);
+		}
+
+		static void store(float* values, Type value) noexcept
+		{
+			_mm_store_ps(values, value);
+		}
+
+		// the padding lane (if any) is set to padding
+		[[nodiscard]] static Type broadcast(float value, [[maybe_unused]] float padding) noexcept
+		{
+			return _mm_set1_ps(value);
+		}
+
+		[[nodiscard]] static Type add(Type lhs, Type rhs) noexcept
+		{
+			return _mm_add_ps(lhs, rhs);
+		}
+
+		[[nodiscard]] static Type sub(Type lhs, Type rhs) noexcept
+		{
+			return _mm_sub_ps(lhs, rhs);
+		}
+
+		[[nodiscard]] static Type mul(Type lhs, Type rhs) noexcept
+		{
+			return _mm_mul_ps(lhs, rhs);
+		}
+
+		[[nodiscard]] static Type div(Type lhs, Type rhs) noexcept
+		{
+			return _mm_div_ps(lhs, rhs);
+		}
+
+		[[nodiscard]] static float dot(Type lhs, Type rhs) noexcept
+		{
+#ifdef __SSE4_1__
+			return _mm_cvtss_f32(_mm_dp_ps(lhs, rhs, 0xF1));
+#else
+			return sse::horizontalAdd(_mm_mul_ps(lhs, rhs));
+#endif
+		}
+	};
+
+	// padded to 4 lanes; the padding lane is kept zero
+	template <>
+	struct Register<float, 3> :
+		Register<float, 4>
+	{
+		[[nodiscard]] static Type broadcast(float value, float padding) noexcept
+		{
+			return _mm_set_ps(padding, value, value, value);
+		}
+	};
+
+	template <>
+	struct Register<double, 2>
+	{
+		using Type = __m128d;
+		constexpr static bool supported = true;
+		constexpr static DimensionDescriptor_t storageSize = 2;
+		constexpr static std::size_t alignment = 16;
+
+		[[nodiscard]] static Type load(const double* values) noexcept
+		{
+			return _mm_load_pd(values);
+		}
+
+		static void store(double* values, Type value) noexcept
+		{
+			_mm_store_pd(values, value);
+		}
+
+		[[nodiscard]] static Type broadcast(double value, [[maybe_unused]] double padding) noexcept
+		{
+			return _mm_set1_pd(value);
+		}
+
+		[[nodiscard]] static Type add(Type lhs, Type rhs) noexcept
+		{
+			return _mm_add_pd(lhs, rhs);
+		}
+
+		[[nodiscard]] static Type sub(Type lhs, Type rhs) noexcept
+		{
+			return _mm_sub_pd(lhs, rhs);
+		}
+
+		[[nodiscard]] static Type mul(Type lhs, Type rhs) noexcept
+		{
+			return _mm_mul_pd(lhs, rhs);
+		}
+
+		[[nodiscard]] static Type div(Type lhs, Type rhs) noexcept
+		{
+			return _mm_div_pd(lhs, rhs);
+		}
+
+		[[nodiscard]] static double dot(Type lhs, Type rhs) noexcept
+		{
+#ifdef __SSE4_1__
+			return _mm_cvtsd_f64(_mm_dp_pd(lhs, rhs, 0x31));
+#else
+			return sse::horizontalAdd(_mm_mul_pd(lhs, rhs));
+#endif
+		}
+	};
+#endif
+
+#ifdef GEORITHM_SIMD_SSE
+	/* Computes the element wise minimum and maximum of count interleaved 2d points (x0, y0, x1, y1, ...); count must be greater
+	 * than zero. Results are stored as { x, y } into min and max.
+	 */
+	inline void minMax2(const float* values, std::size_t count, float* min, float* max) noexcept
+	{
+		auto head = _mm_loadl_pi(_mm_setzero_ps(), reinterpret_cast<const __m64*>(values));
+		auto minAcc = _mm_movelh_ps(head, head);
+		auto maxAcc = minAcc;
+		std::size_t i = 1;
+		for (; i + 2 <= count; i += 2)
+		{
+			auto points = _mm_loadu_ps(values + 2 * i);
+			minAcc = _mm_min_ps(minAcc, points);
+			maxAcc = _mm_max_ps(maxAcc, points);
+		}
+		if (i < count)
+		{
+			auto tail = _mm_loadl_pi(_mm_setzero_ps(), reinterpret_cast<const __m64*>(values + 2 * i));
+			tail = _mm_movelh_ps(tail, tail);
+			minAcc = _mm_min_ps(minAcc, tail);
+			maxAcc = _mm_max_ps(maxAcc, tail);
+		}
+		minAcc = _mm_min_ps(minAcc, _mm_movehl_ps(minAcc, minAcc));
+		maxAcc = _mm_max_ps(maxAcc, _mm_movehl_ps(maxAcc, maxAcc));
+		_mm_storel_pi(reinterpret_cast<__m64*>(min), minAcc);
+		_mm_storel_pi(reinterpret_cast<__m64*>(max), maxAcc);
+	}
+
+	inline void minMax2(const double* values, std::size_t count, double* min, double* max) noexcept
+	{
+		auto minAcc = _mm_loadu_pd(values);
+		auto maxAcc = minAcc;
+		// two independent accumulator pairs hide the latency of minpd/maxpd
+		auto minAcc2 = minAcc;
+		auto maxAcc2 = minAcc;
+		std::size_t i = 1;
+		for (; i + 2 <= count; i += 2)
+		{
+			auto point = _mm_loadu_pd(values + 2 * i);
+			auto point2 = _mm_loadu_pd(values + 2 * i + 2);
+			minAcc = _mm_min_pd(minAcc, point);
+			maxAcc = _mm_max_pd(maxAcc, point);
+			minAcc2 = _mm_min_pd(minAcc2, point2);
+			maxAcc2 = _mm_max_pd(maxAcc2, point2);
+		}
+		if (i < count)
+		{
+			auto point = _mm_loadu_pd(values + 2 * i);
+			minAcc = _mm_min_pd(minAcc, point);
+			maxAcc = _mm_max_pd(maxAcc, point);
+		}
+		_mm_storeu_pd(min, _mm_min_pd(minAcc, minAcc2));
+		_mm_storeu_pd(max, _mm_max_pd(maxAcc, maxAcc2));
+	}
+#endif
+
+#ifdef GEORITHM_SIMD_AVX
+	template <>
+	struct Register<double, 4>
+	{
+		using Type = __m256d;
+		constexpr static bool supported = true;
+		constexpr static DimensionDescriptor_t storageSize = 4;
+		constexpr static std::size_t alignment = 32;
+
+		[[nodiscard]] static Type load(const double* values) noexcept
+		{
+			return _mm256_load_pd(values);
+		}
+
+		static void store(double* values, Type value) noexcept
+		{
+			_mm256_store_pd(values, value);
+		}
+
+		[[nodiscard]] static Type broadcast(double value, [[maybe_unused]] double padding) noexcept
+		{
+			return _mm256_set1_pd(value);
+		}
+
+		[[nodiscard]] static Type add(Type lhs, Type rhs) noexcept
+		{
+			return _mm256_add_pd(lhs, rhs);
+		}
+
+		[[nodiscard]] static Type sub(Type lhs, Type rhs) noexcept
+		{
+			return _mm256_sub_pd(lhs, rhs);
+		}
+
+		[[nodiscard]] static Type mul(Type lhs, Type rhs) noexcept
+		{
+			return _mm256_mul_pd(lhs, rhs);
+		}
+
+		[[nodiscard]] static Type div(Type lhs, Type rhs) noexcept
+		{
+			return _mm256_div_pd(lhs, rhs);
+		}
+
+		[[nodiscard]] static double dot(Type lhs, Type rhs) noexcept
+		{
+			auto product = _mm256_mul_pd(lhs, rhs);
+			return sse::horizontalAdd(_mm_add_pd(_mm256_castpd256_pd128(product), _mm256_extractf128_pd(product, 1)));
+		}
+	};
+#endif
+}
+
+#endif
@@ -0,0 +1,493 @@
+//          Copyright Dominic Koepke 2017 - 2020.
+// Distributed under the Boost Software License, Version 1.0.
+//    (See accompanying file LICENSE_1_0.txt or copy at
+//          https://www.boost.org/LICENSE_1_0.txt)
+
+#ifndef GEORITHM_SWEEP_AND_PRUNE_HPP
+#define GEORITHM_SWEEP_AND_PRUNE_HPP
+
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cassert>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <unordered_set>
+#include <utility>
+#include <vector>
+
+#include "georithm/Bounding.hpp"
+#include "georithm/Concepts.hpp"
+#include "georithm/Rect.hpp"
+#include "georithm/Utility.hpp"
+
+namespace georithm
+{
+	/* Broad phase, which keeps the interval endpoints of all proxies sorted along both axes and tracks the set of overlapping pairs.
+	 * Between two updates the endpoints mostly keep their order, thus update re-sorts them by insertion sort; each swap of a lower
+	 * with an upper endpoint is exactly one place, where a pair may start or stop overlapping. A frame therefore costs O(N + swaps)
+	 * instead of a full sort. Many insertions at once fall back to a full sort and sweep, which is cheaper then.
+	 * Bounds are treated as closed intervals, thus touching proxies overlap. AABB_t objects are taken as they are, thus they may be
+	 * degenerated to lines or points; all other objects are bounded by boundingRect. Coordinates must be less than the maximum of T
+	 * (or infinity), which marks removed proxies. Proxy ids are stable until the proxy gets removed; afterwards they may be reused.
+	 */
+	template <class T, std::semiregular TUserData = std::size_t>
+	class SweepAndPrune
+	{
+	public:
+		using ValueType = T;
+		using UserDataType = TUserData;
+		using AABBType = AABB_t<T>;
+		using ProxyId = std::size_t;
+		constexpr static ProxyId nullProxy = std::numeric_limits<ProxyId>::max();
+
+		SweepAndPrune() noexcept = default;
+
+		// the proxy doesn't take part in any pair before the next update
+		template <BoundedObject<T> TObject>
+		ProxyId insert(const TObject& object, TUserData userData)
+		{
+			ProxyId proxyId = std::size(m_Proxies);
+			if (std::empty(m_FreeProxies))
+			{
+				assert(proxyId < maxProxyCount);
+				m_Proxies.emplace_back();
+			}
+			else
+			{
+				proxyId = m_FreeProxies.back();
+				m_FreeProxies.pop_back();
+			}
+
+			// appending the endpoints behaves as if the proxy had been infinitely far away before
+			auto& proxy = m_Proxies[proxyId];
+			proxy.userData = std::move(userData);
+			proxy.state = ProxyState::active;
+			setBounds(proxy, boundsOf(object));
+			for (auto& endpoints : m_Endpoints)
+			{
+				endpoints.push_back({ {}, {}, {}, encode(proxyId, false) });
+				endpoints.push_back({ {}, {}, {}, encode(proxyId, true) });
+			}
+			++m_ProxyCount;
+			++m_PendingInsertions;
+			return proxyId;
+		}
+
+		// the pairs of the proxy are reported as ended by the next update, after which the id becomes available again
+		void remove(ProxyId proxyId) noexcept
+		{
+			assert(isActive(proxyId));
+
+			auto& proxy = m_Proxies[proxyId];
+			proxy.state = ProxyState::removed;
+			constexpr auto removedValue = std::numeric_limits<T>::has_infinity ? std::numeric_limits<T>::infinity() : std::numeric_limits<T>::max();
+			proxy.min = { removedValue, removedValue };
+			proxy.max = { removedValue, removedValue };
+			++m_RemovedCount;
+			--m_ProxyCount;
+		}
+
+		// updates the bounds of the proxy; pairs change during the next update
+		template <BoundedObject<T> TObject>
+		void move(ProxyId proxyId, const TObject& object) noexcept
+		{
+			assert(isActive(proxyId));
+
+			setBounds(m_Proxies[proxyId], boundsOf(object));
+		}
+
+		/* Brings the endpoints in order and invokes onBegin(lhsProxyId, rhsProxyId) for each pair, which started overlapping since the
+		 * last update, and onEnd(lhsProxyId, rhsProxyId) for each pair, which stopped overlapping; lhsProxyId is always less than
+		 * rhsProxyId. Each pair is reported at most once per update.
+		 */
+		template <class TBeginCallback, class TEndCallback>
+		requires std::invocable<TBeginCallback&, ProxyId, ProxyId> && std::invocable<TEndCallback&, ProxyId, ProxyId>
+		void update(TBeginCallback onBegin, TEndCallback onEnd)
+		{
+			// moving k appended proxies into place costs about k * N, which exceeds N * log(N) of a full sort at some point
+			if (std::bit_width(std::size(m_Endpoints[0])) < m_PendingInsertions)
+			{
+				rebuild(onBegin, onEnd);
+			}
+			else
+			{
+				for (std::size_t axis = 0; axis < 2; ++axis)
+					insertionSort(axis, onBegin, onEnd);
+
+				// removed proxies have the greatest endpoints, thus they are the last ones on both axes
+				auto remainingCount = std::size(m_Endpoints[0]) - 2 * m_RemovedCount;
+				auto isPaired = [&](const Endpoint& endpoint) { return m_Proxies[proxyOf(endpoint)].pairCount != 0; };
+				if (std::any_of(std::begin(m_Endpoints[0]) + remainingCount, std::end(m_Endpoints[0]), isPaired))
+					endRemovedPairs(onEnd);
+				for (auto i = remainingCount; i < std::size(m_Endpoints[0]); ++i)
+				{
+					assert(m_Proxies[proxyOf(m_Endpoints[0][i])].state == ProxyState::removed);
+					if (isUpper(m_Endpoints[0][i]))
+						freeProxy(proxyOf(m_Endpoints[0][i]));
+				}
+				for (auto& endpoints : m_Endpoints)
+					endpoints.resize(remainingCount);
+			}
+			assert(m_RemovedCount == 0);
+			m_PendingInsertions = 0;
+		}
+
+		// same as update, but without the reports
+		void update()
+		{
+			update([](ProxyId, ProxyId) {}, [](ProxyId, ProxyId) {});
+		}
+
+		void clear() noexcept
+		{
+			m_Proxies.clear();
+			m_FreeProxies.clear();
+			for (auto& endpoints : m_Endpoints)
+				endpoints.clear();
+			m_Pairs.clear();
+			m_ProxyCount = 0;
+			m_PendingInsertions = 0;
+			m_RemovedCount = 0;
+		}
+
+		[[nodiscard]] AABBType bounds(ProxyId proxyId) const noexcept
+		{
+			assert(isActive(proxyId));
+			auto& proxy = m_Proxies[proxyId];
+			return { { proxy.min[0], proxy.min[1] }, { proxy.max[0] - proxy.min[0], proxy.max[1] - proxy.min[1] } };
+		}
+
+		[[nodiscard]] const TUserData& userData(ProxyId proxyId) const noexcept
+		{
+			assert(proxyId < std::size(m_Proxies) && m_Proxies[proxyId].state != ProxyState::free);
+			return m_Proxies[proxyId].userData;
+		}
+
+		[[nodiscard]] TUserData& userData(ProxyId proxyId) noexcept
+		{
+			assert(proxyId < std::size(m_Proxies) && m_Proxies[proxyId].state != ProxyState::free);
+			return m_Proxies[proxyId].userData;
+		}
+
+		[[nodiscard]] std::size_t size() const noexcept
+		{
+			return m_ProxyCount;
+		}
+
+		[[nodiscard]] bool empty() const noexcept
+		{
+			return m_ProxyCount == 0;
+		}
+
+		// number of overlapping pairs as of the last update
+		[[nodiscard]] std::size_t pairCount() const noexcept
+		{
+			return std::size(m_Pairs);
+		}
+
+		/* Invokes callback(lhsProxyId, rhsProxyId) for each overlapping pair as of the last update in unspecified order; lhsProxyId is
+		 * always less than rhsProxyId. If callback returns false, the enumeration stops early.
+		 */
+		template <class TCallback>
+		requires std::invocable<TCallback&, ProxyId, ProxyId>
+		void forEachOverlappingPair(TCallback callback) const
+		{
+			for (auto key : m_Pairs)
+			{
+				if (!detail::invokeTraversalCallback(callback, static_cast<ProxyId>(key >> 32), static_cast<ProxyId>(key & 0xFFFF'FFFF)))
+					return;
+			}
+		}
+
+	private:
+		enum class ProxyState : std::uint8_t
+		{
+			free,
+			active,
+			removed
+		};
+
+		struct Proxy
+		{
+			std::array<T, 2> min{};
+			std::array<T, 2> max{};
+			std::uint32_t pairCount = 0;
+			TUserData userData{};
+			ProxyState state = ProxyState::free;
+		};
+
+		/* The lowest bit of data tells whether it's the upper endpoint, the next one whether the proxy had any pairs when the endpoint
+		 * got refreshed and the others hold the proxy id. The values are copies of the proxy bounds, which are refreshed by update;
+		 * thus moving a proxy doesn't need to know the positions of its endpoints. The interval on the other axis and the pair flag
+		 * reject most candidate pairs without looking at the proxies or the pair set.
+		 */
+		struct Endpoint
+		{
+			T value;
+			T otherMin;
+			T otherMax;
+			std::uint32_t data;
+		};
+
+		constexpr static ProxyId maxProxyCount = std::numeric_limits<std::uint32_t>::max() >> 2;
+		constexpr static std::uint32_t upperFlag = 1;
+		constexpr static std::uint32_t pairsFlag = 2;
+
+		std::vector<Proxy> m_Proxies;
+		std::vector<ProxyId> m_FreeProxies;
+		std::array<std::vector<Endpoint>, 2> m_Endpoints;
+		// both proxy ids of a pair, the lower one in the upper half
+		std::unordered_set<std::uint64_t> m_Pairs;
+		std::size_t m_ProxyCount = 0;
+		std::size_t m_PendingInsertions = 0;
+		std::size_t m_RemovedCount = 0;
+
+		[[nodiscard]] static constexpr std::uint32_t encode(ProxyId proxyId, bool isUpper) noexcept
+		{
+			return static_cast<std::uint32_t>(proxyId) << 2 | (isUpper ? upperFlag : 0);
+		}
+
+		[[nodiscard]] static constexpr ProxyId proxyOf(std::uint32_t data) noexcept
+		{
+			return data >> 2;
+		}
+
+		[[nodiscard]] static constexpr ProxyId proxyOf(const Endpoint& endpoint) noexcept
+		{
+			return proxyOf(endpoint.data);
+		}
+
+		[[nodiscard]] static constexpr bool isUpper(const Endpoint& endpoint) noexcept
+		{
+			return endpoint.data & upperFlag;
+		}
+
+		// lower endpoints precede upper ones at equal values, thus touching intervals overlap
+		[[nodiscard]] static constexpr bool isLess(const Endpoint& lhs, const Endpoint& rhs) noexcept
+		{
+			return lhs.value < rhs.value || (lhs.value == rhs.value && !isUpper(lhs) && isUpper(rhs));
+		}
+
+		[[nodiscard]] static constexpr std::uint64_t pairKey(ProxyId lhs, ProxyId rhs) noexcept
+		{
+			auto [first, second] = std::minmax(lhs, rhs);
+			return static_cast<std::uint64_t>(first) << 32 | static_cast<std::uint64_t>(second);
+		}
+
+		[[nodiscard]] bool isActive(ProxyId proxyId) const noexcept
+		{
+			return proxyId < std::size(m_Proxies) && m_Proxies[proxyId].state == ProxyState::active;
+		}
+
+		[[nodiscard]] bool overlaps(const Proxy& lhs, const Proxy& rhs) const noexcept
+		{
+			return lhs.min[0] <= rhs.max[0] && rhs.min[0] <= lhs.max[0] && lhs.min[1] <= rhs.max[1] && rhs.min[1] <= lhs.max[1];
+		}
+
+		template <BoundedObject<T> TObject>
+		[[nodiscard]] static AABBType boundsOf(const TObject& object) noexcept
+		{
+			if constexpr (std::same_as<TObject, AABB_t<typename GeometricTraits<TObject>::ValueType>>)
+				return detail::convertBounds<T>(object);
+			else
+				return detail::boundingRectAs<T>(object);
+		}
+
+		// doesn't use the bounding functions, which reject null rects
+		static void setBounds(Proxy& proxy, const AABBType& bounds) noexcept
+		{
+			auto& position = bounds.position();
+			auto corner = position + bounds.span();
+			proxy.min = { std::min(position.x(), corner.x()), std::min(position.y(), corner.y()) };
+			proxy.max = { std::max(position.x(), corner.x()), std::max(position.y(), corner.y()) };
+		}
+
+		void freeProxy(ProxyId proxyId)
+		{
+			assert(m_Proxies[proxyId].pairCount == 0);
+			m_Proxies[proxyId].state = ProxyState::free;
+			m_FreeProxies.emplace_back(proxyId);
+			--m_RemovedCount;
+		}
+
+		void refresh(Endpoint& endpoint, std::size_t axis) const noexcept
+		{
+			auto& proxy = m_Proxies[proxyOf(endpoint)];
+			endpoint.value = isUpper(endpoint) ? proxy.max[axis] : proxy.min[axis];
+			endpoint.otherMin = proxy.min[1 - axis];
+			endpoint.otherMax = proxy.max[1 - axis];
+			endpoint.data = (endpoint.data & ~pairsFlag) | (proxy.pairCount != 0 ? pairsFlag : 0);
+		}
+
+		[[nodiscard]] static constexpr bool overlapsOnOtherAxis(const Endpoint& lhs, const Endpoint& rhs) noexcept
+		{
+			return lhs.otherMin <= rhs.otherMax && rhs.otherMin <= lhs.otherMax;
+		}
+
+		template <class TBeginCallback>
+		void beginPair(const Endpoint& endpoint, const Endpoint& other, TBeginCallback& onBegin)
+		{
+			if (!overlapsOnOtherAxis(endpoint, other))
+				return;
+
+			auto lhs = proxyOf(endpoint);
+			auto rhs = proxyOf(other);
+			auto& lhsProxy = m_Proxies[lhs];
+			auto& rhsProxy = m_Proxies[rhs];
+			if (lhsProxy.state == ProxyState::active && rhsProxy.state == ProxyState::active && overlaps(lhsProxy, rhsProxy) &&
+				m_Pairs.emplace(pairKey(lhs, rhs)).second)
+			{
+				++lhsProxy.pairCount;
+				++rhsProxy.pairCount;
+				onBegin(std::min(lhs, rhs), std::max(lhs, rhs));
+			}
+		}
+
+		/* A pair, which ends during an update, existed before, thus both proxies had pairs when their endpoints got refreshed. The first
+		 * axis leaves pairs, which don't overlap on the second axis anymore, to the sort of the second axis; they overlapped there
+		 * before, thus its sort is going to separate them as well.
+		 */
+		template <class TEndCallback>
+		void endPair(std::size_t axis, const Endpoint& endpoint, const Endpoint& other, TEndCallback& onEnd)
+		{
+			if (!(endpoint.data & other.data & pairsFlag) || (axis == 0 && !overlapsOnOtherAxis(endpoint, other)))
+				return;
+
+			auto lhs = proxyOf(endpoint);
+			auto rhs = proxyOf(other);
+			if (m_Pairs.erase(pairKey(lhs, rhs)) != 0)
+			{
+				--m_Proxies[lhs].pairCount;
+				--m_Proxies[rhs].pairCount;
+				onEnd(std::min(lhs, rhs), std::max(lhs, rhs));
+			}
+		}
+
+		/* All endpoints of removed proxies are equal, thus sorting never separates two of them. Their pairs are left over after the
+		 * sort and get ended here.
+		 */
+		template <class TEndCallback>
+		void endRemovedPairs(TEndCallback& onEnd)
+		{
+			std::erase_if(m_Pairs, [&](std::uint64_t key)
+				{
+					auto lhs = static_cast<ProxyId>(key >> 32);
+					auto rhs = static_cast<ProxyId>(key & 0xFFFF'FFFF);
+					if (m_Proxies[lhs].state != ProxyState::removed && m_Proxies[rhs].state != ProxyState::removed)
+						return false;
+
+					--m_Proxies[lhs].pairCount;
+					--m_Proxies[rhs].pairCount;
+					onEnd(lhs, rhs);
+					return true;
+				}
+			);
+		}
+
+		/* An endpoint moving below an upper endpoint of another proxy lets both intervals overlap on this axis, which is only a
+		 * candidate until the other axis has been checked. An upper endpoint moving below a lower one separates both proxies.
+		 */
+		template <class TBeginCallback, class TEndCallback>
+		void insertionSort(std::size_t axis, TBeginCallback& onBegin, TEndCallback& onEnd)
+		{
+			auto& endpoints = m_Endpoints[axis];
+			for (std::size_t i = 0; i < std::size(endpoints); ++i)
+			{
+				refresh(endpoints[i], axis);
+				if (i == 0 || !isLess(endpoints[i], endpoints[i - 1]))
+					continue;
+
+				auto endpoint = endpoints[i];
+				auto j = i;
+				for (; 0 < j && isLess(endpoint, endpoints[j - 1]); --j)
+				{
+					auto& other = endpoints[j - 1];
+					if (isUpper(endpoint) != isUpper(other))
+					{
+						if (isUpper(other))
+							beginPair(endpoint, other, onBegin);
+						else
+							endPair(axis, endpoint, other, onEnd);
+					}
+					endpoints[j] = other;
+				}
+				endpoints[j] = endpoint;
+			}
+		}
+
+		// sorts all endpoints from scratch, sweeps along the first axis and reports the differences to the previous pairs
+		template <class TBeginCallback, class TEndCallback>
+		void rebuild(TBeginCallback& onBegin, TEndCallback& onEnd)
+		{
+			for (std::size_t axis = 0; axis < 2; ++axis)
+			{
+				auto& endpoints = m_Endpoints[axis];
+				std::erase_if(endpoints, [&](const Endpoint& endpoint) { return m_Proxies[proxyOf(endpoint)].state == ProxyState::removed; });
+				for (auto& endpoint : endpoints)
+					refresh(endpoint, axis);
+				std::sort(std::begin(endpoints), std::end(endpoints), isLess);
+			}
+
+			std::unordered_set<std::uint64_t> pairs;
+			pairs.reserve(std::size(m_Pairs));
+			// the open proxies are unordered, each upper endpoint removes its proxy by swapping it with the last one
+			std::vector<std::uint32_t> openProxies;
+			std::vector<std::uint32_t> openPositions(std::size(m_Proxies));
+			for (auto& endpoint : m_Endpoints[0])
+			{
+				auto proxyId = static_cast<std::uint32_t>(proxyOf(endpoint));
+				if (isUpper(endpoint))
+				{
+					auto position = openPositions[proxyId];
+					openPositions[openProxies.back()] = position;
+					openProxies[position] = openProxies.back();
+					openProxies.pop_back();
+				}
+				else
+				{
+					auto& proxy = m_Proxies[proxyId];
+					for (auto otherId : openProxies)
+					{
+						auto& other = m_Proxies[otherId];
+						if (proxy.min[1] <= other.max[1] && other.min[1] <= proxy.max[1])
+							pairs.emplace(pairKey(proxyId, otherId));
+					}
+					openPositions[proxyId] = static_cast<std::uint32_t>(std::size(openProxies));
+					openProxies.emplace_back(proxyId);
+				}
+			}
+
+			for (auto key : m_Pairs)
+			{
+				if (!pairs.contains(key))
+					onEnd(static_cast<ProxyId>(key >> 32), static_cast<ProxyId>(key & 0xFFFF'FFFF));
+			}
+			for (auto key : pairs)
+			{
+				if (!m_Pairs.contains(key))
+					onBegin(static_cast<ProxyId>(key >> 32), static_cast<ProxyId>(key & 0xFFFF'FFFF));
+			}
+			m_Pairs = std::move(pairs);
+
+			for (auto& proxy : m_Proxies)
+				proxy.pairCount = 0;
+			for (auto key : m_Pairs)
+			{
+				++m_Proxies[key >> 32].pairCount;
+				++m_Proxies[key & 0xFFFF'FFFF].pairCount;
+			}
+			for (ProxyId proxyId = 0; proxyId < std::size(m_Proxies); ++proxyId)
+			{
+				if (m_Proxies[proxyId].state == ProxyState::removed)
+					freeProxy(proxyId);
+			}
+		}
+	};
+}
+
+#endif
@@ -0,0 +1,417 @@
+//          Copyright Dominic Koepke 2017 - 2020.
+// Distributed under the Boost Software License, Version 1.0.
+//    (See accompanying file LICENSE_1_0.txt or copy at
+//          https://www.boost.org/LICENSE_1_0.txt)
+
+#ifndef GEORITHM_SWEEP_INTERSECTION_HPP
+#define GEORITHM_SWEEP_INTERSECTION_HPP
+
+#pragma once
+
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <iterator>
+#include <limits>
+#include <map>
+#include <queue>
+#include <ranges>
+#include <set>
+#include <unordered_set>
+#include <utility>
+#include <vector>
+
+#include "georithm/Concepts.hpp"
+#include "georithm/GeometricTraits.hpp"
+#include "georithm/Intersection.hpp"
+#include "georithm/Line.hpp"
+#include "georithm/Utility.hpp"
+#include "georithm/Vector.hpp"
+
+namespace georithm::detail
+{
+	/* Bentley-Ottmann sweep over a set of segments; the sweep line moves from left to right (and from bottom to top along vertical
+	 * segments). Each event point reports the group of all segments, which pass through it, thus degenerated cases like shared end
+	 * points, multiple segments crossing at the same point, vertical segments and collinear overlaps don't need special handling;
+	 * every intersecting pair has at least one common point, at which both segments belong to the same group. New event points are
+	 * only computed for segments, which become neighbours in the status, thus the sweep runs in O((N + K) log N).
+	 * End points are computed as location + direction, just like intersection does implicitly. Nevertheless the end point of one
+	 * segment and the start point of another may differ by a few ulps, while intersection still reports them as touching; thus
+	 * ended segments stay in the status as horizontal stubs, until the sweep line has passed them by a small tolerance.
+	 */
+	template <std::floating_point T>
+	class SegmentSweep
+	{
+	public:
+		using VectorType = Vector<T, 2>;
+
+		template <std::ranges::random_access_range TRange>
+		explicit SegmentSweep(const TRange& segments) :
+			m_Status{ StatusLess{ this } }
+		{
+			auto count = std::ranges::size(segments);
+			m_Segments.reserve(count);
+			for (const auto& segment : segments)
+			{
+				assert(!isNull(segment));
+
+				Segment<VectorType> line{ segment.location(), segment.direction() };
+				auto first = line.location();
+				auto second = line.location() + line.direction();
+				if (pointLess(second, first))
+					std::swap(first, second);
+
+				auto index = std::size(m_Segments);
+				auto isVertical = first.x() == second.x();
+				auto slope = isVertical ? std::numeric_limits<T>::infinity() : (second.y() - first.y()) / (second.x() - first.x());
+				auto scale = std::max({ std::abs(first.x()), std::abs(first.y()), std::abs(second.x()), std::abs(second.y()) });
+				m_Segments.push_back({ line, first, second, slope, 64 * std::numeric_limits<T>::epsilon() * scale, isVertical });
+				m_Events[first].upper.push_back(index);
+				m_Events[second].lower.push_back(index);
+			}
+			m_Handles.resize(count, std::end(m_Status));
+			m_Stamps.resize(count, 0);
+		}
+
+		SegmentSweep(const SegmentSweep&) = delete;
+		SegmentSweep& operator =(const SegmentSweep&) = delete;
+
+		/* Invokes callback(lhsIndex, rhsIndex) for each pair of segments, which may intersect; each intersecting pair is reported at
+		 * least once, but pairs may be reported multiple times. If callback returns false, the sweep stops early.
+		 */
+		template <class TCallback>
+		bool run(TCallback callback)
+		{
+			std::vector<std::size_t> group;
+			while (!std::empty(m_Events))
+			{
+				group.clear();
+				// stubs leave the status as soon as the sweep line has passed them, which is an event on its own
+				if (!std::empty(m_Stubs) && m_Stubs.top().first < std::begin(m_Events)->first.x())
+					removeStub();
+				else
+				{
+					auto node = m_Events.extract(std::begin(m_Events));
+					handleEvent(node.key(), node.mapped(), group);
+				}
+
+				for (auto lhsIter = std::begin(group); lhsIter != std::end(group); ++lhsIter)
+				{
+					for (auto rhsIter = std::next(lhsIter); rhsIter != std::end(group); ++rhsIter)
+					{
+						if (!invokeTraversalCallback(callback, *lhsIter, *rhsIter))
+							return false;
+					}
+				}
+				for (auto [lhs, rhs] : m_PassedCrossings)
+				{
+					if (!invokeTraversalCallback(callback, lhs, rhs))
+						return false;
+				}
+				m_PassedCrossings.clear();
+			}
+			return true;
+		}
+
+	private:
+		struct SweepSegment
+		{
+			Segment<VectorType> line;
+			// first is always the lexicographically smaller end point
+			VectorType first;
+			VectorType second;
+			T slope;
+			T tolerance;
+			bool vertical;
+			bool ended = false;
+		};
+
+		struct Event
+		{
+			std::vector<std::size_t> upper;
+			std::vector<std::size_t> lower;
+			std::vector<std::size_t> crossing;
+		};
+
+		struct PointLess
+		{
+			[[nodiscard]] bool operator ()(const VectorType& lhs, const VectorType& rhs) const noexcept
+			{
+				return pointLess(lhs, rhs);
+			}
+		};
+
+		// orders the segments by their height at the sweep point; segments through the sweep point are ordered by their slope
+		struct StatusLess
+		{
+			using is_transparent = void;
+
+			const SegmentSweep* sweep;
+
+			[[nodiscard]] bool operator ()(std::size_t lhs, std::size_t rhs) const noexcept
+			{
+				auto lhsKey = sweep->key(lhs);
+				auto rhsKey = sweep->key(rhs);
+				if (lhsKey != rhsKey)
+					return lhsKey < rhsKey;
+				auto lhsSlope = sweep->slope(lhs);
+				auto rhsSlope = sweep->slope(rhs);
+				if (lhsSlope != rhsSlope)
+					return lhsSlope < rhsSlope;
+				return lhs < rhs;
+			}
+
+			[[nodiscard]] bool operator ()(std::size_t lhs, const VectorType& point) const noexcept
+			{
+				return sweep->key(lhs) < point.y();
+			}
+
+			[[nodiscard]] bool operator ()(const VectorType& point, std::size_t rhs) const noexcept
+			{
+				return point.y() < sweep->key(rhs);
+			}
+		};
+
+		using Status_t = std::set<std::size_t, StatusLess>;
+		using Stub_t = std::pair<T, std::size_t>;
+
+		std::vector<SweepSegment> m_Segments;
+		std::map<VectorType, Event, PointLess> m_Events;
+		Status_t m_Status;
+		std::vector<typename Status_t::iterator> m_Handles;
+		// segments of the current group are stamped with the current event; they are (re-)inserted at the height of the event point
+		std::vector<std::size_t> m_Stamps;
+		std::size_t m_Stamp = 0;
+		VectorType m_SweepPoint{};
+		// ended segments ordered by the x coordinate, at which they leave the status
+		std::priority_queue<Stub_t, std::vector<Stub_t>, std::greater<>> m_Stubs;
+		// ended vertical segments by their upper end point; they still report the group of each event point, which touches them
+		std::multimap<T, std::size_t> m_VerticalStubs;
+		// crossings of new neighbours, which lie already behind the sweep point, thus don't get their own event
+		std::vector<std::pair<std::size_t, std::size_t>> m_PassedCrossings;
+
+		[[nodiscard]] static bool pointLess(const VectorType& lhs, const VectorType& rhs) noexcept
+		{
+			return lhs.x() < rhs.x() || (lhs.x() == rhs.x() && lhs.y() < rhs.y());
+		}
+
+		[[nodiscard]] T key(std::size_t index) const noexcept
+		{
+			if (m_Stamps[index] == m_Stamp)
+				return m_SweepPoint.y();
+
+			auto& segment = m_Segments[index];
+			if (segment.ended)
+				return segment.second.y();
+			if (segment.vertical)
+				return std::clamp(m_SweepPoint.y(), segment.first.y(), segment.second.y());
+
+			auto x = m_SweepPoint.x();
+			if (x <= segment.first.x())
+				return segment.first.y();
+			if (segment.second.x() <= x)
+				return segment.second.y();
+			return segment.first.y() + (x - segment.first.x()) * segment.slope;
+		}
+
+		[[nodiscard]] T slope(std::size_t index) const noexcept
+		{
+			auto& segment = m_Segments[index];
+			return segment.ended ? T(0) : segment.slope;
+		}
+
+		// the event point of a crossing is rounded, thus the height of the segments is compared with a tolerance, which grows with the slope
+		[[nodiscard]] bool passesSweepPoint(std::size_t index) const noexcept
+		{
+			auto& segment = m_Segments[index];
+			auto tolerance = std::max(segment.tolerance, 64 * std::numeric_limits<T>::epsilon() * std::max(std::abs(m_SweepPoint.x()), std::abs(m_SweepPoint.y())));
+			auto steepness = segment.vertical || segment.ended ? T(1) : T(1) + std::abs(segment.slope);
+			return std::abs(key(index) - m_SweepPoint.y()) <= tolerance * steepness;
+		}
+
+		[[nodiscard]] bool isInStatus(std::size_t index) const noexcept
+		{
+			return m_Handles[index] != std::end(m_Status);
+		}
+
+		void stamp(std::size_t index, std::vector<std::size_t>& group)
+		{
+			if (m_Stamps[index] != m_Stamp)
+			{
+				m_Stamps[index] = m_Stamp;
+				group.push_back(index);
+			}
+		}
+
+		void removeStub()
+		{
+			auto [x, index] = m_Stubs.top();
+			m_Stubs.pop();
+			m_SweepPoint = { x, std::numeric_limits<T>::lowest() };
+			if (auto& segment = m_Segments[index]; segment.vertical)
+			{
+				auto [begin, end] = m_VerticalStubs.equal_range(segment.second.y());
+				m_VerticalStubs.erase(std::find_if(begin, end, [index](const auto& entry) { return entry.second == index; }));
+				return;
+			}
+
+			auto next = m_Status.erase(m_Handles[index]);
+			m_Handles[index] = std::end(m_Status);
+			if (next != std::begin(m_Status) && next != std::end(m_Status))
+				checkNeighbours(*std::prev(next), *next);
+		}
+
+		void handleEvent(const VectorType& point, const Event& event, std::vector<std::size_t>& group)
+		{
+			++m_Stamp;
+			m_SweepPoint = point;
+
+			// the segments through the event point are neighbours in the status; the known ones (or the position of the point) serve as anchor
+			auto anchor = std::end(m_Status);
+			for (auto* indices : { &event.lower, &event.crossing })
+			{
+				for (auto index : *indices)
+				{
+					if (anchor == std::end(m_Status) && isInStatus(index))
+						anchor = m_Handles[index];
+				}
+			}
+			if (anchor == std::end(m_Status))
+				anchor = m_Status.lower_bound(point);
+
+			auto first = anchor;
+			while (first != std::begin(m_Status) && passesSweepPoint(*std::prev(first)))
+				--first;
+			auto last = anchor;
+			while (last != std::end(m_Status) && passesSweepPoint(*last))
+				++last;
+
+			// the passed range and the known segments form the group, which is re-inserted in the order right of the event point
+			std::vector<std::size_t> removed{ first, last };
+			for (auto index : removed)
+				stamp(index, group);
+			for (auto* indices : { &event.lower, &event.crossing })
+			{
+				for (auto index : *indices)
+				{
+					if (isInStatus(index))
+						stamp(index, group);
+				}
+			}
+			for (auto index : group)
+			{
+				m_Status.erase(m_Handles[index]);
+				m_Handles[index] = std::end(m_Status);
+			}
+			for (auto index : event.upper)
+				stamp(index, group);
+
+			auto lowest = std::end(m_Status);
+			auto highest = std::end(m_Status);
+			for (auto index : group)
+			{
+				auto& segment = m_Segments[index];
+				if (!segment.ended && segment.second == point)
+				{
+					segment.ended = true;
+					m_Stubs.emplace(segment.second.x() + segment.tolerance, index);
+					// a vertical stub would cover its whole extent, which can't be ordered by a single height
+					if (segment.vertical)
+					{
+						m_VerticalStubs.emplace(segment.second.y(), index);
+						continue;
+					}
+				}
+
+				auto handle = m_Status.insert(index).first;
+				m_Handles[index] = handle;
+				if (lowest == std::end(m_Status) || m_Status.key_comp()(index, *lowest))
+					lowest = handle;
+				if (highest == std::end(m_Status) || m_Status.key_comp()(*highest, index))
+					highest = handle;
+			}
+
+			if (lowest == std::end(m_Status))
+			{
+				auto upper = m_Status.lower_bound(point);
+				if (upper != std::begin(m_Status) && upper != std::end(m_Status))
+					checkNeighbours(*std::prev(upper), *upper);
+			}
+			else
+			{
+				if (lowest != std::begin(m_Status))
+					checkNeighbours(*std::prev(lowest), *lowest);
+				if (auto next = std::next(highest); next != std::end(m_Status))
+					checkNeighbours(*highest, *next);
+			}
+
+			auto tolerance = 64 * std::numeric_limits<T>::epsilon() * std::max(std::abs(point.x()), std::abs(point.y()));
+			for (auto iter = m_VerticalStubs.lower_bound(point.y() - tolerance); iter != std::end(m_VerticalStubs); ++iter)
+			{
+				if (m_Segments[iter->second].first.y() <= point.y() + tolerance)
+					stamp(iter->second, group);
+			}
+		}
+
+		// uses the same computation as intersection, thus both agree on every reported pair
+		void checkNeighbours(std::size_t lhs, std::size_t rhs)
+		{
+			auto& lhsLine = m_Segments[lhs].line;
+			auto [result, lhsDist, rhsDist] = intersectionImpl(lhsLine, m_Segments[rhs].line);
+			if (result != LineIntersectionResult::intersecting)
+				return;
+
+			auto point = lhsLine.location() + lhsLine.direction() * lhsDist;
+			if (pointLess(m_SweepPoint, point))
+			{
+				auto& event = m_Events[point];
+				event.crossing.push_back(lhs);
+				event.crossing.push_back(rhs);
+			}
+			else
+				m_PassedCrossings.emplace_back(lhs, rhs);
+		}
+	};
+}
+
+namespace georithm
+{
+	/* Invokes callback(lhsIndex, rhsIndex, result, lhsDist, rhsDist) once for each intersecting pair of segments, where lhsIndex is
+	 * always less than rhsIndex. result and both distances are the same as of intersection(segments[lhsIndex], segments[rhsIndex]),
+	 * thus overlapping segments are reported as collinear, while collinear segments without any common point aren't reported at all.
+	 * If callback returns false, the enumeration stops early.
+	 * Runs in O((N + K) log N) for N segments and K intersecting pairs. Only floating point segments are supported, because the sweep
+	 * has to compute the crossings as event points.
+	 */
+	template <std::ranges::random_access_range TRange, class TCallback>
+	requires NDimensionalLineObject<std::ranges::range_value_t<TRange>, 2> &&
+		(std::ranges::range_value_t<TRange>::type == LineType::segment) &&
+		std::floating_point<typename GeometricTraits<std::ranges::range_value_t<TRange>>::ValueType>
+	void forEachIntersectingPair(const TRange& segments, TCallback callback)
+	{
+		using T = typename GeometricTraits<std::ranges::range_value_t<TRange>>::ValueType;
+
+		// collinear segments share each group along their overlap and rounded crossings may emit the same pair twice
+		std::unordered_set<std::uint64_t> reported;
+		auto count = static_cast<std::uint64_t>(std::ranges::size(segments));
+		detail::SegmentSweep<T> sweep{ segments };
+		sweep.run([&](std::size_t lhs, std::size_t rhs)
+			{
+				auto lhsIndex = std::min(lhs, rhs);
+				auto rhsIndex = std::max(lhs, rhs);
+				if (!reported.insert(lhsIndex * count + rhsIndex).second)
+					return true;
+
+				auto [result, lhsDist, rhsDist] = intersection(segments[lhsIndex], segments[rhsIndex]);
+				return (result != LineIntersectionResult::intersecting && result != LineIntersectionResult::collinear) ||
+					detail::invokeTraversalCallback(callback, lhsIndex, rhsIndex, result, lhsDist, rhsDist);
+			}
+		);
+	}
+}
+
+#endif
@@ -0,0 +1,278 @@
+//          Copyright Dominic Koepke 2017 - 2020.
+// Distributed under the Boost Software License, Version 1.0.
+//    (See accompanying file LICENSE_1_0.txt or copy at
+//          https://www.boost.org/LICENSE_1_0.txt)
+
+#ifndef GEORITHM_THREAD_POOL_HPP
+#define GEORITHM_THREAD_POOL_HPP
+
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <cassert>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <exception>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <thread>
+#include <vector>
+
+#include "georithm/Executor.hpp"
+
+namespace georithm
+{
+	class ThreadPool;
+}
+
+namespace georithm::detail
+{
+	// the pool and queue of the worker running on this thread; threads outside of any pool share queue 0 of each pool
+	struct WorkerContext
+	{
+		const ThreadPool* pool = nullptr;
+		std::size_t queue = 0;
+	};
+
+	inline thread_local WorkerContext currentWorker;
+}
+
+namespace georithm
+{
+	/* Work stealing scheduler with a fixed set of worker threads. Each worker owns a deque of tasks; threads outside of the pool share
+	 * an additional one. parallelFor splits its chunks lazily into halves: the upper half gets pushed to the deque of the current
+	 * thread, while the thread goes on with the lower one. Owners take their newest tasks first, idle workers steal the oldest ones
+	 * (thus the largest ranges) from the other deques. Threads waiting for their chunks to finish execute pending tasks meanwhile,
+	 * thus nested calls from within a worker can't deadlock, even if all other workers are busy.
+	 */
+	class ThreadPool final :
+		public Executor
+	{
+	public:
+		// the calling thread counts as one of the threads, thus a pool of size 1 runs everything on the calling thread
+		explicit ThreadPool(std::size_t threadCount = std::max(1u, std::thread::hardware_concurrency())) :
+			m_Queues(threadCount)
+		{
+			assert(0 < threadCount);
+
+			m_Workers.reserve(threadCount - 1);
+			for (std::size_t i = 1; i < threadCount; ++i)
+				m_Workers.emplace_back([this, i]() { work(i); });
+		}
+
+		~ThreadPool() noexcept override
+		{
+			{
+				std::scoped_lock lock{ m_SleepMutex };
+				m_Stopped = true;
+			}
+			m_WakeCondition.notify_all();
+			for (auto& worker : m_Workers)
+				worker.join();
+		}
+
+		ThreadPool(const ThreadPool&) = delete;
+		ThreadPool& operator =(const ThreadPool&) = delete;
+
+		[[nodiscard]] std::size_t threadCount() const noexcept
+		{
+			return std::size(m_Workers) + 1;
+		}
+
+		[[nodiscard]] std::size_t concurrency() const noexcept override
+		{
+			return threadCount();
+		}
+
+	protected:
+		void runChunks(std::size_t chunkCount, ChunkFunctionRef runChunk) override
+		{
+			auto job = std::make_shared<Job>(runChunk, chunkCount);
+			run({ job, 0, chunkCount });
+
+			// the other threads may still split their ranges, thus look for tasks a few times before sleeping
+			constexpr int spinCount = 64;
+			int spins = 0;
+			for (auto remaining = job->remainingChunks.load(); 0 < remaining; remaining = job->remainingChunks.load())
+			{
+				if (auto task = takeTask(currentQueue()))
+					run(*task);
+				else if (spins++ < spinCount)
+					std::this_thread::yield();
+				else
+					job->remainingChunks.wait(remaining);
+			}
+
+			if (job->exception)
+				std::rethrow_exception(job->exception);
+		}
+
+	private:
+		// state of a single runChunks call, which is shared by all of its tasks; it lives until the last task has been destroyed
+		struct Job
+		{
+			Job(ChunkFunctionRef runChunk_, std::size_t chunkCount) noexcept :
+				runChunk{ runChunk_ },
+				remainingChunks{ chunkCount }
+			{
+			}
+
+			ChunkFunctionRef runChunk;
+			std::atomic<std::size_t> remainingChunks;
+			std::mutex exceptionMutex;
+			std::exception_ptr exception;
+		};
+
+		// range of chunks of a job
+		struct Task
+		{
+			std::shared_ptr<Job> job;
+			std::size_t begin;
+			std::size_t end;
+		};
+
+		struct Queue
+		{
+			std::mutex mutex;
+			std::deque<Task> tasks;
+		};
+
+		std::vector<Queue> m_Queues;
+		std::vector<std::thread> m_Workers;
+		// count of tasks in all queues; workers only sleep while it's 0
+		std::atomic<std::size_t> m_QueuedCount{ 0 };
+		std::mutex m_SleepMutex;
+		std::condition_variable m_WakeCondition;
+		bool m_Stopped = false;
+
+		[[nodiscard]] std::size_t currentQueue() const noexcept
+		{
+			return detail::currentWorker.pool == this ? detail::currentWorker.queue : 0;
+		}
+
+		void push(Task task)
+		{
+			// counted first, thus the count never falls below the actual count of queued tasks
+			++m_QueuedCount;
+			auto& queue = m_Queues[currentQueue()];
+			{
+				std::scoped_lock lock{ queue.mutex };
+				queue.tasks.emplace_back(std::move(task));
+			}
+			// locking prevents the notification from getting lost between the check and the wait of a falling asleep worker
+			{
+				std::scoped_lock lock{ m_SleepMutex };
+			}
+			m_WakeCondition.notify_one();
+		}
+
+		// the newest task of the own queue first, otherwise the oldest one of the next non-empty queue
+		[[nodiscard]] std::optional<Task> takeTask(std::size_t ownQueue)
+		{
+			if (m_QueuedCount.load() == 0)
+				return std::nullopt;
+
+			for (std::size_t i = 0; i < std::size(m_Queues); ++i)
+			{
+				auto& queue = m_Queues[(ownQueue + i) % std::size(m_Queues)];
+				std::scoped_lock lock{ queue.mutex };
+				if (std::empty(queue.tasks))
+					continue;
+
+				std::optional<Task> task;
+				if (i == 0)
+				{
+					task = std::move(queue.tasks.back());
+					queue.tasks.pop_back();
+				}
+				else
+				{
+					task = std::move(queue.tasks.front());
+					queue.tasks.pop_front();
+				}
+				--m_QueuedCount;
+				return task;
+			}
+			return std::nullopt;
+		}
+
+		void run(Task task) noexcept
+		{
+			auto& job = *task.job;
+			while (1 < task.end - task.begin)
+			{
+				auto middle = task.begin + (task.end - task.begin) / 2;
+				push({ task.job, middle, task.end });
+				task.end = middle;
+			}
+
+			try
+			{
+				job.runChunk(task.begin);
+			}
+			catch (...)
+			{
+				std::scoped_lock lock{ job.exceptionMutex };
+				if (!job.exception)
+					job.exception = std::current_exception();
+			}
+
+			if (--job.remainingChunks == 0)
+				job.remainingChunks.notify_all();
+		}
+
+		void work(std::size_t queue)
+		{
+			detail::currentWorker = { this, queue };
+			while (true)
+			{
+				if (auto task = takeTask(queue))
+				{
+					run(std::move(*task));
+					continue;
+				}
+
+				std::unique_lock lock{ m_SleepMutex };
+				m_WakeCondition.wait(lock, [this]() { return m_Stopped || 0 < m_QueuedCount.load(); });
+				if (m_Stopped && m_QueuedCount.load() == 0)
+					return;
+			}
+		}
+	};
+
+	// process wide pool with one thread per hardware thread, which is used by all parallel algorithms unless told otherwise
+	[[nodiscard]] inline ThreadPool& defaultThreadPool()
+	{
+		static ThreadPool pool;
+		return pool;
+	}
+}
+
+namespace georithm::detail
+{
+	inline std::atomic<Executor*> customDefaultExecutor{ nullptr };
+}
+
+namespace georithm
+{
+	/* Replaces the executor, which the parallel algorithms use unless told otherwise; nullptr restores defaultThreadPool(). Use it to
+	 * bound the threads of georithm per process (e.g. by a smaller ThreadPool) or to run everything on the task system of the
+	 * application. The executor must outlive all algorithms using it.
+	 */
+	inline void setDefaultExecutor(Executor* executor) noexcept
+	{
+		detail::customDefaultExecutor = executor;
+	}
+
+	[[nodiscard]] inline Executor& defaultExecutor()
+	{
+		if (auto executor = detail::customDefaultExecutor.load())
+			return *executor;
+		return defaultThreadPool();
+	}
+}
+
+#endif
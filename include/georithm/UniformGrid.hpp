@@ -0,0 +1,314 @@
+//          Copyright Dominic Koepke 2017 - 2020.
+// Distributed under the Boost Software License, Version 1.0.
+//    (See accompanying file LICENSE_1_0.txt or copy at
+//          https://www.boost.org/LICENSE_1_0.txt)
+
+#ifndef GEORITHM_UNIFORM_GRID_HPP
+#define GEORITHM_UNIFORM_GRID_HPP
+
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cassert>
+#include <cmath>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <limits>
+#include <ranges>
+#include <span>
+#include <type_traits>
+#include <vector>
+
+#include "georithm/Bounding.hpp"
+#include "georithm/Concepts.hpp"
+#include "georithm/Contains.hpp"
+#include "georithm/Rect.hpp"
+#include "georithm/Utility.hpp"
+#include "georithm/Vector.hpp"
+
+namespace georithm
+{
+	/* Uniform grid over the bounding rects of objects, which gets rebuilt from scratch instead of being updated. It suits many objects
+	 * of about the same size best; the cell size should be close to the size of a typical object. Each object is stored only once,
+	 * keyed by the cell of its top left corner; queries additionally visit the cells to the left and above the query area, as far as
+	 * the largest object of the grid reaches. Cells are hashed into a table of buckets, which keeps the grid unbounded.
+	 * A rebuild fills all buckets by a counting sort into a single array, where each entry holds a copy of the object bounds; thus
+	 * scanning a bucket doesn't touch any other memory.
+	 * Objects are identified by their index in the range of the last rebuild.
+	 */
+	template <class T>
+	class UniformGrid
+	{
+	public:
+		using ValueType = T;
+		using AABBType = AABB_t<T>;
+
+		explicit UniformGrid(T cellSize) noexcept :
+			m_CellSize{ cellSize }
+		{
+			assert(0 < cellSize);
+		}
+
+		template <std::ranges::input_range TObjects>
+		requires BoundedObject<std::ranges::range_value_t<TObjects>, T>
+		void rebuild(const TObjects& objects)
+		{
+			m_Bounds.clear();
+			if constexpr (std::ranges::sized_range<TObjects>)
+				m_Bounds.reserve(std::ranges::size(objects));
+			for (const auto& object : objects)
+				m_Bounds.emplace_back(detail::boundingRectAs<T>(object));
+			assert(std::size(m_Bounds) <= std::numeric_limits<Index_t>::max());
+
+			auto bucketCount = std::bit_ceil(std::max<std::size_t>(std::size(m_Bounds), 1));
+			m_Mask = bucketCount - 1;
+			m_Reach = Cell_t::zero();
+			m_Offsets.assign(bucketCount + 1, 0);
+			m_ObjectBuckets.resize(std::size(m_Bounds));
+			for (std::size_t i = 0; i < std::size(m_Bounds); ++i)
+			{
+				auto range = cellRange(m_Bounds[i]);
+				m_Reach.x() = std::max(m_Reach.x(), range.max.x() - range.min.x());
+				m_Reach.y() = std::max(m_Reach.y(), range.max.y() - range.min.y());
+				auto bucket = bucketOf(range.min.x(), range.min.y());
+				m_ObjectBuckets[i] = static_cast<Index_t>(bucket);
+				++m_Offsets[bucket];
+			}
+			for (std::size_t i = 1; i < std::size(m_Offsets); ++i)
+				m_Offsets[i] += m_Offsets[i - 1];
+
+			// the offsets are at the bucket ends now; filling each bucket from its end moves them to the bucket begins
+			m_Entries.resize(std::size(m_Bounds));
+			for (std::size_t i = std::size(m_Bounds); 0 < i--;)
+				m_Entries[--m_Offsets[m_ObjectBuckets[i]]] = { m_Bounds[i], static_cast<Index_t>(i) };
+		}
+
+		void clear() noexcept
+		{
+			m_Bounds.clear();
+			m_Entries.clear();
+			m_Offsets.clear();
+			m_ObjectBuckets.clear();
+			m_Mask = 0;
+			m_Reach = Cell_t::zero();
+		}
+
+		[[nodiscard]] T cellSize() const noexcept
+		{
+			return m_CellSize;
+		}
+
+		[[nodiscard]] std::size_t size() const noexcept
+		{
+			return std::size(m_Bounds);
+		}
+
+		[[nodiscard]] bool empty() const noexcept
+		{
+			return std::empty(m_Bounds);
+		}
+
+		[[nodiscard]] const AABBType& bounds(std::size_t index) const noexcept
+		{
+			assert(index < size());
+			return m_Bounds[index];
+		}
+
+		/* Invokes callback(index) for each object, whose bounds intersect (or touch) the bounding rect of object.
+		 * If callback returns false, the query stops early.
+		 */
+		template <BoundedObject<T> TObject, class TCallback>
+		requires std::invocable<TCallback&, std::size_t>
+		void query(const TObject& object, TCallback callback) const
+		{
+			if (empty())
+				return;
+
+			auto bounds = detail::boundingRectAs<T>(object);
+			forEachBucket(candidateRange(cellRange(bounds)), [&](std::size_t bucket)
+				{
+					for (auto& entry : bucketEntries(bucket))
+					{
+						if (detail::intersectsBounds(bounds, entry.bounds) && !detail::invokeTraversalCallback(callback, static_cast<std::size_t>(entry.index)))
+							return false;
+					}
+					return true;
+				}
+			);
+		}
+
+		/* Invokes callback(index) for each object, whose bounds contain point.
+		 * If callback returns false, the query stops early.
+		 */
+		template <NDimensionalVectorObject<2> TVector, class TCallback>
+		requires std::is_same_v<typename TVector::ValueType, T> && std::invocable<TCallback&, std::size_t>
+		void queryPoint(const TVector& point, TCallback callback) const
+		{
+			if (empty())
+				return;
+
+			Cell_t cell{ cellCoordinate(point.x()), cellCoordinate(point.y()) };
+			forEachBucket(candidateRange({ cell, cell }), [&](std::size_t bucket)
+				{
+					for (auto& entry : bucketEntries(bucket))
+					{
+						if (detail::contains(entry.bounds, point) && !detail::invokeTraversalCallback(callback, static_cast<std::size_t>(entry.index)))
+							return false;
+					}
+					return true;
+				}
+			);
+		}
+
+		/* Invokes callback(lhsIndex, rhsIndex) once for each unordered pair of objects with intersecting (or touching) bounds;
+		 * lhsIndex is always less than rhsIndex. If callback returns false, the enumeration stops early.
+		 */
+		template <class TCallback>
+		requires std::invocable<TCallback&, std::size_t, std::size_t>
+		void forEachOverlappingPair(TCallback callback) const
+		{
+			// walking the entries in bucket order keeps the visited neighbourhood of consecutive entries mostly cached
+			for (auto& lhs : m_Entries)
+			{
+				auto proceed = forEachBucket(candidateRange(cellRange(lhs.bounds)), [&](std::size_t bucket)
+					{
+						for (auto& rhs : bucketEntries(bucket))
+						{
+							if (lhs.index < rhs.index && detail::intersectsBounds(lhs.bounds, rhs.bounds) &&
+								!detail::invokeTraversalCallback(callback, static_cast<std::size_t>(lhs.index), static_cast<std::size_t>(rhs.index)))
+								return false;
+						}
+						return true;
+					}
+				);
+				if (!proceed)
+					return;
+			}
+		}
+
+	private:
+		using Index_t = std::uint32_t;
+		using Cell_t = Vector<std::int64_t, 2>;
+
+		struct Entry
+		{
+			AABBType bounds;
+			Index_t index;
+		};
+
+		struct CellRange
+		{
+			Cell_t min;
+			Cell_t max;
+		};
+
+		// buckets of large cell ranges are deduplicated by sorting, small ones by a linear search
+		constexpr static std::size_t inlineCellCount = 16;
+
+		T m_CellSize;
+		std::vector<AABBType> m_Bounds;
+		std::vector<Entry> m_Entries;
+		// entries of bucket i are in range [m_Offsets[i], m_Offsets[i + 1])
+		std::vector<Index_t> m_Offsets;
+		// bucket of each object; only used during the rebuild, but kept to avoid reallocations
+		std::vector<Index_t> m_ObjectBuckets;
+		std::size_t m_Mask = 0;
+		// the largest distance in cells between the top left and the bottom right cell of any object
+		Cell_t m_Reach = Cell_t::zero();
+
+		[[nodiscard]] std::int64_t cellCoordinate(T value) const noexcept
+		{
+			if constexpr (std::integral<T>)
+			{
+				auto quotient = static_cast<std::int64_t>(value / m_CellSize);
+				return value % m_CellSize < 0 ? quotient - 1 : quotient;
+			}
+			else
+			{
+				// cheaper than std::floor, which is a library call without SSE4.1
+				auto quotient = value / m_CellSize;
+				auto truncated = static_cast<std::int64_t>(quotient);
+				return quotient < static_cast<T>(truncated) ? truncated - 1 : truncated;
+			}
+		}
+
+		// expects normalized bounds
+		[[nodiscard]] CellRange cellRange(const AABBType& bounds) const noexcept
+		{
+			auto topLeft = detail::topLeftBounding(bounds);
+			auto bottomRight = detail::bottomRightBounding(bounds);
+			return { { cellCoordinate(topLeft.x()), cellCoordinate(topLeft.y()) }, { cellCoordinate(bottomRight.x()), cellCoordinate(bottomRight.y()) } };
+		}
+
+		// objects, which intersect the cell range, have their top left corner within the returned range
+		[[nodiscard]] CellRange candidateRange(const CellRange& range) const noexcept
+		{
+			return { range.min - m_Reach, range.max };
+		}
+
+		[[nodiscard]] std::size_t bucketOf(std::int64_t x, std::int64_t y) const noexcept
+		{
+			auto hash = static_cast<std::uint64_t>(x) * 0x9E3779B97F4A7C15ull ^ static_cast<std::uint64_t>(y) * 0xC2B2AE3D27D4EB4Full;
+			return static_cast<std::size_t>(hash ^ (hash >> 32)) & m_Mask;
+		}
+
+		[[nodiscard]] std::span<const Entry> bucketEntries(std::size_t bucket) const noexcept
+		{
+			return { std::data(m_Entries) + m_Offsets[bucket], std::data(m_Entries) + m_Offsets[bucket + 1] };
+		}
+
+		// invokes func(bucket) once for each distinct bucket of the cell range; returns false, if func stopped the iteration
+		template <class TFunc>
+		bool forEachBucket(const CellRange& range, TFunc func) const
+		{
+			auto width = static_cast<std::uint64_t>(range.max.x() - range.min.x()) + 1;
+			auto height = static_cast<std::uint64_t>(range.max.y() - range.min.y()) + 1;
+			auto bucketCount = static_cast<std::uint64_t>(m_Mask) + 1;
+			if (bucketCount <= width || bucketCount <= height || bucketCount <= width * height)
+			{
+				for (std::size_t bucket = 0; bucket < bucketCount; ++bucket)
+				{
+					if (!func(bucket))
+						return false;
+				}
+				return true;
+			}
+
+			if (width * height <= inlineCellCount)
+			{
+				std::array<std::size_t, inlineCellCount> buckets;
+				std::size_t count = 0;
+				for (auto y = range.min.y(); y <= range.max.y(); ++y)
+				{
+					for (auto x = range.min.x(); x <= range.max.x(); ++x)
+					{
+						auto bucket = bucketOf(x, y);
+						if (std::find(std::begin(buckets), std::begin(buckets) + count, bucket) != std::begin(buckets) + count)
+							continue;
+						buckets[count++] = bucket;
+						if (!func(bucket))
+							return false;
+					}
+				}
+				return true;
+			}
+
+			std::vector<std::size_t> buckets;
+			buckets.reserve(width * height);
+			for (auto y = range.min.y(); y <= range.max.y(); ++y)
+			{
+				for (auto x = range.min.x(); x <= range.max.x(); ++x)
+					buckets.emplace_back(bucketOf(x, y));
+			}
+			std::ranges::sort(buckets);
+			auto [last, end] = std::ranges::unique(buckets);
+			return std::all_of(std::begin(buckets), last, std::ref(func));
+		}
+	};
+}
+
+#endif
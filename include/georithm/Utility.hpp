@@ -8,11 +8,17 @@
 
 #pragma once
 
+#include <array>
 #include <cassert>
 #include <concepts>
+#include <cstdint>
+#include <functional>
+#include <type_traits>
+#include <vector>
 
 #include "georithm/Concepts.hpp"
 #include "georithm/Defines.hpp"
+#include "georithm/GeometricTraits.hpp"
 
 namespace georithm
 {
@@ -56,6 +62,65 @@ namespace georithm
 	{
 		return object.edge(index);
 	}
+
+	// specialize this for polygon types with a fixed amount of vertices; algorithms may then avoid dynamic allocations
+	template <class T>
+	struct StaticVertexCount :
+		std::integral_constant<VertexIndex_t, 0>
+	{
+	};
+
+	template <class T>
+	constexpr VertexIndex_t StaticVertexCount_v = StaticVertexCount<std::remove_cvref_t<T>>::value;
+}
+
+namespace georithm::detail
+{
+	// evaluates each vertex exactly once, which is beneficial for polygons with expensive vertex() implementations (e.g. transformed Rects)
+	template <PolygonalObject TPolygon>
+	[[nodiscard]] constexpr auto collectVertices(const TPolygon& polygon)
+	{
+		using Vector_t = typename GeometricTraits<TPolygon>::VectorType;
+		if constexpr (0 < StaticVertexCount_v<TPolygon>)
+		{
+			std::array<Vector_t, StaticVertexCount_v<TPolygon>> vertices;
+			for (VertexIndex_t i = 0; i < std::size(vertices); ++i)
+				vertices[i] = vertex(polygon, i);
+			return vertices;
+		}
+		else
+		{
+			std::vector<Vector_t> vertices;
+			auto count = vertexCount(polygon);
+			vertices.reserve(count);
+			for (VertexIndex_t i = 0; i < count; ++i)
+				vertices.emplace_back(vertex(polygon, i));
+			return vertices;
+		}
+	}
+
+	// traversal callbacks may either return void or something convertible to bool; returning false stops the traversal
+	template <class TCallback, class... TArgs>
+	constexpr bool invokeTraversalCallback(TCallback& callback, TArgs&&... args)
+	{
+		if constexpr (std::is_void_v<std::invoke_result_t<TCallback&, TArgs...>>)
+		{
+			std::invoke(callback, std::forward<TArgs>(args)...);
+			return true;
+		}
+		else
+			return static_cast<bool>(std::invoke(callback, std::forward<TArgs>(args)...));
+	}
+
+	// spreads the lower 16 bits to the even bit positions
+	[[nodiscard]] constexpr std::uint32_t interleaveBits(std::uint32_t value) noexcept
+	{
+		value = (value | (value << 8)) & 0x00FF00FFu;
+		value = (value | (value << 4)) & 0x0F0F0F0Fu;
+		value = (value | (value << 2)) & 0x33333333u;
+		value = (value | (value << 1)) & 0x55555555u;
+		return value;
+	}
 }
 
 #endif
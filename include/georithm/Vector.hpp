@@ -14,18 +14,27 @@
 #include <cmath>
 #include <concepts>
 #include <functional>
+#include <iterator>
 #include <numeric>
+#include <type_traits>
 
 #include "georithm/ArithmeticOperators.hpp"
 #include "georithm/Concepts.hpp"
+#include "georithm/Simd.hpp"
 
 namespace georithm
 {
+	/* When GEORITHM_SIMD is defined, Vector<float, 4>, Vector<double, 2>, Vector<float, 3> (padded to 4 elements) and, if AVX is
+	 * available, Vector<double, 4> are stored aligned and their arithmetic is computed in simd registers. The values of the padding
+	 * element are neither observable through the iterators nor through the subscript operators.
+	 */
 	template <ValueType T, DimensionDescriptor_t TDim>
 	requires Cardinality<TDim>
 	class Vector :
 		private Arithmetic
 	{
+		using Register_t = detail::simd::Register<T, TDim>;
+
 	public:
 		using ValueType = T;
 		using DimensionDescriptorType = DimensionDescriptor_t;
@@ -63,7 +72,7 @@ namespace georithm
 		[[nodiscard]] constexpr static Vector make(const T& value) noexcept
 		{
 			Vector tmp;
-			tmp.m_Values.fill(value);
+			std::fill(std::begin(tmp), std::end(tmp), value);
 			return tmp;
 		}
 
@@ -130,10 +139,19 @@ namespace georithm
 		requires Addable<T, T2>
 		constexpr Vector& operator +=(const Vector<T2, TDim>& other) noexcept
 		{
-			std::transform(std::cbegin(m_Values),
-							std::cend(m_Values),
-							std::cbegin(other.m_Values),
-							std::begin(m_Values),
+			if constexpr (Register_t::supported && std::is_same_v<T, T2>)
+			{
+				if (!std::is_constant_evaluated())
+				{
+					Register_t::store(std::data(m_Values), Register_t::add(Register_t::load(std::data(m_Values)), Register_t::load(&other[0])));
+					return *this;
+				}
+			}
+
+			std::transform(cbegin(),
+							cend(),
+							std::cbegin(other),
+							begin(),
 							[](const auto& lhs, const auto& rhs) { return lhs + static_cast<T>(rhs); }
 						);
 			return *this;
@@ -143,10 +161,19 @@ namespace georithm
 		requires Subtractable<T, T2>
 		constexpr Vector& operator -=(const Vector<T2, TDim>& other) noexcept
 		{
-			std::transform(std::cbegin(m_Values),
-							std::cend(m_Values),
-							std::cbegin(other.m_Values),
-							std::begin(m_Values),
+			if constexpr (Register_t::supported && std::is_same_v<T, T2>)
+			{
+				if (!std::is_constant_evaluated())
+				{
+					Register_t::store(std::data(m_Values), Register_t::sub(Register_t::load(std::data(m_Values)), Register_t::load(&other[0])));
+					return *this;
+				}
+			}
+
+			std::transform(cbegin(),
+							cend(),
+							std::cbegin(other),
+							begin(),
 							[](const auto& lhs, const auto& rhs) { return lhs - static_cast<T>(rhs); }
 						);
 			return *this;
@@ -156,8 +183,18 @@ namespace georithm
 		requires Addable<T, T2>
 		constexpr Vector& operator +=(const T2& other) noexcept
 		{
-			std::for_each(std::begin(m_Values),
-						std::end(m_Values),
+			if constexpr (Register_t::supported)
+			{
+				if (!std::is_constant_evaluated())
+				{
+					const auto value = Register_t::broadcast(static_cast<T>(other), T(0));
+					Register_t::store(std::data(m_Values), Register_t::add(Register_t::load(std::data(m_Values)), value));
+					return *this;
+				}
+			}
+
+			std::for_each(begin(),
+						end(),
 						[&other](auto& lhs) { return lhs += static_cast<T>(other); }
 						);
 			return *this;
@@ -167,8 +204,18 @@ namespace georithm
 		requires Subtractable<T, T2>
 		constexpr Vector& operator -=(const T2& other) noexcept
 		{
-			std::for_each(std::begin(m_Values),
-						std::end(m_Values),
+			if constexpr (Register_t::supported)
+			{
+				if (!std::is_constant_evaluated())
+				{
+					const auto value = Register_t::broadcast(static_cast<T>(other), T(0));
+					Register_t::store(std::data(m_Values), Register_t::sub(Register_t::load(std::data(m_Values)), value));
+					return *this;
+				}
+			}
+
+			std::for_each(begin(),
+						end(),
 						[&other](auto& lhs) { lhs -= static_cast<T>(other); }
 						);
 			return *this;
@@ -178,22 +225,28 @@ namespace georithm
 		requires Multiplicable<T, T2>
 		constexpr Vector& operator *=(const T2& other) noexcept
 		{
-			std::for_each(std::begin(m_Values),
-						std::end(m_Values),
+			if constexpr (Register_t::supported)
+			{
+				if (!std::is_constant_evaluated())
+				{
+					const auto value = Register_t::broadcast(static_cast<T>(other), T(0));
+					Register_t::store(std::data(m_Values), Register_t::mul(Register_t::load(std::data(m_Values)), value));
+					return *this;
+				}
+			}
+
+			std::for_each(begin(),
+						end(),
 						[&other](auto& lhs) { lhs *= static_cast<T>(other); }
 						);
 			return *this;
 		}
 
 		template <class T2>
-		requires Multiplicable<T2, T>
-		friend Vector operator *(const T2& lhs, Vector rhs) noexcept
+		requires Multiplicable<T, T2>
+		friend constexpr Vector operator *(const T2& lhs, Vector rhs) noexcept
 		{
-			std::for_each(std::begin(rhs),
-						std::end(rhs),
-						[&lhs](auto& el) { el *= static_cast<T>(lhs); }
-						);
-			return rhs;
+			return rhs *= lhs;
 		}
 
 		template <class T2>
@@ -201,8 +254,18 @@ namespace georithm
 		constexpr Vector& operator /=(const T2& other) noexcept
 		{
 			assert(other != T2(0));
-			std::for_each(std::begin(m_Values),
-						std::end(m_Values),
+			if constexpr (Register_t::supported)
+			{
+				if (!std::is_constant_evaluated())
+				{
+					const auto value = Register_t::broadcast(static_cast<T>(other), T(1));
+					Register_t::store(std::data(m_Values), Register_t::div(Register_t::load(std::data(m_Values)), value));
+					return *this;
+				}
+			}
+
+			std::for_each(begin(),
+						end(),
 						[&other](auto& lhs) { lhs /= static_cast<T>(other); }
 						);
 			return *this;
@@ -213,8 +276,8 @@ namespace georithm
 		constexpr Vector& operator %=(const T2& other) noexcept
 		{
 			assert(other != T2(0));
-			std::for_each(std::begin(m_Values),
-						std::end(m_Values),
+			std::for_each(begin(),
+						end(),
 						[&other](auto& lhs) { lhs %= other; }
 						);
 			return *this;
@@ -237,62 +300,93 @@ namespace georithm
 
 		constexpr auto end() noexcept
 		{
-			return std::end(m_Values);
+			return std::begin(m_Values) + dimensions;
 		}
 
 		[[nodiscard]] constexpr auto end() const noexcept
 		{
-			return std::end(m_Values);
+			return std::begin(m_Values) + dimensions;
 		}
 
 		[[nodiscard]] constexpr auto cend() const noexcept
 		{
-			return std::cend(m_Values);
+			return std::cbegin(m_Values) + dimensions;
 		}
 
 		constexpr auto rbegin() noexcept
 		{
-			return std::rbegin(m_Values);
+			return std::make_reverse_iterator(end());
 		}
 
 		[[nodiscard]] constexpr auto rbegin() const noexcept
 		{
-			return std::rbegin(m_Values);
+			return std::make_reverse_iterator(end());
 		}
 
 		[[nodiscard]] constexpr auto crbegin() const noexcept
 		{
-			return std::crbegin(m_Values);
+			return std::make_reverse_iterator(cend());
 		}
 
 		constexpr auto rend() noexcept
 		{
-			return std::rend(m_Values);
+			return std::make_reverse_iterator(begin());
 		}
 
 		[[nodiscard]] constexpr auto rend() const noexcept
 		{
-			return std::rend(m_Values);
+			return std::make_reverse_iterator(begin());
 		}
 
 		[[nodiscard]] constexpr auto crend() const noexcept
 		{
-			return std::crend(m_Values);
+			return std::make_reverse_iterator(cbegin());
 		}
 
 	private:
-		std::array<T, dimensions> m_Values{};
+		alignas(Register_t::alignment) std::array<T, Register_t::storageSize> m_Values{};
 	};
 
 	template <class... T>
 	Vector(T&&...) -> Vector<std::common_type_t<T...>, sizeof...(T)>;
 
+	namespace detail
+	{
+		template <class T>
+		struct IsSimdVector :
+			std::false_type
+		{
+		};
+
+		template <class T, DimensionDescriptor_t TDim>
+		struct IsSimdVector<Vector<T, TDim>> :
+			std::bool_constant<simd::Register<T, TDim>::supported>
+		{
+		};
+
+		template <class T>
+		constexpr bool IsSimdVector_v = IsSimdVector<std::remove_cvref_t<T>>::value;
+
+		template <class T, DimensionDescriptor_t TDim>
+		[[nodiscard]] T simdDot(const Vector<T, TDim>& lhs, const Vector<T, TDim>& rhs) noexcept
+		{
+			using Register_t = simd::Register<T, TDim>;
+			return Register_t::dot(Register_t::load(&lhs[0]), Register_t::load(&rhs[0]));
+		}
+	}
+
 	template <VectorObject TVector>
 	requires ConstForwardIteratable<TVector>
 	[[nodiscard]] constexpr typename TVector::ValueType lengthSq(const TVector& vector) noexcept
 	{
+		if constexpr (detail::IsSimdVector_v<TVector>)
+		{
+			if (!std::is_constant_evaluated())
+				return detail::simdDot(vector, vector);
+		}
+
 		using T = typename TVector::ValueType;
-		return std::reduce(std::cbegin(vector),
+		return std::accumulate(std::cbegin(vector),
 							std::cend(vector),
 							typename TVector::ValueType{},
 							[](T value, T element) { return value + element * element; }
@@ -305,6 +399,12 @@ namespace georithm
 	Multiplicable<typename TVector1::ValueType, typename TVector2::ValueType>
 	[[nodiscard]] constexpr typename TVector1::ValueType scalarProduct(const TVector1& lhs, const TVector2& rhs) noexcept
 	{
+		if constexpr (detail::IsSimdVector_v<TVector1> && std::is_same_v<TVector1, TVector2>)
+		{
+			if (!std::is_constant_evaluated())
+				return detail::simdDot(lhs, rhs);
+		}
+
 		return std::transform_reduce(std::cbegin(lhs),
 									std::cend(lhs),
 									std::cbegin(rhs),
@@ -0,0 +1,373 @@
+//          Copyright Dominic Koepke 2017 - 2020.
+// Distributed under the Boost Software License, Version 1.0.
+//    (See accompanying file LICENSE_1_0.txt or copy at
+//          https://www.boost.org/LICENSE_1_0.txt)
+
+#ifndef GEORITHM_VECTOR_SOA_HPP
+#define GEORITHM_VECTOR_SOA_HPP
+
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cassert>
+#include <cmath>
+#include <concepts>
+#include <cstddef>
+#include <ranges>
+#include <span>
+#include <type_traits>
+#include <vector>
+
+#include "georithm/Concepts.hpp"
+#include "georithm/Execution.hpp"
+#include "georithm/Vector.hpp"
+
+namespace georithm
+{
+	/* Stores a collection of vectors as structure of arrays; each dimension has its own contiguous lane. The batch algorithms below are
+	 * plain loops over those lanes, which the compiler is able to vectorize across multiple vectors.
+	 */
+	template <ValueType T, DimensionDescriptor_t TDim>
+	requires Cardinality<TDim>
+	class VectorSoA
+	{
+	public:
+		using ValueType = T;
+		using VectorType = Vector<T, TDim>;
+		using DimensionDescriptorType = DimensionDescriptor_t;
+		constexpr static DimensionDescriptorType dimensions{ TDim };
+
+		VectorSoA() noexcept = default;
+		~VectorSoA() noexcept = default;
+
+		explicit VectorSoA(std::size_t size)
+		{
+			resize(size);
+		}
+
+		template <std::ranges::input_range TRange>
+		requires std::convertible_to<std::ranges::range_value_t<TRange>, VectorType>
+		explicit VectorSoA(const TRange& vectors)
+		{
+			if constexpr (std::ranges::sized_range<TRange>)
+				reserve(std::ranges::size(vectors));
+
+			for (const VectorType& vector : vectors)
+				push_back(vector);
+		}
+
+		VectorSoA(const VectorSoA&) = default;
+		VectorSoA& operator =(const VectorSoA&) = default;
+		VectorSoA(VectorSoA&&) noexcept = default;
+		VectorSoA& operator =(VectorSoA&&) noexcept = default;
+
+		[[nodiscard]] bool operator ==(const VectorSoA&) const = default;
+
+		[[nodiscard]] std::size_t size() const noexcept
+		{
+			return std::size(m_Lanes[0]);
+		}
+
+		[[nodiscard]] bool empty() const noexcept
+		{
+			return std::empty(m_Lanes[0]);
+		}
+
+		void resize(std::size_t size)
+		{
+			for (auto& lane : m_Lanes)
+				lane.resize(size);
+		}
+
+		void reserve(std::size_t size)
+		{
+			for (auto& lane : m_Lanes)
+				lane.reserve(size);
+		}
+
+		void clear() noexcept
+		{
+			for (auto& lane : m_Lanes)
+				lane.clear();
+		}
+
+		void push_back(const VectorType& vector)
+		{
+			for (DimensionDescriptorType i = 0; i < dimensions; ++i)
+				m_Lanes[i].push_back(vector[i]);
+		}
+
+		[[nodiscard]] VectorType operator [](std::size_t index) const noexcept
+		{
+			assert(index < size());
+
+			VectorType vector;
+			for (DimensionDescriptorType i = 0; i < dimensions; ++i)
+				vector[i] = m_Lanes[i][index];
+			return vector;
+		}
+
+		void set(std::size_t index, const VectorType& vector) noexcept
+		{
+			assert(index < size());
+
+			for (DimensionDescriptorType i = 0; i < dimensions; ++i)
+				m_Lanes[i][index] = vector[i];
+		}
+
+		[[nodiscard]] std::span<T> lane(DimensionDescriptorType dimension) noexcept
+		{
+			assert(dimension < dimensions);
+			return m_Lanes[dimension];
+		}
+
+		[[nodiscard]] std::span<const T> lane(DimensionDescriptorType dimension) const noexcept
+		{
+			assert(dimension < dimensions);
+			return m_Lanes[dimension];
+		}
+
+	private:
+		std::array<std::vector<T>, dimensions> m_Lanes;
+	};
+
+}
+
+namespace georithm::detail
+{
+	constexpr std::size_t soaBlockSize = 256;
+
+	// the lengths of each block are held in a local buffer, which can't alias the lanes, thus all loops get vectorized
+	template <std::floating_point T, DimensionDescriptor_t TDim>
+	void normalizeBatch(VectorSoA<T, TDim>& vectors, std::size_t begin, std::size_t end) noexcept
+	{
+		assert(begin <= end && end <= std::size(vectors));
+
+		std::array<T, soaBlockSize> lengths;
+		for (auto blockBegin = begin; blockBegin < end; blockBegin += soaBlockSize)
+		{
+			const auto count = std::min(soaBlockSize, end - blockBegin);
+			auto* lane0 = std::data(vectors.lane(0)) + blockBegin;
+			for (std::size_t i = 0; i < count; ++i)
+				lengths[i] = lane0[i] * lane0[i];
+			for (DimensionDescriptor_t dim = 1; dim < TDim; ++dim)
+			{
+				auto* lane = std::data(vectors.lane(dim)) + blockBegin;
+				for (std::size_t i = 0; i < count; ++i)
+					lengths[i] += lane[i] * lane[i];
+			}
+			for (std::size_t i = 0; i < count; ++i)
+			{
+				assert(lengths[i] != 0);
+				lengths[i] = static_cast<T>(std::sqrt(lengths[i]));
+			}
+
+			for (DimensionDescriptor_t dim = 0; dim < TDim; ++dim)
+			{
+				auto* values = std::data(vectors.lane(dim)) + blockBegin;
+				for (std::size_t i = 0; i < count; ++i)
+					values[i] /= lengths[i];
+			}
+		}
+	}
+
+	template <class T, std::floating_point TArc>
+	void rotateBatch(VectorSoA<T, 2>& vectors, std::size_t begin, std::size_t end, TArc sin, TArc cos) noexcept
+	{
+		assert(begin <= end && end <= std::size(vectors));
+
+		auto* xs = std::data(vectors.lane(0));
+		auto* ys = std::data(vectors.lane(1));
+		for (auto i = begin; i < end; ++i)
+		{
+			if constexpr (std::is_same_v<T, TArc>)
+			{
+				auto x = xs[i];
+				auto y = ys[i];
+				xs[i] = cos * x - sin * y;
+				ys[i] = sin * x + cos * y;
+			}
+			else
+			{
+				auto x = static_cast<TArc>(xs[i]);
+				auto y = static_cast<TArc>(ys[i]);
+				xs[i] = static_cast<T>(std::round(cos * x - sin * y));
+				ys[i] = static_cast<T>(std::round(sin * x + cos * y));
+			}
+		}
+	}
+
+	template <ExecutionPolicy TPolicy, class T, std::floating_point TArc>
+	void rotateChunks(const TPolicy& policy, VectorSoA<T, 2>& vectors, TArc radian)
+	{
+		if constexpr (IsUnsequencedPolicy_v<TPolicy>)
+		{
+			const auto sin = std::sin(radian);
+			const auto cos = std::cos(radian);
+			forEachChunk(policy, std::size(vectors), [&](std::size_t begin, std::size_t end) { rotateBatch(vectors, begin, end, sin, cos); });
+		}
+		else
+		{
+			forEachChunk(policy, std::size(vectors), [&](std::size_t begin, std::size_t end)
+				{
+					for (auto i = begin; i < end; ++i)
+						vectors.set(i, rotate(vectors[i], radian));
+				}
+			);
+		}
+	}
+}
+
+namespace georithm
+{
+	template <class T, DimensionDescriptor_t TDim>
+	void lengthSq(const VectorSoA<T, TDim>& vectors, std::span<T> out) noexcept
+	{
+		assert(std::size(out) == std::size(vectors));
+
+		const auto count = std::size(vectors);
+		auto* result = std::data(out);
+		auto* lane0 = std::data(vectors.lane(0));
+		for (std::size_t i = 0; i < count; ++i)
+			result[i] = lane0[i] * lane0[i];
+
+		for (DimensionDescriptor_t dim = 1; dim < TDim; ++dim)
+		{
+			auto* lane = std::data(vectors.lane(dim));
+			for (std::size_t i = 0; i < count; ++i)
+				result[i] += lane[i] * lane[i];
+		}
+	}
+
+	template <class T, DimensionDescriptor_t TDim>
+	void length(const VectorSoA<T, TDim>& vectors, std::span<T> out) noexcept
+	{
+		lengthSq(vectors, out);
+		for (auto& value : out)
+			value = static_cast<T>(std::sqrt(value));
+	}
+
+	template <class T, DimensionDescriptor_t TDim>
+	void scalarProduct(const VectorSoA<T, TDim>& lhs, const VectorSoA<T, TDim>& rhs, std::span<T> out) noexcept
+	{
+		assert(std::size(lhs) == std::size(rhs) && std::size(out) == std::size(lhs));
+
+		const auto count = std::size(lhs);
+		auto* result = std::data(out);
+		std::fill_n(result, count, T{});
+		for (DimensionDescriptor_t dim = 0; dim < TDim; ++dim)
+		{
+			auto* lhsLane = std::data(lhs.lane(dim));
+			auto* rhsLane = std::data(rhs.lane(dim));
+			for (std::size_t i = 0; i < count; ++i)
+				result[i] += lhsLane[i] * rhsLane[i];
+		}
+	}
+
+	// applies op onto each element of each lane
+	template <class T, DimensionDescriptor_t TDim, invocable_r<T, T> TUnaryOp>
+	[[nodiscard]] VectorSoA<T, TDim> transmute(VectorSoA<T, TDim> vectors, TUnaryOp op) noexcept(std::is_nothrow_invocable_v<TUnaryOp, T>)
+	{
+		for (DimensionDescriptor_t dim = 0; dim < TDim; ++dim)
+		{
+			auto lane = vectors.lane(dim);
+			auto* values = std::data(lane);
+			for (std::size_t i = 0, count = std::size(lane); i < count; ++i)
+				values[i] = op(values[i]);
+		}
+		return vectors;
+	}
+
+	template <std::floating_point T, DimensionDescriptor_t TDim>
+	[[nodiscard]] VectorSoA<T, TDim> normalize(VectorSoA<T, TDim> vectors) noexcept
+	{
+		detail::normalizeBatch(vectors, 0, std::size(vectors));
+		return vectors;
+	}
+
+	/* seq normalizes the vectors one by one as the single normalize does, while the unsequenced policies run the lane wise kernel;
+	 * the parallel policies split the vectors into chunks. All policies yield the same vectors.
+	 */
+	template <ExecutionPolicy TPolicy, std::floating_point T, DimensionDescriptor_t TDim>
+	[[nodiscard]] VectorSoA<T, TDim> normalize(const TPolicy& policy, VectorSoA<T, TDim> vectors)
+	{
+		detail::forEachChunk(policy, std::size(vectors), [&vectors](std::size_t begin, std::size_t end)
+			{
+				if constexpr (detail::IsUnsequencedPolicy_v<TPolicy>)
+					detail::normalizeBatch(vectors, begin, end);
+				else
+				{
+					for (auto i = begin; i < end; ++i)
+						vectors.set(i, normalize(vectors[i]));
+				}
+			}
+		);
+		return vectors;
+	}
+
+	template <class T, DimensionDescriptor_t TDim>
+	requires std::floating_point<T> || std::signed_integral<T>
+	[[nodiscard]] VectorSoA<T, TDim> abs(VectorSoA<T, TDim> vectors) noexcept
+	{
+		return transmute(std::move(vectors), [](T element) { return element < 0 ? -element : element; });
+	}
+
+	template <class T, DimensionDescriptor_t TDim>
+	[[nodiscard]] VectorSoA<T, TDim> ceil(VectorSoA<T, TDim> vectors) noexcept
+	{
+		return transmute(std::move(vectors), [](T element) { return static_cast<T>(std::ceil(element)); });
+	}
+
+	template <class T, DimensionDescriptor_t TDim>
+	[[nodiscard]] VectorSoA<T, TDim> floor(VectorSoA<T, TDim> vectors) noexcept
+	{
+		return transmute(std::move(vectors), [](T element) { return static_cast<T>(std::floor(element)); });
+	}
+
+	template <class T, DimensionDescriptor_t TDim>
+	[[nodiscard]] VectorSoA<T, TDim> trunc(VectorSoA<T, TDim> vectors) noexcept
+	{
+		return transmute(std::move(vectors), [](T element) { return static_cast<T>(std::trunc(element)); });
+	}
+
+	template <class T, DimensionDescriptor_t TDim>
+	[[nodiscard]] VectorSoA<T, TDim> round(VectorSoA<T, TDim> vectors) noexcept
+	{
+		return transmute(std::move(vectors), [](T element) { return static_cast<T>(std::round(element)); });
+	}
+
+	// sine and cosine are evaluated once for the whole batch
+	template <std::floating_point T>
+	[[nodiscard]] VectorSoA<T, 2> rotate(VectorSoA<T, 2> vectors, T radian) noexcept
+	{
+		detail::rotateBatch(vectors, 0, std::size(vectors), std::sin(radian), std::cos(radian));
+		return vectors;
+	}
+
+	template <std::signed_integral T>
+	[[nodiscard]] VectorSoA<T, 2> rotate(VectorSoA<T, 2> vectors, double radian) noexcept
+	{
+		detail::rotateBatch(vectors, 0, std::size(vectors), std::sin(radian), std::cos(radian));
+		return vectors;
+	}
+
+	/* seq rotates the vectors one by one as the single rotate does (thus evaluates sine and cosine for each of them), while the
+	 * unsequenced policies evaluate them once and run the lane wise kernel; the parallel policies split the vectors into chunks.
+	 */
+	template <ExecutionPolicy TPolicy, std::floating_point T>
+	[[nodiscard]] VectorSoA<T, 2> rotate(const TPolicy& policy, VectorSoA<T, 2> vectors, T radian)
+	{
+		detail::rotateChunks(policy, vectors, radian);
+		return vectors;
+	}
+
+	template <ExecutionPolicy TPolicy, std::signed_integral T>
+	[[nodiscard]] VectorSoA<T, 2> rotate(const TPolicy& policy, VectorSoA<T, 2> vectors, double radian)
+	{
+		detail::rotateChunks(policy, vectors, radian);
+		return vectors;
+	}
+}
+
+#endif
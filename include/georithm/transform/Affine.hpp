@@ -0,0 +1,247 @@
+//          Copyright Dominic Koepke 2017 - 2020.
+// Distributed under the Boost Software License, Version 1.0.
+//    (See accompanying file LICENSE_1_0.txt or copy at
+//          https://www.boost.org/LICENSE_1_0.txt)
+
+#ifndef GEORITHM_TRANSFORM_AFFINE_HPP
+#define GEORITHM_TRANSFORM_AFFINE_HPP
+
+#pragma once
+
+#include <cmath>
+#include <concepts>
+#include <tuple>
+#include <type_traits>
+
+#include "georithm/Concepts.hpp"
+#include "georithm/Vector.hpp"
+#include "georithm/transform/PrecomputedRotate.hpp"
+#include "georithm/transform/Rotate.hpp"
+#include "georithm/transform/Scale.hpp"
+#include "georithm/transform/Shear.hpp"
+#include "georithm/transform/Translate.hpp"
+
+namespace georithm::transform
+{
+	/* 2x3 matrix of an affine 2d transformation; a vector (x, y) is mapped to
+	 * (m00 * x + m01 * y + m02, m10 * x + m11 * y + m12)
+	 */
+	template <std::floating_point T>
+	struct AffineMatrix
+	{
+		using ValueType = T;
+
+		T m00{ 1 };
+		T m01{ 0 };
+		T m02{ 0 };
+		T m10{ 0 };
+		T m11{ 1 };
+		T m12{ 0 };
+
+		[[nodiscard]] constexpr bool operator ==(const AffineMatrix&) const noexcept = default;
+
+		[[nodiscard]] constexpr static AffineMatrix identity() noexcept
+		{
+			return {};
+		}
+
+		// the resulting matrix applies rhs first and lhs afterwards
+		[[nodiscard]] friend constexpr AffineMatrix operator *(const AffineMatrix& lhs, const AffineMatrix& rhs) noexcept
+		{
+			return {
+				lhs.m00 * rhs.m00 + lhs.m01 * rhs.m10,
+				lhs.m00 * rhs.m01 + lhs.m01 * rhs.m11,
+				lhs.m00 * rhs.m02 + lhs.m01 * rhs.m12 + lhs.m02,
+				lhs.m10 * rhs.m00 + lhs.m11 * rhs.m10,
+				lhs.m10 * rhs.m01 + lhs.m11 * rhs.m11,
+				lhs.m10 * rhs.m02 + lhs.m11 * rhs.m12 + lhs.m12
+			};
+		}
+
+		template <NDimensionalVectorObject<2> TVector>
+		[[nodiscard]] constexpr TVector apply(const TVector& vec) const noexcept
+		{
+			using VectorValue_t = typename TVector::ValueType;
+			auto x = static_cast<T>(vec[0]);
+			auto y = static_cast<T>(vec[1]);
+			Vector<T, 2> result{ m00 * x + m01 * y + m02, m10 * x + m11 * y + m12 };
+
+			if constexpr (std::is_same_v<VectorValue_t, T>)
+				return result;
+			else if constexpr (std::integral<VectorValue_t>)
+				return static_cast<TVector>(round(result));
+			else
+				return static_cast<TVector>(result);
+		}
+	};
+
+	template <VectorObject TVectorType>
+	using AffineMatrixFor_t = AffineMatrix<detail::ConditionalType_t<
+		typename TVectorType::ValueType,
+		double, std::is_floating_point_v<typename TVectorType::ValueType>>>;
+
+	template <NDimensionalVectorObject<2> TVectorType>
+	[[nodiscard]] constexpr AffineMatrixFor_t<TVectorType> toAffineMatrix(const Translate<TVectorType>& component) noexcept
+	{
+		using Value_t = typename AffineMatrixFor_t<TVectorType>::ValueType;
+		auto& translation = component.translation();
+		return { Value_t(1), Value_t(0), static_cast<Value_t>(translation[0]), Value_t(0), Value_t(1), static_cast<Value_t>(translation[1]) };
+	}
+
+	template <NDimensionalVectorObject<2> TVectorType>
+	[[nodiscard]] constexpr AffineMatrixFor_t<TVectorType> toAffineMatrix(const Scale<TVectorType>& component) noexcept
+	{
+		using Value_t = typename AffineMatrixFor_t<TVectorType>::ValueType;
+		auto& scale = component.scale();
+		return { static_cast<Value_t>(scale[0]), Value_t(0), Value_t(0), Value_t(0), static_cast<Value_t>(scale[1]), Value_t(0) };
+	}
+
+	template <NDimensionalVectorObject<2> TVectorType>
+	[[nodiscard]] constexpr AffineMatrixFor_t<TVectorType> toAffineMatrix(const Shear<TVectorType>& component) noexcept
+	{
+		using Value_t = typename AffineMatrixFor_t<TVectorType>::ValueType;
+		auto& shear = component.shear();
+		return { Value_t(1), static_cast<Value_t>(shear[0]), Value_t(0), static_cast<Value_t>(shear[1]), Value_t(1), Value_t(0) };
+	}
+
+	template <NDimensionalVectorObject<2> TVectorType, class TArcType>
+	[[nodiscard]] constexpr AffineMatrixFor_t<TVectorType> toAffineMatrix(const Rotate<TVectorType, TArcType>& component) noexcept
+	{
+		using Value_t = typename AffineMatrixFor_t<TVectorType>::ValueType;
+		auto cos = static_cast<Value_t>(std::cos(component.rotation()));
+		auto sin = static_cast<Value_t>(std::sin(component.rotation()));
+		return { cos, -sin, Value_t(0), sin, cos, Value_t(0) };
+	}
+
+	template <NDimensionalVectorObject<2> TVectorType, class TArcType>
+	[[nodiscard]] constexpr AffineMatrixFor_t<TVectorType> toAffineMatrix(const PrecomputedRotate<TVectorType, TArcType>& component) noexcept
+	{
+		using Value_t = typename AffineMatrixFor_t<TVectorType>::ValueType;
+		auto cos = static_cast<Value_t>(component.cos());
+		auto sin = static_cast<Value_t>(component.sin());
+		return { cos, -sin, Value_t(0), sin, cos, Value_t(0) };
+	}
+
+	template <class T, class TVectorType>
+	concept AffineComponent = TransformComponent<T, TVectorType> && requires(const std::remove_cvref_t<T>& component)
+	{
+		{ toAffineMatrix(component) } -> std::same_as<AffineMatrixFor_t<TVectorType>>;
+	};
+
+	/* Collapses a sequence of affine transform components into a single matrix, which is then applied with one matrix-vector
+	 * product per transform call. The components are applied in the given order, exactly as if they were used as separate
+	 * Rect transformers. The matrix is recomputed lazily after a component has been accessed through a non-const accessor; thus
+	 * do not hold on to such references. Integral vectors are rounded once at the end, instead of after each single component.
+	 * transform() and matrix() write the matrix on their first call after a change, thus threads may only share a chain (or a Rect
+	 * built on top of it) once matrix() has been called after the last change of its components.
+	 */
+	template <NDimensionalVectorObject<2> TVectorType, AffineComponent<TVectorType>... TComponents>
+	class AffineChain
+	{
+	public:
+		using VectorType = TVectorType;
+		using ValueType = typename TVectorType::ValueType;
+		using MatrixType = AffineMatrixFor_t<TVectorType>;
+		constexpr static std::size_t componentCount = sizeof...(TComponents);
+
+		constexpr AffineChain() noexcept = default;
+		/*ToDo: c++20
+		constexpr */
+		~AffineChain() noexcept = default;
+
+		constexpr explicit AffineChain(const TComponents&... components) noexcept :
+			m_Components{ components... }
+		{
+		}
+
+		constexpr AffineChain(const AffineChain&) = default;
+		constexpr AffineChain& operator =(const AffineChain&) = default;
+		constexpr AffineChain(AffineChain&&) = default;
+		constexpr AffineChain& operator =(AffineChain&&) = default;
+
+		[[nodiscard]] constexpr bool operator ==(const AffineChain& other) const
+		{
+			return m_Components == other.m_Components;
+		}
+
+		template <class TComponent>
+		[[nodiscard]] constexpr const TComponent& component() const noexcept
+		{
+			return std::get<TComponent>(m_Components);
+		}
+
+		template <class TComponent>
+		[[nodiscard]] constexpr TComponent& component() noexcept
+		{
+			invalidate();
+			return std::get<TComponent>(m_Components);
+		}
+
+		template <std::size_t TIndex>
+		[[nodiscard]] constexpr const auto& component() const noexcept
+		{
+			return std::get<TIndex>(m_Components);
+		}
+
+		template <std::size_t TIndex>
+		[[nodiscard]] constexpr auto& component() noexcept
+		{
+			invalidate();
+			return std::get<TIndex>(m_Components);
+		}
+
+		[[nodiscard]] constexpr const std::tuple<TComponents...>& components() const noexcept
+		{
+			return m_Components;
+		}
+
+		[[nodiscard]] constexpr std::tuple<TComponents...>& components() noexcept
+		{
+			invalidate();
+			return m_Components;
+		}
+
+		[[nodiscard]] constexpr const MatrixType& matrix() const noexcept
+		{
+			if (m_Dirty)
+			{
+				m_Matrix = std::apply([](const auto&... components)
+									{
+										auto matrix = MatrixType::identity();
+										((matrix = toAffineMatrix(components) * matrix), ...);
+										return matrix;
+									},
+									m_Components
+				);
+				m_Dirty = false;
+			}
+			return m_Matrix;
+		}
+
+		constexpr void invalidate() noexcept
+		{
+			m_Dirty = true;
+		}
+
+		[[nodiscard]] constexpr VectorType transform(const VectorType& vec) const noexcept
+		{
+			return matrix().apply(vec);
+		}
+
+	private:
+		std::tuple<TComponents...> m_Components{};
+		mutable MatrixType m_Matrix{};
+		mutable bool m_Dirty = true;
+	};
+}
+
+namespace georithm
+{
+	template <class TVectorType, class... TComponents>
+	struct IsAffineTransformer<transform::AffineChain<TVectorType, TComponents...>> :
+		std::true_type
+	{
+	};
+}
+
+#endif
@@ -0,0 +1,111 @@
+//          Copyright Dominic Koepke 2017 - 2020.
+// Distributed under the Boost Software License, Version 1.0.
+//    (See accompanying file LICENSE_1_0.txt or copy at
+//          https://www.boost.org/LICENSE_1_0.txt)
+
+#ifndef GEORITHM_TRANSFORM_PRECOMPUTED_ROTATE_HPP
+#define GEORITHM_TRANSFORM_PRECOMPUTED_ROTATE_HPP
+
+#pragma once
+
+#include <cmath>
+#include <concepts>
+
+#include "georithm/Concepts.hpp"
+#include "georithm/Vector.hpp"
+#include "georithm/transform/Rotate.hpp"
+
+namespace georithm::transform
+{
+	/* Behaves like Rotate, but stores the cosine and sine of the rotation next to it. Both are updated when the rotation gets set,
+	 * thus each transform call is reduced to a few multiply-adds. Because of this, the rotation can't be changed through a
+	 * non-const reference.
+	 */
+	template <NDimensionalVectorObject<2> TVectorType, class TArcType = detail::ConditionalType_t<
+		typename TVectorType::ValueType,
+		double, std::is_floating_point_v<typename TVectorType::ValueType>>>
+	requires std::floating_point<TArcType>
+	class PrecomputedRotate
+	{
+	public:
+		using VectorType = TVectorType;
+		using ValueType = TArcType;
+
+		constexpr PrecomputedRotate() noexcept = default;
+		/*ToDo: c++20
+		constexpr */
+		~PrecomputedRotate() noexcept = default;
+
+		constexpr explicit PrecomputedRotate(const ValueType& rotation) noexcept
+		{
+			this->rotation(rotation);
+		}
+
+		constexpr PrecomputedRotate(const PrecomputedRotate&) = default;
+		constexpr PrecomputedRotate& operator =(const PrecomputedRotate&) = default;
+		constexpr PrecomputedRotate(PrecomputedRotate&&) = default;
+		constexpr PrecomputedRotate& operator =(PrecomputedRotate&&) = default;
+
+		[[nodiscard]] constexpr bool operator ==(const PrecomputedRotate& other) const
+		{
+			return m_Rotation == other.m_Rotation;
+		}
+
+		[[nodiscard]] constexpr const ValueType& rotation() const noexcept
+		{
+			return m_Rotation;
+		}
+
+		constexpr void rotation(const ValueType& rotation) noexcept
+		{
+			m_Rotation = rotation;
+			m_Cos = std::cos(rotation);
+			m_Sin = std::sin(rotation);
+		}
+
+		[[nodiscard]] constexpr const ValueType& cos() const noexcept
+		{
+			return m_Cos;
+		}
+
+		[[nodiscard]] constexpr const ValueType& sin() const noexcept
+		{
+			return m_Sin;
+		}
+
+		[[nodiscard]] constexpr VectorType transform(const VectorType& vec) const noexcept
+		{
+			if constexpr (std::is_same_v<typename VectorType::ValueType, ValueType>)
+			{
+				return { m_Cos * vec[0] - m_Sin * vec[1], m_Sin * vec[0] + m_Cos * vec[1] };
+			}
+			else
+			{
+				Vector<ValueType, 2> rotated{
+					m_Cos * static_cast<ValueType>(vec[0]) - m_Sin * static_cast<ValueType>(vec[1]),
+					m_Sin * static_cast<ValueType>(vec[0]) + m_Cos * static_cast<ValueType>(vec[1])
+				};
+				if constexpr (std::integral<typename VectorType::ValueType>)
+					return static_cast<VectorType>(round(rotated));
+				else
+					return static_cast<VectorType>(rotated);
+			}
+		}
+
+	private:
+		ValueType m_Rotation{};
+		ValueType m_Cos{ 1 };
+		ValueType m_Sin{ 0 };
+	};
+}
+
+namespace georithm
+{
+	template <class TVectorType, class TArcType>
+	struct IsAffineTransformer<transform::PrecomputedRotate<TVectorType, TArcType>> :
+		std::true_type
+	{
+	};
+}
+
+#endif
@@ -77,4 +77,13 @@ namespace georithm::transform
 	};
 }
 
+namespace georithm
+{
+	template <class TVectorType, class TArcType>
+	struct IsAffineTransformer<transform::Rotate<TVectorType, TArcType>> :
+		std::true_type
+	{
+	};
+}
+
 #endif
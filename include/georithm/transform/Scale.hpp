@@ -62,4 +62,13 @@ namespace georithm::transform
 	};
 }
 
+namespace georithm
+{
+	template <class TVectorType>
+	struct IsAffineTransformer<transform::Scale<TVectorType>> :
+		std::true_type
+	{
+	};
+}
+
 #endif
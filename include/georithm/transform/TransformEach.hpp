@@ -0,0 +1,74 @@
+//          Copyright Dominic Koepke 2017 - 2020.
+// Distributed under the Boost Software License, Version 1.0.
+//    (See accompanying file LICENSE_1_0.txt or copy at
+//          https://www.boost.org/LICENSE_1_0.txt)
+
+#ifndef GEORITHM_TRANSFORM_TRANSFORM_EACH_HPP
+#define GEORITHM_TRANSFORM_TRANSFORM_EACH_HPP
+
+#pragma once
+
+#include <concepts>
+#include <cstddef>
+#include <ranges>
+
+#include "georithm/Concepts.hpp"
+#include "georithm/Execution.hpp"
+#include "georithm/transform/PrecomputedRotate.hpp"
+#include "georithm/transform/Rotate.hpp"
+
+namespace georithm::transform::detail
+{
+	// the transformer, which the unsequenced policies apply; most transformers have nothing to prepare
+	template <class TTransformer>
+	[[nodiscard]] constexpr const TTransformer& batchTransformer(const TTransformer& transformer) noexcept
+	{
+		return transformer;
+	}
+
+	// sine and cosine get evaluated once for the whole range, instead of once per vector
+	template <NDimensionalVectorObject<2> TVectorType, std::floating_point TArcType>
+	[[nodiscard]] constexpr PrecomputedRotate<TVectorType, TArcType> batchTransformer(const Rotate<TVectorType, TArcType>& rotate) noexcept
+	{
+		return PrecomputedRotate<TVectorType, TArcType>{ rotate.rotation() };
+	}
+}
+
+namespace georithm
+{
+	/* Replaces each vector of the range by transformer.transform(vector). seq applies the transformer as it is to one vector after
+	 * another, while the unsequenced policies prepare it for the whole range first (e.g. a Rotate becomes a PrecomputedRotate); the
+	 * parallel policies split the range into chunks. Transformers with a lazily computed matrix (AffineChain) get it computed before
+	 * any chunk runs, thus they may be shared by all threads.
+	 */
+	template <ExecutionPolicy TPolicy, class TTransformer, std::ranges::random_access_range TVectors>
+	requires VectorObject<std::ranges::range_value_t<TVectors>> &&
+	std::ranges::output_range<TVectors, std::ranges::range_value_t<TVectors>> &&
+	requires(const TTransformer& transformer, const std::ranges::range_value_t<TVectors>& vector)
+	{
+		{ transformer.transform(vector) } -> std::convertible_to<std::ranges::range_value_t<TVectors>>;
+	}
+	void transformEach(const TPolicy& policy, const TTransformer& transformer, TVectors&& vectors)
+	{
+		if constexpr (requires { transformer.matrix(); })
+			static_cast<void>(transformer.matrix());
+
+		auto run = [&](const auto& appliedTransformer)
+		{
+			detail::forEachChunk(policy, static_cast<std::size_t>(std::ranges::size(vectors)), [&](std::size_t begin, std::size_t end)
+				{
+					auto vectorIter = std::ranges::begin(vectors);
+					for (auto i = begin; i < end; ++i)
+						vectorIter[i] = appliedTransformer.transform(vectorIter[i]);
+				}
+			);
+		};
+
+		if constexpr (detail::IsUnsequencedPolicy_v<TPolicy>)
+			run(transform::detail::batchTransformer(transformer));
+		else
+			run(transformer);
+	}
+}
+
+#endif
@@ -56,4 +56,13 @@ namespace georithm::transform
 	};
 }
 
+namespace georithm
+{
+	template <class TVectorType>
+	struct IsAffineTransformer<transform::Translate<TVectorType>> :
+		std::true_type
+	{
+	};
+}
+
 #endif
@@ -0,0 +1,223 @@
+//          Copyright Dominic Koepke 2017 - 2020.
+// Distributed under the Boost Software License, Version 1.0.
+//    (See accompanying file LICENSE_1_0.txt or copy at
+//          https://www.boost.org/LICENSE_1_0.txt)
+
+#include "catch.hpp"
+
+#include <algorithm>
+#include <thread>
+#include <vector>
+
+#include "georithm/BatchQuery.hpp"
+#include "georithm/Bounding.hpp"
+#include "georithm/Contains.hpp"
+#include "georithm/DynamicAABBTree.hpp"
+#include "georithm/Intersection.hpp"
+#include "georithm/LinearBvh.hpp"
+#include "georithm/Line.hpp"
+#include "georithm/Overlaps.hpp"
+#include "georithm/PackedRTree.hpp"
+#include "georithm/Rect.hpp"
+#include "georithm/ThreadPool.hpp"
+#include "georithm/UniformGrid.hpp"
+#include "georithm/Vector.hpp"
+
+#include "georithm/transform/Rotate.hpp"
+
+#include "RandomGeometry.hpp"
+
+namespace
+{
+	using namespace georithm;
+	using test::makePoints;
+	using test::makeRects;
+
+	using Vector2_t = Vector<double, 2>;
+	using Rect_t = test::RotatedRect_t;
+
+	std::vector<AABB_t<double>> makeQueryRects(std::size_t count, unsigned seed)
+	{
+		std::vector<AABB_t<double>> queryRects;
+		for (auto& rect : makeRects(count, seed))
+			queryRects.emplace_back(boundingRect(rect));
+		return queryRects;
+	}
+
+	std::vector<Ray<Vector2_t>> makeRays(std::size_t count, unsigned seed)
+	{
+		std::vector<Ray<Vector2_t>> rays;
+		auto origins = makePoints(count, seed);
+		auto targets = makePoints(count, seed + 1);
+		for (std::size_t i = 0; i < count; ++i)
+			rays.emplace_back(origins[i], targets[i] - origins[i]);
+		return rays;
+	}
+
+	/* Each query is compared to the sequential query of the index; the order must match as well. The filtered queries get compared
+	 * to brute force, which is expensive, thus it's done for a single pool only; the other pools have to produce the same results.
+	 */
+	template <class TIndex>
+	void checkBatchQueries(const TIndex& index, const std::vector<Rect_t>& rects, ThreadPool& pool)
+	{
+		auto queryRects = makeQueryRects(200, 3);
+		auto batch = batchQuery(index, queryRects, pool);
+		REQUIRE(std::size(batch) == std::size(queryRects));
+		for (std::size_t i = 0; i < std::size(queryRects); ++i)
+		{
+			std::vector<std::size_t> expected;
+			index.query(queryRects[i], [&](std::size_t objectIndex) { expected.emplace_back(objectIndex); });
+			REQUIRE(std::ranges::equal(batch[i], expected));
+		}
+
+		auto overlapping = batchOverlaps(index, rects, queryRects, pool);
+		for (std::size_t i = 0; i < std::size(queryRects); ++i)
+		{
+			std::vector<std::size_t> found(std::begin(overlapping[i]), std::end(overlapping[i]));
+			std::ranges::sort(found);
+			std::vector<std::size_t> expected;
+			for (std::size_t j = 0; j < std::size(rects); ++j)
+			{
+				if (overlaps(rects[j], queryRects[i]))
+					expected.emplace_back(j);
+			}
+			REQUIRE(found == expected);
+		}
+
+		auto points = makePoints(200, 4);
+		auto containing = batchContains(index, rects, points, pool);
+		for (std::size_t i = 0; i < std::size(points); ++i)
+		{
+			std::vector<std::size_t> found(std::begin(containing[i]), std::end(containing[i]));
+			std::ranges::sort(found);
+			std::vector<std::size_t> expected;
+			for (std::size_t j = 0; j < std::size(rects); ++j)
+			{
+				if (contains(rects[j], points[i]))
+					expected.emplace_back(j);
+			}
+			REQUIRE(found == expected);
+		}
+
+		// the merged results don't depend on the count of threads
+		for (auto threadCount : { 1u, 2u, 8u })
+		{
+			ThreadPool otherPool{ threadCount };
+			REQUIRE(batch == batchQuery(index, queryRects, otherPool));
+			REQUIRE(overlapping == batchOverlaps(index, rects, queryRects, otherPool));
+			REQUIRE(containing == batchContains(index, rects, points, otherPool));
+		}
+	}
+
+	template <class TIndex>
+	void checkBatchRaycasts(const TIndex& index, const std::vector<Rect_t>& rects, ThreadPool& pool)
+	{
+		auto rays = makeRays(300, 5);
+		auto hits = batchRaycast(index, rects, rays, pool);
+		REQUIRE(std::size(hits) == std::size(rays));
+		for (std::size_t i = 0; i < std::size(rays); ++i)
+		{
+			std::vector<RaycastHit<double>> expected;
+			index.raycast(rects, rays[i], [&](std::size_t objectIndex, double dist) { expected.push_back({ objectIndex, dist }); });
+			REQUIRE(std::ranges::equal(hits[i], expected));
+		}
+
+		for (auto threadCount : { 1u, 2u, 8u })
+		{
+			ThreadPool otherPool{ threadCount };
+			REQUIRE(hits == batchRaycast(index, rects, rays, otherPool));
+		}
+	}
+}
+
+TEST_CASE("Batch query test", "[BatchQuery]")
+{
+	auto rects = makeRects(3000, 1);
+	ThreadPool pool{ 4 };
+
+	SECTION("Bvh")
+	{
+		auto bvh = buildLinearBvh(rects, pool);
+		checkBatchQueries(bvh, rects, pool);
+		checkBatchRaycasts(bvh, rects, pool);
+	}
+
+	SECTION("PackedRTree")
+	{
+		PackedRTree<double> tree{ rects };
+		checkBatchQueries(tree, rects, pool);
+		checkBatchRaycasts(tree, rects, pool);
+		checkBatchRaycasts(tree.view(), rects, pool);
+	}
+
+	SECTION("UniformGrid")
+	{
+		UniformGrid<double> grid{ 8. };
+		grid.rebuild(rects);
+		checkBatchQueries(grid, rects, pool);
+	}
+
+	SECTION("DynamicAABBTree")
+	{
+		// the tree reports proxy ids, thus the geometries are arranged by them; unused ids get a rect far away from all queries
+		DynamicAABBTree<double> tree{ 0. };
+		std::vector<Rect_t> proxyRects;
+		for (auto& rect : rects)
+		{
+			auto proxyId = tree.insert(rect, 0);
+			proxyRects.resize(std::max(std::size(proxyRects), proxyId + 1), Rect_t{ { 1e6, 1e6 }, { 1., 1. } });
+			proxyRects[proxyId] = rect;
+		}
+		checkBatchQueries(tree, proxyRects, pool);
+	}
+
+	SECTION("no queries")
+	{
+		auto bvh = buildLinearBvh(rects, pool);
+		auto result = batchQuery(bvh, std::vector<AABB_t<double>>{}, pool);
+		REQUIRE(result.empty());
+		REQUIRE(std::empty(result.values()));
+	}
+}
+
+TEST_CASE("Concurrent read only queries test", "[BatchQuery]")
+{
+	auto rects = makeRects(3000, 2);
+	ThreadPool pool{ 1 };
+	auto bvh = buildLinearBvh(rects, pool);
+	PackedRTree<double> tree{ rects };
+	UniformGrid<double> grid{ 8. };
+	grid.rebuild(rects);
+
+	auto queryRects = makeQueryRects(300, 6);
+	auto rays = makeRays(300, 7);
+	auto expectedBvh = batchQuery(bvh, queryRects, pool);
+	auto expectedTree = batchQuery(tree, queryRects, pool);
+	auto expectedGrid = batchQuery(grid, queryRects, pool);
+	auto expectedHits = batchRaycast(bvh, rects, rays, pool);
+
+	// Catch assertions aren't thread safe, thus each thread only records whether its results matched
+	constexpr std::size_t threadCount = 8;
+	std::vector<int> matches(threadCount);
+	std::vector<std::thread> threads;
+	for (std::size_t t = 0; t < threadCount; ++t)
+	{
+		threads.emplace_back([&, t]()
+			{
+				ThreadPool localPool{ 1 };
+				bool match = true;
+				for (int round = 0; round < 5; ++round)
+				{
+					match = match && batchQuery(bvh, queryRects, localPool) == expectedBvh;
+					match = match && batchQuery(tree, queryRects, localPool) == expectedTree;
+					match = match && batchQuery(grid, queryRects, localPool) == expectedGrid;
+					match = match && batchRaycast(bvh, rects, rays, localPool) == expectedHits;
+				}
+				matches[t] = match;
+			}
+		);
+	}
+	for (auto& thread : threads)
+		thread.join();
+	REQUIRE(std::ranges::all_of(matches, [](int match) { return match != 0; }));
+}
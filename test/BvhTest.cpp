@@ -0,0 +1,323 @@
+//          Copyright Dominic Koepke 2017 - 2020.
+// Distributed under the Boost Software License, Version 1.0.
+//    (See accompanying file LICENSE_1_0.txt or copy at
+//          https://www.boost.org/LICENSE_1_0.txt)
+
+#include "catch.hpp"
+
+#include <cmath>
+#include <map>
+#include <random>
+#include <set>
+#include <vector>
+
+#include "georithm/Bounding.hpp"
+#include "georithm/BinnedSahBvh.hpp"
+#include "georithm/Bvh.hpp"
+#include "georithm/Intersection.hpp"
+#include "georithm/LinearBvh.hpp"
+#include "georithm/Line.hpp"
+#include "georithm/Rect.hpp"
+#include "georithm/ThreadPool.hpp"
+#include "georithm/Vector.hpp"
+
+#include "georithm/transform/Rotate.hpp"
+#include "georithm/transform/Translate.hpp"
+
+#include "RandomGeometry.hpp"
+
+namespace
+{
+	using namespace georithm;
+	using test::makeRects;
+
+	using Vector2_t = Vector<double, 2>;
+	using Rect_t = test::RotatedRect_t;
+
+	// the far edges of united bounds are subject to rounding
+	template <class T>
+	bool enclosesBounds(const AABB_t<T>& outer, const AABB_t<T>& inner)
+	{
+		auto tolerance = 1e-9 * (1. + std::abs(outer.position().x()) + std::abs(outer.position().y()) + outer.span().x() + outer.span().y());
+		return outer.position().x() <= inner.position().x() && outer.position().y() <= inner.position().y() &&
+			inner.position().x() + inner.span().x() <= outer.position().x() + outer.span().x() + tolerance &&
+			inner.position().y() + inner.span().y() <= outer.position().y() + outer.span().y() + tolerance;
+	}
+
+	// each object is referenced exactly once, parents are consistent and the bounds of each node enclose its children
+	template <class T, class TObjects>
+	void checkHierarchy(const Bvh<T>& bvh, const TObjects& objects)
+	{
+		auto nodes = bvh.nodes();
+		REQUIRE(std::size(bvh) == std::size(objects));
+		std::vector<int> references(std::size(objects));
+		std::vector<int> parentReferences(std::size(nodes));
+		for (std::size_t i = 0; i < std::size(nodes); ++i)
+		{
+			auto& node = nodes[i];
+			if (node.isLeaf())
+			{
+				for (auto j = node.child1; j < node.child1 + node.objectCount; ++j)
+				{
+					auto index = bvh.objectIndices()[j];
+					++references[index];
+					REQUIRE(bvh.objectBounds()[j] == boundingRect(objects[index]));
+					REQUIRE(enclosesBounds(node.bounds, bvh.objectBounds()[j]));
+				}
+			}
+			else
+			{
+				for (auto child : { node.child1, node.child2 })
+				{
+					REQUIRE(nodes[child].parent == i);
+					++parentReferences[child];
+					REQUIRE(enclosesBounds(node.bounds, nodes[child].bounds));
+				}
+			}
+		}
+		REQUIRE(std::ranges::all_of(references, [](int count) { return count == 1; }));
+		REQUIRE(parentReferences[0] == 0);
+		REQUIRE(std::all_of(std::begin(parentReferences) + 1, std::end(parentReferences), [](int count) { return count == 1; }));
+	}
+
+	template <class T, class TObjects>
+	void checkQueries(const Bvh<T>& bvh, const TObjects& objects)
+	{
+		for (auto& queryRect : makeRects(50, 7))
+		{
+			std::set<std::size_t> found;
+			bvh.query(queryRect, [&](std::size_t index) { REQUIRE(found.emplace(index).second); });
+
+			std::set<std::size_t> expected;
+			for (std::size_t i = 0; i < std::size(objects); ++i)
+			{
+				if (detail::intersectsBounds(boundingRect(queryRect), boundingRect(objects[i])))
+					expected.emplace(i);
+			}
+			REQUIRE(found == expected);
+		}
+
+		std::mt19937 engine{ 8 };
+		std::uniform_real_distribution<double> positionDist{ -120., 120. };
+		for (int i = 0; i < 20; ++i)
+		{
+			Vector2_t origin{ positionDist(engine), positionDist(engine) };
+			Vector2_t target{ positionDist(engine), positionDist(engine) };
+			Ray<Vector2_t> ray{ origin, target - origin };
+
+			std::map<std::size_t, double> hits;
+			bvh.raycast(objects, ray, [&](std::size_t index, double dist) { REQUIRE(hits.try_emplace(index, dist).second); });
+
+			std::map<std::size_t, double> expectedHits;
+			for (std::size_t j = 0; j < std::size(objects); ++j)
+			{
+				if (auto dist = intersection(ray, objects[j]))
+					expectedHits.emplace(j, *dist);
+			}
+			REQUIRE(hits == expectedHits);
+		}
+	}
+}
+
+TEST_CASE("Linear BVH test", "[Bvh]")
+{
+	ThreadPool pool{ 4 };
+
+	SECTION("random rects")
+	{
+		auto count = GENERATE(2u, 3u, 17u, 1000u, 40000u);
+		auto rects = makeRects(count, count);
+		auto bvh = buildLinearBvh(rects, pool);
+		REQUIRE(std::size(bvh.nodes()) == 2 * count - 1);
+		checkHierarchy(bvh, rects);
+		if (count <= 1000)
+			checkQueries(bvh, rects);
+
+		// the result doesn't depend on the thread count
+		ThreadPool singleThread{ 1 };
+		auto serialBvh = buildLinearBvh(rects, singleThread);
+		REQUIRE(std::ranges::equal(bvh.objectIndices(), serialBvh.objectIndices()));
+		REQUIRE(std::ranges::equal(bvh.nodes(), serialBvh.nodes(), [](auto& lhs, auto& rhs)
+			{
+				return lhs.bounds == rhs.bounds && lhs.parent == rhs.parent && lhs.child1 == rhs.child1 && lhs.child2 == rhs.child2;
+			}
+		));
+	}
+
+	SECTION("identical centres")
+	{
+		std::vector<AABB_t<int>> rects;
+		for (int i = 1; i <= 100; ++i)
+			rects.push_back({ { -i, -i }, { 2 * i, 2 * i } });
+		auto bvh = buildLinearBvh(rects, pool);
+		checkHierarchy(bvh, rects);
+
+		std::set<std::size_t> found;
+		bvh.query(AABB_t<int>{ { 99, 0 }, { 1, 0 } }, [&](std::size_t index) { found.emplace(index); });
+		REQUIRE(found == std::set<std::size_t>{ 98, 99 });
+	}
+
+	SECTION("single and no object")
+	{
+		std::vector rects{ AABB_t<int>{ { 0, 0 }, { 4, 4 } } };
+		auto bvh = buildLinearBvh(rects, pool);
+		REQUIRE(std::size(bvh.nodes()) == 1);
+		REQUIRE(bvh.bounds() == rects[0]);
+		checkHierarchy(bvh, rects);
+
+		REQUIRE(buildLinearBvh(std::vector<AABB_t<int>>{}, pool).empty());
+	}
+
+	SECTION("early stop")
+	{
+		auto rects = makeRects(500, 9);
+		auto bvh = buildLinearBvh(rects, pool);
+		int calls = 0;
+		bvh.query(AABB_t<double>{ { -200., -200. }, { 400., 400. } }, [&](auto) { return ++calls < 5; });
+		REQUIRE(calls == 5);
+	}
+}
+
+TEST_CASE("Binned SAH BVH test", "[Bvh]")
+{
+	SECTION("random rects")
+	{
+		auto count = GENERATE(2u, 3u, 17u, 1000u);
+		auto maxLeafSize = GENERATE(1u, 4u);
+		auto rects = makeRects(count, count);
+		auto bvh = buildBinnedSahBvh(rects, maxLeafSize);
+		checkHierarchy(bvh, rects);
+		checkQueries(bvh, rects);
+		REQUIRE(std::ranges::all_of(bvh.nodes(), [&](auto& node) { return node.objectCount <= maxLeafSize; }));
+	}
+
+	SECTION("forEachIntersection")
+	{
+		auto rects = makeRects(300, 11);
+		auto bvh = buildBinnedSahBvh(rects);
+
+		std::mt19937 engine{ 12 };
+		std::uniform_real_distribution<double> positionDist{ -120., 120. };
+		for (int i = 0; i < 20; ++i)
+		{
+			Vector2_t origin{ positionDist(engine), positionDist(engine) };
+			Vector2_t target{ positionDist(engine), positionDist(engine) };
+			Segment<Vector2_t> segment{ origin, target - origin };
+
+			std::multiset<std::pair<std::size_t, double>> hits;
+			bvh.forEachIntersection(rects, segment, [&](std::size_t index, double lineDist, const auto&, double)
+				{
+					hits.emplace(index, lineDist);
+				}
+			);
+
+			std::multiset<std::pair<std::size_t, double>> expectedHits;
+			for (std::size_t j = 0; j < std::size(rects); ++j)
+				forEachIntersection(segment, rects[j], [&](double lineDist, const auto&, double) { expectedHits.emplace(j, lineDist); });
+			REQUIRE(hits == expectedHits);
+		}
+	}
+
+	SECTION("identical centres")
+	{
+		std::vector<AABB_t<int>> rects;
+		for (int i = 1; i <= 100; ++i)
+			rects.push_back({ { -i, -i }, { 2 * i, 2 * i } });
+		auto bvh = buildBinnedSahBvh(rects);
+		checkHierarchy(bvh, rects);
+		REQUIRE(std::ranges::all_of(bvh.nodes(), [&](auto& node) { return node.objectCount <= 4; }));
+	}
+
+	SECTION("single and no object")
+	{
+		std::vector rects{ AABB_t<int>{ { 0, 0 }, { 4, 4 } } };
+		auto bvh = buildBinnedSahBvh(rects);
+		REQUIRE(std::size(bvh.nodes()) == 1);
+		checkHierarchy(bvh, rects);
+
+		REQUIRE(buildBinnedSahBvh(std::vector<AABB_t<int>>{}).empty());
+	}
+}
+
+TEST_CASE("BVH refit test", "[Bvh]")
+{
+	using MovingRect_t = Rect<double, transform::Rotate<Vector2_t>, transform::Translate<Vector2_t>>;
+
+	std::vector<MovingRect_t> rects;
+	for (auto& rect : makeRects(2000, 13))
+	{
+		MovingRect_t& movingRect = rects.emplace_back(rect.position(), rect.span());
+		movingRect.rotation() = rect.rotation();
+	}
+
+	ThreadPool pool{ 4 };
+	auto bvh = GENERATE(as<bool>{}, false, true) ? buildLinearBvh(rects, pool) : buildBinnedSahBvh(rects);
+	REQUIRE(bvh.sahCostRatio() == Approx(1.));
+
+	SECTION("unchanged objects keep their bounds")
+	{
+		auto nodes = std::vector(std::begin(bvh.nodes()), std::end(bvh.nodes()));
+		bvh.refit(rects);
+		REQUIRE(std::ranges::equal(nodes, bvh.nodes(), [](auto& lhs, auto& rhs)
+			{
+				return enclosesBounds(lhs.bounds, rhs.bounds) && enclosesBounds(rhs.bounds, lhs.bounds);
+			}
+		));
+		REQUIRE(bvh.sahCostRatio() == Approx(1.));
+	}
+
+	SECTION("moved objects")
+	{
+		std::mt19937 engine{ 14 };
+		std::uniform_real_distribution<double> offsetDist{ -3., 3. };
+		for (auto& rect : rects)
+		{
+			rect.translation() = { offsetDist(engine), offsetDist(engine) };
+			rect.rotation() += offsetDist(engine);
+		}
+
+		auto serialBvh = bvh;
+		serialBvh.refit(rects);
+		bvh.refit(rects, pool);
+		REQUIRE(std::ranges::equal(serialBvh.nodes(), bvh.nodes(), [](auto& lhs, auto& rhs) { return lhs.bounds == rhs.bounds; }));
+		checkHierarchy(bvh, rects);
+		checkQueries(bvh, rects);
+	}
+
+	SECTION("scattered objects degrade the hierarchy")
+	{
+		std::mt19937 engine{ 15 };
+		std::ranges::shuffle(rects, engine);
+		bvh.refit(rects, pool);
+		checkHierarchy(bvh, rects);
+		REQUIRE(2. < bvh.sahCostRatio());
+	}
+}
+
+TEST_CASE("Radix sort test", "[Bvh]")
+{
+	ThreadPool pool{ 3 };
+	std::mt19937 engine{ 10 };
+	auto maxCode = GENERATE(0xFFu, 0xFFFFFFFFu);
+	std::uniform_int_distribution<std::uint32_t> codeDist{ 0, maxCode };
+	std::vector<std::uint32_t> codes(100000);
+	std::vector<std::uint32_t> values(std::size(codes));
+	for (std::size_t i = 0; i < std::size(codes); ++i)
+	{
+		codes[i] = codeDist(engine);
+		values[i] = static_cast<std::uint32_t>(i);
+	}
+	auto expectedCodes = codes;
+	std::ranges::sort(expectedCodes);
+
+	auto originalCodes = codes;
+	detail::radixSort(codes, values, pool);
+	REQUIRE(codes == expectedCodes);
+	for (std::size_t i = 0; i < std::size(codes); ++i)
+	{
+		REQUIRE(originalCodes[values[i]] == codes[i]);
+		// stable
+		if (0 < i && codes[i - 1] == codes[i])
+			REQUIRE(values[i - 1] < values[i]);
+	}
+}
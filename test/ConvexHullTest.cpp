@@ -0,0 +1,192 @@
+//          Copyright Dominic Koepke 2017 - 2020.
+// Distributed under the Boost Software License, Version 1.0.
+//    (See accompanying file LICENSE_1_0.txt or copy at
+//          https://www.boost.org/LICENSE_1_0.txt)
+
+#include "catch.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <list>
+#include <random>
+#include <span>
+#include <vector>
+
+#include "georithm/Contains.hpp"
+#include "georithm/ConvexHull.hpp"
+#include "georithm/Execution.hpp"
+#include "georithm/Intersects.hpp"
+#include "georithm/Overlaps.hpp"
+#include "georithm/Polygon.hpp"
+#include "georithm/Rect.hpp"
+#include "georithm/ThreadPool.hpp"
+#include "georithm/Vector.hpp"
+
+namespace
+{
+	using namespace georithm;
+
+	template <class TVector>
+	std::vector<TVector> sorted(std::vector<TVector> points)
+	{
+		std::ranges::sort(points, [](const TVector& lhs, const TVector& rhs)
+			{
+				return lhs.x() < rhs.x() || (lhs.x() == rhs.x() && lhs.y() < rhs.y());
+			}
+		);
+		return points;
+	}
+
+	template <class TVector>
+	ConvexPolygon<TVector> incrementalHull(const std::vector<TVector>& points)
+	{
+		IncrementalConvexHull<TVector> hull;
+		hull.insert(points);
+		return hull.hull();
+	}
+
+	// all algorithms must agree on the hull, which must be strictly convex and enclose all points
+	template <class TVector>
+	ConvexPolygon<TVector> requireSameHulls(const std::vector<TVector>& points, ThreadPool& pool)
+	{
+		auto hull = convexHull(points);
+		REQUIRE(convexHullSorted(sorted(points)) == hull);
+		REQUIRE(convexHull(execution::par.on(pool), points) == hull);
+		REQUIRE(convexHull(execution::seq, points) == hull);
+		REQUIRE(incrementalHull(points) == hull);
+
+		auto& vertices = hull.vertices();
+		if (3 <= std::size(vertices))
+		{
+			for (std::size_t i = 0; i < std::size(vertices); ++i)
+			{
+				auto& first = vertices[i];
+				auto& second = vertices[(i + 1) % std::size(vertices)];
+				auto& third = vertices[(i + 2) % std::size(vertices)];
+				REQUIRE(0 < detail::orientation(first, second, third));
+			}
+			REQUIRE(std::ranges::all_of(points, [&](const TVector& point) { return contains(hull, point); }));
+		}
+		return hull;
+	}
+
+	template <class T>
+	std::vector<Vector<T, 2>> makePoints(std::size_t count, unsigned seed, bool onCircle)
+	{
+		std::mt19937 engine{ seed };
+		std::uniform_int_distribution<int> valueDist{ -1000, 1000 };
+		std::uniform_real_distribution<double> angleDist{ 0., 6.3 };
+		std::vector<Vector<T, 2>> points;
+		for (std::size_t i = 0; i < count; ++i)
+		{
+			if (onCircle)
+			{
+				auto angle = angleDist(engine);
+				points.push_back({ static_cast<T>(std::round(1000. * std::cos(angle))), static_cast<T>(std::round(1000. * std::sin(angle))) });
+			}
+			else
+				points.push_back({ static_cast<T>(valueDist(engine)), static_cast<T>(valueDist(engine)) });
+		}
+		return points;
+	}
+}
+
+TEST_CASE("Convex hull test", "[ConvexHull]")
+{
+	using Vector2 = Vector<int, 2>;
+	ThreadPool pool{ GENERATE(1u, 4u) };
+
+	SECTION("square with interior, duplicate and collinear points")
+	{
+		std::vector<Vector2> points{ { 2, 2 }, { 4, 4 }, { 0, 0 }, { 2, 0 }, { 4, 0 }, { 1, 3 }, { 0, 4 }, { 4, 2 }, { 0, 0 }, { 0, 2 }, { 4, 4 } };
+		auto hull = requireSameHulls(points, pool);
+		REQUIRE(hull == ConvexPolygon<Vector2>{ { 0, 0 }, { 4, 0 }, { 4, 4 }, { 0, 4 } });
+
+		// any forward range works for the general algorithm
+		std::list<Vector2> list(std::begin(points), std::end(points));
+		REQUIRE(convexHull(list) == hull);
+	}
+
+	SECTION("degenerate inputs")
+	{
+		REQUIRE(requireSameHulls(std::vector<Vector2>{}, pool).vertices().empty());
+		REQUIRE(requireSameHulls(std::vector<Vector2>{ { 1, 2 }, { 1, 2 } }, pool) == ConvexPolygon<Vector2>{ { 1, 2 } });
+
+		auto horizontal = requireSameHulls(std::vector<Vector2>{ { 3, 0 }, { 1, 0 }, { 2, 0 }, { 0, 0 } }, pool);
+		REQUIRE(horizontal == ConvexPolygon<Vector2>{ { 0, 0 }, { 3, 0 } });
+		REQUIRE(horizontal.isNull());
+		auto vertical = requireSameHulls(std::vector<Vector2>{ { 5, 3 }, { 5, -1 }, { 5, 7 } }, pool);
+		REQUIRE(vertical == ConvexPolygon<Vector2>{ { 5, -1 }, { 5, 7 } });
+		auto diagonal = requireSameHulls(std::vector<Vector2>{ { 2, 2 }, { -1, -1 }, { 5, 5 }, { 0, 0 } }, pool);
+		REQUIRE(diagonal == ConvexPolygon<Vector2>{ { -1, -1 }, { 5, 5 } });
+		REQUIRE(requireSameHulls(std::vector<Vector2>{ { 0, 0 }, { 1, 0 }, { 0, 1 } }, pool) == ConvexPolygon<Vector2>{ { 0, 0 }, { 1, 0 }, { 0, 1 } });
+	}
+
+	SECTION("random points")
+	{
+		bool onCircle = GENERATE(false, true);
+		// more points than a single chunk of the parallel hull
+		auto points = makePoints<int>(200'000, 1, onCircle);
+		auto hull = requireSameHulls(points, pool);
+		REQUIRE(!hull.isNull());
+		requireSameHulls(makePoints<double>(5000, 2, onCircle), pool);
+	}
+}
+
+TEST_CASE("Incremental convex hull test", "[ConvexHull]")
+{
+	using Vector2 = Vector<int, 2>;
+
+	IncrementalConvexHull<Vector2> hull;
+	REQUIRE(hull.empty());
+	REQUIRE(!hull.contains({ 0, 0 }));
+
+	REQUIRE(hull.insert({ 0, 0 }));
+	REQUIRE(hull.contains({ 0, 0 }));
+	REQUIRE(!hull.insert({ 0, 0 }));
+	REQUIRE(hull.insert({ 4, 0 }));
+	REQUIRE(hull.insert({ 4, 4 }));
+	REQUIRE(hull.insert({ 0, 4 }));
+	REQUIRE(!hull.insert({ 2, 2 }));
+	REQUIRE(!hull.insert({ 2, 4 }));
+	REQUIRE(hull.contains({ 4, 2 }));
+	REQUIRE(!hull.contains({ 5, 2 }));
+	REQUIRE(hull.hull() == ConvexPolygon<Vector2>{ { 0, 0 }, { 4, 0 }, { 4, 4 }, { 0, 4 } });
+
+	// a point beyond an edge replaces it, a farther one swallows that point again
+	REQUIRE(hull.insert({ 10, 2 }));
+	REQUIRE(hull.hull() == ConvexPolygon<Vector2>{ { 0, 0 }, { 4, 0 }, { 10, 2 }, { 4, 4 }, { 0, 4 } });
+	REQUIRE(hull.insert({ 20, 2 }));
+	REQUIRE(hull.hull() == ConvexPolygon<Vector2>{ { 0, 0 }, { 4, 0 }, { 20, 2 }, { 4, 4 }, { 0, 4 } });
+
+	// the hull matches contains on the polygon at any time
+	hull.clear();
+	REQUIRE(hull.empty());
+	auto points = makePoints<int>(3000, 3, false);
+	auto probes = makePoints<int>(200, 4, false);
+	for (std::size_t i = 0; i < std::size(points); ++i)
+	{
+		hull.insert(points[i]);
+		if (i % 500 == 499)
+		{
+			auto polygon = hull.hull();
+			REQUIRE(polygon == convexHull(std::span{ points }.first(i + 1)));
+			for (auto& probe : probes)
+				REQUIRE(hull.contains(probe) == contains(polygon, probe));
+		}
+	}
+}
+
+TEST_CASE("Convex hull polygon test", "[ConvexHull]")
+{
+	using Vector2 = Vector<double, 2>;
+	static_assert(NDimensionalConvexPolygonalObject<ConvexPolygon<Vector2>, 2>);
+
+	auto hull = convexHull(std::vector<Vector2>{ { 0., 0. }, { 4., 0. }, { 2., 1. }, { 4., 4. }, { 0., 4. } });
+	REQUIRE(contains(hull, Vector2{ 1., 1. }));
+	REQUIRE(!contains(hull, Vector2{ 5., 1. }));
+	REQUIRE(intersects(hull, Segment<Vector2>{ { -1., 2. }, { 2., 0. } }));
+	REQUIRE(overlaps(hull, AABB_t<double>{ { 1., 1. }, { 1., 1. } }));
+	REQUIRE(!overlaps(hull, AABB_t<double>{ { 5., 5. }, { 1., 1. } }));
+	REQUIRE(intersects(hull, Polygon<Vector2>{ { 3., 3. }, { 6., 3. }, { 6., 6. } }));
+}
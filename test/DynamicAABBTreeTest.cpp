@@ -0,0 +1,180 @@
+//          Copyright Dominic Koepke 2017 - 2020.
+// Distributed under the Boost Software License, Version 1.0.
+//    (See accompanying file LICENSE_1_0.txt or copy at
+//          https://www.boost.org/LICENSE_1_0.txt)
+
+#include "catch.hpp"
+
+#include <algorithm>
+#include <random>
+#include <set>
+#include <utility>
+#include <vector>
+
+#include "georithm/Bounding.hpp"
+#include "georithm/DynamicAABBTree.hpp"
+#include "georithm/Rect.hpp"
+#include "georithm/Vector.hpp"
+
+#include "georithm/transform/Rotate.hpp"
+
+#include "RandomGeometry.hpp"
+
+namespace
+{
+	using namespace georithm;
+	using test::makeRects;
+
+	using Vector2_t = Vector<double, 2>;
+	using Rect_t = test::RotatedRect_t;
+	using Tree_t = DynamicAABBTree<double>;
+	using Pair_t = std::pair<std::size_t, std::size_t>;
+
+	// user data is the index into rects
+	std::set<Pair_t> collectPairs(const Tree_t& tree)
+	{
+		std::set<Pair_t> pairs;
+		tree.forEachOverlappingPair([&](auto lhs, auto rhs)
+			{
+				REQUIRE(lhs < rhs);
+				auto lhsIndex = tree.userData(lhs);
+				auto rhsIndex = tree.userData(rhs);
+				REQUIRE(pairs.emplace(std::min(lhsIndex, rhsIndex), std::max(lhsIndex, rhsIndex)).second);
+			}
+		);
+		return pairs;
+	}
+
+	std::set<Pair_t> bruteForcePairs(const std::vector<Rect_t>& rects, const std::vector<bool>& alive)
+	{
+		std::set<Pair_t> pairs;
+		for (std::size_t i = 0; i < std::size(rects); ++i)
+		{
+			for (std::size_t j = i + 1; j < std::size(rects); ++j)
+			{
+				if (alive[i] && alive[j] && detail::intersectsBounds(boundingRect(rects[i]), boundingRect(rects[j])))
+					pairs.emplace(i, j);
+			}
+		}
+		return pairs;
+	}
+}
+
+TEST_CASE("DynamicAABBTree query test", "[DynamicAABBTree]")
+{
+	auto rects = makeRects(300, 1);
+	Tree_t tree;
+	std::vector<Tree_t::ProxyId> proxies;
+	for (std::size_t i = 0; i < std::size(rects); ++i)
+		proxies.emplace_back(tree.insert(rects[i], i));
+	REQUIRE(std::size(tree) == std::size(rects));
+	REQUIRE(tree.height() <= 20);
+
+	for (auto& queryRect : makeRects(50, 2))
+	{
+		std::set<std::size_t> found;
+		tree.query(queryRect, [&](auto proxyId) { REQUIRE(found.emplace(tree.userData(proxyId)).second); });
+
+		std::set<std::size_t> expected;
+		for (std::size_t i = 0; i < std::size(rects); ++i)
+		{
+			if (detail::intersectsBounds(boundingRect(queryRect), boundingRect(rects[i])))
+				expected.emplace(i);
+		}
+		REQUIRE(found == expected);
+	}
+
+	SECTION("early stop")
+	{
+		int calls = 0;
+		tree.query(AABB_t<double>{ { -200., -200. }, { 400., 400. } }, [&](auto) { return ++calls < 5; });
+		REQUIRE(calls == 5);
+	}
+
+	SECTION("remove")
+	{
+		std::vector<bool> alive(std::size(rects), true);
+		for (std::size_t i = 0; i < std::size(rects); i += 3)
+		{
+			tree.remove(proxies[i]);
+			alive[i] = false;
+		}
+		REQUIRE(collectPairs(tree) == bruteForcePairs(rects, alive));
+
+		// freed nodes are reused
+		tree.insert(rects[0], 0);
+		alive[0] = true;
+		REQUIRE(collectPairs(tree) == bruteForcePairs(rects, alive));
+	}
+
+	SECTION("clear")
+	{
+		tree.clear();
+		REQUIRE(tree.empty());
+		REQUIRE(std::empty(collectPairs(tree)));
+	}
+}
+
+TEST_CASE("DynamicAABBTree pair and move test", "[DynamicAABBTree]")
+{
+	auto rects = makeRects(200, 3);
+	std::vector<bool> alive(std::size(rects), true);
+
+	Tree_t tree;
+	std::vector<Tree_t::ProxyId> proxies;
+	for (std::size_t i = 0; i < std::size(rects); ++i)
+		proxies.emplace_back(tree.insert(rects[i], i));
+
+	REQUIRE(collectPairs(tree) == bruteForcePairs(rects, alive));
+
+	std::mt19937 engine{ 4 };
+	std::uniform_real_distribution<double> displacementDist{ -20., 20. };
+	for (std::size_t i = 0; i < std::size(rects); i += 2)
+	{
+		Vector2_t displacement{ displacementDist(engine), displacementDist(engine) };
+		rects[i].position() += displacement;
+		REQUIRE(tree.move(proxies[i], rects[i]));
+	}
+	REQUIRE(collectPairs(tree) == bruteForcePairs(rects, alive));
+	REQUIRE(tree.height() <= 20);
+}
+
+TEST_CASE("DynamicAABBTree fat margin test", "[DynamicAABBTree]")
+{
+	DynamicAABBTree<int> tree{ 2 };
+	AABB_t<int> rect{ { 0, 0 }, { 4, 4 } };
+	auto proxyId = tree.insert(rect, 0);
+	REQUIRE(tree.fatBounds(proxyId) == AABB_t<int>{ { -2, -2 }, { 8, 8 } });
+
+	// small movements stay inside the fat bounds
+	rect.position() = { 1, -2 };
+	REQUIRE_FALSE(tree.move(proxyId, rect));
+
+	rect.position() = { 3, 0 };
+	REQUIRE(tree.move(proxyId, rect, Vector{ 3, -1 }));
+	REQUIRE(tree.fatBounds(proxyId) == AABB_t<int>{ { 1, -3 }, { 11, 9 } });
+
+	tree.insert(AABB_t<int>{ { 12, 0 }, { 1, 1 } }, 1);
+	int count = 0;
+	tree.forEachOverlappingPair([&](auto, auto) { ++count; });
+	REQUIRE(count == 1);
+}
+
+TEST_CASE("DynamicAABBTree other value types test", "[DynamicAABBTree]")
+{
+	// the bounds of the objects are converted to the value type of the tree
+	Tree_t tree{ 0. };
+	auto proxyId = tree.insert(AABB_t<int>{ { 1, 2 }, { 3, 4 } }, 0);
+	REQUIRE(tree.fatBounds(proxyId) == AABB_t<double>{ { 1., 2. }, { 3., 4. } });
+	REQUIRE(tree.move(proxyId, AABB_t<int>{ { 10, 2 }, { 3, 4 } }));
+	REQUIRE(tree.fatBounds(proxyId) == AABB_t<double>{ { 10., 2. }, { 3., 4. } });
+
+	int count = 0;
+	tree.query(AABB_t<int>{ { 0, 0 }, { 10, 2 } }, [&](auto) { ++count; });
+	REQUIRE(count == 1);
+
+	// integral trees round the bounds outwards, thus they still enclose the objects
+	DynamicAABBTree<int> intTree{ 0 };
+	proxyId = intTree.insert(AABB_t<double>{ { 0.5, -1.5 }, { 1., 2. } }, 0);
+	REQUIRE(intTree.fatBounds(proxyId) == AABB_t<int>{ { 0, -2 }, { 2, 3 } });
+}
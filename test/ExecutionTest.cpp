@@ -0,0 +1,248 @@
+//          Copyright Dominic Koepke 2017 - 2020.
+// Distributed under the Boost Software License, Version 1.0.
+//    (See accompanying file LICENSE_1_0.txt or copy at
+//          https://www.boost.org/LICENSE_1_0.txt)
+
+#include "catch.hpp"
+
+#include <algorithm>
+#include <span>
+#include <vector>
+
+#include "georithm/Bounding.hpp"
+#include "georithm/CachedRect.hpp"
+#include "georithm/Contains.hpp"
+#include "georithm/Execution.hpp"
+#include "georithm/Intersects.hpp"
+#include "georithm/Line.hpp"
+#include "georithm/LineSoA.hpp"
+#include "georithm/Overlaps.hpp"
+#include "georithm/Polygon.hpp"
+#include "georithm/Rect.hpp"
+#include "georithm/ThreadPool.hpp"
+#include "georithm/Vector.hpp"
+#include "georithm/VectorSoA.hpp"
+
+#include "georithm/transform/Affine.hpp"
+#include "georithm/transform/Rotate.hpp"
+#include "georithm/transform/TransformEach.hpp"
+#include "georithm/transform/Translate.hpp"
+
+#include "RandomGeometry.hpp"
+
+namespace
+{
+	using namespace georithm;
+
+	using test::makePoints;
+	using test::makeRects;
+
+	using Vector2_t = Vector<double, 2>;
+	using Rect_t = test::RotatedRect_t;
+
+	// more than a single chunk of the parallel policies
+	constexpr std::size_t elementCount = 10'000;
+
+	// the results of each policy; the results of seq are the reference of the others
+	template <class TFunc>
+	void requireSameForAllPolicies(ThreadPool& pool, TFunc func)
+	{
+		auto expected = func(execution::seq);
+		REQUIRE(func(execution::unseq) == expected);
+		REQUIRE(func(execution::par.on(pool)) == expected);
+		REQUIRE(func(execution::par_unseq.on(pool)) == expected);
+	}
+}
+
+TEST_CASE("Execution policy bounding test", "[Execution]")
+{
+	ThreadPool pool{ GENERATE(1u, 4u) };
+	auto points = makePoints(elementCount, 1);
+	REQUIRE(boundingRect(execution::seq, points) == boundingRect(points));
+	requireSameForAllPolicies(pool, [&](const auto& policy) { return boundingRect(policy, points); });
+	requireSameForAllPolicies(pool, [&](const auto& policy) { return boundingRect(policy, std::span{ points }.first(1)); });
+
+	auto rects = makeRects(elementCount, 2);
+	requireSameForAllPolicies(pool, [&](const auto& policy)
+		{
+			std::vector<AABB_t<double>> result(std::size(rects));
+			REQUIRE(boundingRects(policy, rects, std::begin(result)) == std::end(result));
+			return result;
+		}
+	);
+}
+
+TEST_CASE("Execution policy contains test", "[Execution]")
+{
+	ThreadPool pool{ GENERATE(1u, 4u) };
+	auto points = makePoints(elementCount, 3);
+	Polygon<Vector2_t> polygon{ { -50., -50. }, { 0., -20. }, { 50., -50. }, { 50., 50. }, { 0., 20. }, { -50., 50. } };
+	Rect_t rect{ { -10., -10. }, { 60., 30. } };
+	rect.rotation() = 0.5;
+
+	auto containsAll = [&](const auto& policy, const auto& geometry)
+	{
+		// not std::vector<bool>, which can't be written concurrently
+		std::vector<char> result(std::size(points));
+		contains(policy, geometry, points, std::begin(result));
+		return result;
+	};
+	requireSameForAllPolicies(pool, [&](const auto& policy) { return containsAll(policy, polygon); });
+	requireSameForAllPolicies(pool, [&](const auto& policy) { return containsAll(policy, rect); });
+
+	auto expected = containsAll(execution::seq, polygon);
+	for (std::size_t i = 0; i < std::size(points); ++i)
+		REQUIRE((expected[i] != 0) == contains(polygon, points[i]));
+	REQUIRE(std::ranges::count(expected, 1) != 0);
+}
+
+TEST_CASE("Execution policy intersects and overlaps test", "[Execution]")
+{
+	ThreadPool pool{ GENERATE(1u, 4u) };
+	auto rects = makeRects(elementCount, 4);
+	Rect_t lhsRect{ { -30., -20. }, { 50., 40. } };
+	lhsRect.rotation() = 1.;
+	Polygon<Vector2_t> lhsPolygon{ { -50., -50. }, { 0., -20. }, { 50., -50. }, { 50., 50. }, { 0., 20. }, { -50., 50. } };
+	Segment<Vector2_t> lhsSegment{ { -80., -70. }, { 150., 130. } };
+
+	auto testAll = [&](const auto& policy, const auto& lhs, auto test)
+	{
+		std::vector<char> result(std::size(rects));
+		REQUIRE(test(policy, lhs, rects, std::begin(result)) == std::end(result));
+		return result;
+	};
+	auto intersectsTest = [](const auto&... args) { return intersects(args...); };
+	auto overlapsTest = [](const auto&... args) { return overlaps(args...); };
+
+	requireSameForAllPolicies(pool, [&](const auto& policy) { return testAll(policy, lhsRect, intersectsTest); });
+	requireSameForAllPolicies(pool, [&](const auto& policy) { return testAll(policy, lhsPolygon, intersectsTest); });
+	requireSameForAllPolicies(pool, [&](const auto& policy) { return testAll(policy, lhsSegment, intersectsTest); });
+	requireSameForAllPolicies(pool, [&](const auto& policy) { return testAll(policy, lhsRect, overlapsTest); });
+	requireSameForAllPolicies(pool, [&](const auto& policy) { return testAll(policy, lhsPolygon, overlapsTest); });
+
+	auto expectedIntersects = testAll(execution::seq, lhsPolygon, intersectsTest);
+	auto expectedOverlaps = testAll(execution::seq, lhsPolygon, overlapsTest);
+	for (std::size_t i = 0; i < std::size(rects); ++i)
+	{
+		REQUIRE((expectedIntersects[i] != 0) == intersects(lhsPolygon, rects[i]));
+		REQUIRE((expectedOverlaps[i] != 0) == overlaps(lhsPolygon, rects[i]));
+	}
+	REQUIRE(std::ranges::count(expectedOverlaps, 1) != 0);
+	REQUIRE(std::ranges::count(expectedOverlaps, 0) != 0);
+}
+
+TEST_CASE("Execution policy lazily cached lhs test", "[Execution]")
+{
+	using Rotate_t = transform::Rotate<Vector2_t>;
+	using Translate_t = transform::Translate<Vector2_t>;
+	using ChainRect_t = Rect<double, transform::AffineChain<Vector2_t, Rotate_t, Translate_t>>;
+
+	ThreadPool pool{ GENERATE(1u, 4u) };
+	auto rects = makeRects(elementCount, 7);
+	auto points = makePoints(elementCount, 8);
+
+	// each call gets a fresh lhs, whose caches are still dirty, thus the threads would race on their first update
+	auto makeChainRect = []()
+	{
+		ChainRect_t rect{ { -30., -20. }, { 50., 40. } };
+		rect.component<Rotate_t>().rotation() = 1.;
+		rect.component<Translate_t>().translation() = { 5., -5. };
+		return rect;
+	};
+	auto makeCachedRect = []()
+	{
+		Rect_t rect{ { -30., -20. }, { 50., 40. } };
+		rect.rotation() = 1.;
+		return CachedRect{ rect };
+	};
+
+	auto testAll = [&](const auto& policy, auto makeLhs)
+	{
+		const auto lhs = makeLhs();
+		std::vector<char> result(3 * elementCount);
+		contains(policy, lhs, points, std::begin(result));
+		intersects(policy, lhs, rects, std::begin(result) + elementCount);
+		overlaps(policy, lhs, rects, std::begin(result) + 2 * elementCount);
+		return result;
+	};
+	requireSameForAllPolicies(pool, [&](const auto& policy) { return testAll(policy, makeChainRect); });
+	requireSameForAllPolicies(pool, [&](const auto& policy) { return testAll(policy, makeCachedRect); });
+}
+
+TEST_CASE("Execution policy line intersection test", "[Execution]")
+{
+	ThreadPool pool{ GENERATE(1u, 4u) };
+	auto locations = makePoints(elementCount, 5);
+	auto directions = makePoints(elementCount, 6);
+	SegmentSoA<double> segments;
+	for (std::size_t i = 0; i < elementCount; ++i)
+		segments.push_back({ locations[i], directions[i] });
+	// parallel and collinear ones as well
+	segments.set(0, { { 0., 1. }, { 2., 0. } });
+	segments.set(1, { { 1., 0. }, { 3., 0. } });
+	Segment<Vector2_t> line{ { 0., 0. }, { 5., 0. } };
+
+	requireSameForAllPolicies(pool, [&](const auto& policy)
+		{
+			std::vector<LineIntersectionResult> results(elementCount);
+			std::vector<double> lineDistances(elementCount);
+			std::vector<double> batchDistances(elementCount);
+			intersection(policy, line, segments, std::span{ results }, std::span{ lineDistances }, std::span{ batchDistances });
+			return std::tuple{ results, lineDistances, batchDistances };
+		}
+	);
+}
+
+TEST_CASE("Execution policy vector transformation test", "[Execution]")
+{
+	ThreadPool pool{ GENERATE(1u, 4u) };
+	auto points = makePoints(elementCount, 7);
+	points[0] = { 3., 4. };
+	VectorSoA<double, 2> vectors{ points };
+
+	SECTION("normalize")
+	{
+		requireSameForAllPolicies(pool, [&](const auto& policy) { return normalize(policy, vectors); });
+		REQUIRE(normalize(execution::unseq, vectors) == normalize(vectors));
+		REQUIRE(normalize(execution::seq, vectors)[0] == Vector2_t{ 0.6, 0.8 });
+	}
+
+	SECTION("rotate")
+	{
+		auto expected = rotate(execution::seq, vectors, 0.7);
+		for (std::size_t i = 0; i < std::size(points); ++i)
+			REQUIRE(expected[i] == rotate(points[i], 0.7));
+		requireSameForAllPolicies(pool, [&](const auto& policy) { return rotate(policy, vectors, 0.7); });
+
+		VectorSoA<int, 2> intVectors{ std::vector<Vector<int, 2>>{ { 10, 0 }, { 3, -7 }, { -100, 42 } } };
+		requireSameForAllPolicies(pool, [&](const auto& policy) { return rotate(policy, intVectors, 1.2); });
+		REQUIRE(rotate(execution::seq, intVectors, 1.2) == rotate(intVectors, 1.2));
+	}
+
+	SECTION("transformers")
+	{
+		transform::Rotate<Vector2_t> rotation{ 0.7 };
+		requireSameForAllPolicies(pool, [&](const auto& policy)
+			{
+				auto result = points;
+				transformEach(policy, rotation, result);
+				return result;
+			}
+		);
+
+		auto rotated = points;
+		transformEach(execution::par.on(pool), rotation, rotated);
+		for (std::size_t i = 0; i < std::size(points); ++i)
+			REQUIRE(rotated[i] == rotation.transform(points[i]));
+
+		using Chain_t = transform::AffineChain<Vector2_t, transform::Rotate<Vector2_t>, transform::Translate<Vector2_t>>;
+		Chain_t chain{ transform::Rotate<Vector2_t>{ 0.3 }, transform::Translate<Vector2_t>{ { 1., -2. } } };
+		requireSameForAllPolicies(pool, [&](const auto& policy)
+			{
+				auto result = points;
+				transformEach(policy, chain, result);
+				return result;
+			}
+		);
+	}
+}
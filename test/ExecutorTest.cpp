@@ -0,0 +1,113 @@
+//          Copyright Dominic Koepke 2017 - 2020.
+// Distributed under the Boost Software License, Version 1.0.
+//    (See accompanying file LICENSE_1_0.txt or copy at
+//          https://www.boost.org/LICENSE_1_0.txt)
+
+#include "catch.hpp"
+
+#include <algorithm>
+#include <cstddef>
+#include <random>
+#include <vector>
+
+#include "georithm/BatchQuery.hpp"
+#include "georithm/Executor.hpp"
+#include "georithm/LinearBvh.hpp"
+#include "georithm/Rect.hpp"
+#include "georithm/ThreadPool.hpp"
+
+namespace
+{
+	using namespace georithm;
+
+	// pretends to be parallel, but runs all chunks on the calling thread and counts them
+	class CountingExecutor final :
+		public Executor
+	{
+	public:
+		std::size_t runCount = 0;
+		std::size_t chunkCount = 0;
+
+		[[nodiscard]] std::size_t concurrency() const noexcept override
+		{
+			return 4;
+		}
+
+	protected:
+		void runChunks(std::size_t chunkCount_, ChunkFunctionRef runChunk) override
+		{
+			++runCount;
+			chunkCount += chunkCount_;
+			// reversed, thus callers can't rely on the order of the chunks
+			for (auto chunk = chunkCount_; 0 < chunk; --chunk)
+				runChunk(chunk - 1);
+		}
+	};
+}
+
+TEST_CASE("Executor parallelReduce test", "[Executor]")
+{
+	std::mt19937 engine{ 1 };
+	std::uniform_real_distribution<double> valueDist{ -1e10, 1e10 };
+	std::vector<double> values(100'000);
+	for (auto& value : values)
+		value = valueDist(engine);
+
+	auto sumChunks = [&](std::size_t begin, std::size_t end)
+	{
+		double sum = 0.;
+		for (auto i = begin; i < end; ++i)
+			sum += values[i];
+		return sum;
+	};
+	auto plus = [](double lhs, double rhs) { return lhs + rhs; };
+
+	// chunks are combined in order, thus even rounding doesn't depend on the executor
+	SequentialExecutor sequential;
+	auto expected = sequential.parallelReduce(std::size(values), 1000, 0., sumChunks, plus);
+	ThreadPool pool{ GENERATE(2u, 8u) };
+	CountingExecutor counting;
+	for (int i = 0; i < 10; ++i)
+		REQUIRE(pool.parallelReduce(std::size(values), 1000, 0., sumChunks, plus) == expected);
+	REQUIRE(counting.parallelReduce(std::size(values), 1000, 0., sumChunks, plus) == expected);
+	REQUIRE(counting.chunkCount == 100);
+
+	REQUIRE(pool.parallelReduce(0, 10, 42, [](std::size_t, std::size_t) { return 1; }, plus) == 42);
+	REQUIRE(pool.parallelReduce(10, 1, false, [](std::size_t begin, std::size_t) { return begin == 7; },
+								[](bool lhs, bool rhs) { return lhs || rhs; }));
+}
+
+TEST_CASE("SequentialExecutor test", "[Executor]")
+{
+	SequentialExecutor executor;
+	REQUIRE(executor.concurrency() == 1);
+
+	std::vector<std::size_t> begins;
+	executor.parallelFor(25, 10, [&](std::size_t begin, std::size_t end)
+		{
+			REQUIRE(end - begin <= 10);
+			begins.emplace_back(begin);
+		}
+	);
+	REQUIRE(begins == std::vector<std::size_t>{ 0, 10, 20 });
+}
+
+TEST_CASE("Default executor hook test", "[Executor]")
+{
+	std::vector<AABB_t<float>> rects;
+	for (int i = 0; i < 100'000; ++i)
+		rects.push_back({ { static_cast<float>(i % 1000), static_cast<float>(i / 1000) }, { 1.f, 1.f } });
+
+	REQUIRE(&defaultExecutor() == &defaultThreadPool());
+	CountingExecutor executor;
+	setDefaultExecutor(&executor);
+	auto bvh = buildLinearBvh(rects);
+	auto result = batchQuery(bvh, rects);
+	setDefaultExecutor(nullptr);
+	REQUIRE(&defaultExecutor() == &defaultThreadPool());
+
+	// the algorithms ran on the custom executor and produced the same results as on the pool
+	REQUIRE(0 < executor.runCount);
+	REQUIRE(result == batchQuery(bvh, rects, defaultThreadPool()));
+	REQUIRE(std::ranges::equal(bvh.objectIndices(), buildLinearBvh(rects, defaultThreadPool()).objectIndices()));
+}
@@ -0,0 +1,143 @@
+//          Copyright Dominic Koepke 2017 - 2020.
+// Distributed under the Boost Software License, Version 1.0.
+//    (See accompanying file LICENSE_1_0.txt or copy at
+//          https://www.boost.org/LICENSE_1_0.txt)
+
+#include "catch.hpp"
+
+#include <random>
+#include <type_traits>
+#include <vector>
+
+#include "georithm/Intersection.hpp"
+#include "georithm/Line.hpp"
+#include "georithm/LineSoA.hpp"
+#include "georithm/Vector.hpp"
+
+namespace
+{
+	using namespace georithm;
+
+	template <class TLine, class T, LineType TLineType>
+	void requireSameAsSingle(const TLine& line, const LineSoA<T, TLineType>& lines)
+	{
+		std::vector<LineIntersectionResult> results(std::size(lines));
+		std::vector<T> lineDistances(std::size(lines));
+		std::vector<T> batchDistances(std::size(lines));
+		intersection(line, lines, std::span{ results }, std::span{ lineDistances }, std::span{ batchDistances });
+
+		for (std::size_t i = 0; i < std::size(lines); ++i)
+		{
+			auto [result, lineDist, batchDist] = intersection(line, lines[i]);
+			REQUIRE(results[i] == result);
+			REQUIRE(lineDistances[i] == lineDist);
+			REQUIRE(batchDistances[i] == batchDist);
+		}
+	}
+}
+
+TEST_CASE("LineSoA container test", "[LineSoA]")
+{
+	using Vector2 = Vector<int, 2>;
+
+	SegmentSoA<int> segments;
+	REQUIRE(segments.empty());
+
+	segments.push_back({ { 1, 2 }, { 3, 4 } });
+	segments.push_back({ { 5, 6 }, { 7, 8 } });
+	REQUIRE(std::size(segments) == 2);
+	REQUIRE(segments[1] == Segment<Vector2>{ { 5, 6 }, { 7, 8 } });
+	REQUIRE(segments.locations().lane(1)[0] == 2);
+	REQUIRE(segments.directions().lane(0)[1] == 7);
+
+	segments.set(0, { { -1, -2 }, { -3, -4 } });
+	REQUIRE(segments[0] == Segment<Vector2>{ { -1, -2 }, { -3, -4 } });
+
+	std::vector<Segment<Vector2>> aos{ { { -1, -2 }, { -3, -4 } }, { { 5, 6 }, { 7, 8 } } };
+	REQUIRE(SegmentSoA<int>{ aos } == segments);
+
+	segments.clear();
+	REQUIRE(segments.empty());
+}
+
+TEMPLATE_TEST_CASE("LineSoA batch intersection test", "[LineSoA]", int, float, double)
+{
+	using Vector2 = Vector<TestType, 2>;
+	auto makeLine = []<class TLine>(std::type_identity<TLine>, int x, int y, int dirX, int dirY)
+	{
+		return TLine{ { static_cast<TestType>(x), static_cast<TestType>(y) }, { static_cast<TestType>(dirX), static_cast<TestType>(dirY) } };
+	};
+	auto makeSegment = [&](int x, int y, int dirX, int dirY) { return makeLine(std::type_identity<Segment<Vector2>>{}, x, y, dirX, dirY); };
+
+	// covers the intersecting, none, parallel and collinear cases
+	SegmentSoA<TestType> segments{ std::vector{
+		makeSegment(0, 2, 4, -4),
+		makeSegment(5, 0, 1, -2),
+		makeSegment(0, 1, 2, 2),
+		makeSegment(3, 3, 1, 1),
+		makeSegment(2, 0, 0, 4)
+	} };
+
+	requireSameAsSingle(makeSegment(0, 0, 2, 2), segments);
+	requireSameAsSingle(makeLine(std::type_identity<Ray<Vector2>>{}, 0, 0, 2, 2), segments);
+	requireSameAsSingle(makeLine(std::type_identity<Line<Vector2>>{}, 0, 0, 2, 2), segments);
+
+	std::vector<LineIntersectionResult> results(std::size(segments));
+	std::vector<TestType> lineDistances(std::size(segments));
+	std::vector<TestType> batchDistances(std::size(segments));
+	intersection(makeLine(std::type_identity<Ray<Vector2>>{}, 0, 0, 1, 1), segments, std::span{ results }, std::span{ lineDistances }, std::span{ batchDistances });
+	REQUIRE(results == std::vector{
+		LineIntersectionResult::intersecting,
+		LineIntersectionResult::none,
+		LineIntersectionResult::parallel,
+		LineIntersectionResult::collinear,
+		LineIntersectionResult::intersecting
+	});
+	REQUIRE(lineDistances[4] == 2);
+}
+
+TEST_CASE("LineSoA random batch intersection test", "[LineSoA]")
+{
+	using Vector2 = Vector<double, 2>;
+
+	std::mt19937 engine{ 3 };
+	std::uniform_real_distribution<double> dist{ -10., 10. };
+	auto makeVector = [&]() { return Vector2{ dist(engine), dist(engine) }; };
+
+	std::vector<Segment<Vector2>> aos;
+	for (int i = 0; i < 200; ++i)
+		aos.emplace_back(makeVector(), makeVector());
+	SegmentSoA<double> segments{ aos };
+
+	for (int i = 0; i < 20; ++i)
+	{
+		requireSameAsSingle(Segment<Vector2>{ makeVector(), makeVector() }, segments);
+		requireSameAsSingle(Ray<Vector2>{ makeVector(), makeVector() }, segments);
+		requireSameAsSingle(Line<Vector2>{ makeVector(), makeVector() }, segments);
+	}
+
+	SECTION("pairwise")
+	{
+		LineSoA<double, LineType::ray> rays;
+		for (int i = 0; i < 15; ++i)
+			rays.push_back({ makeVector(), makeVector() });
+
+		auto count = std::size(rays) * std::size(segments);
+		std::vector<LineIntersectionResult> results(count);
+		std::vector<double> lhsDistances(count);
+		std::vector<double> rhsDistances(count);
+		intersection(rays, segments, std::span{ results }, std::span{ lhsDistances }, std::span{ rhsDistances });
+
+		for (std::size_t i = 0; i < std::size(rays); ++i)
+		{
+			for (std::size_t j = 0; j < std::size(segments); ++j)
+			{
+				auto [result, lhsDist, rhsDist] = intersection(rays[i], segments[j]);
+				auto index = i * std::size(segments) + j;
+				REQUIRE(results[index] == result);
+				REQUIRE(lhsDistances[index] == lhsDist);
+				REQUIRE(rhsDistances[index] == rhsDist);
+			}
+		}
+	}
+}
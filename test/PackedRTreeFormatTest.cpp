@@ -0,0 +1,197 @@
+//          Copyright Dominic Koepke 2017 - 2020.
+// Distributed under the Boost Software License, Version 1.0.
+//    (See accompanying file LICENSE_1_0.txt or copy at
+//          https://www.boost.org/LICENSE_1_0.txt)
+
+#include "catch.hpp"
+
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <random>
+#include <set>
+#include <span>
+#include <sstream>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "georithm/PackedRTree.hpp"
+#include "georithm/PackedRTreeFormat.hpp"
+#include "georithm/Rect.hpp"
+#include "georithm/Vector.hpp"
+
+namespace
+{
+	using namespace georithm;
+
+	// stands in for a page aligned mapping of the file
+	class Buffer
+	{
+	public:
+		explicit Buffer(const std::string& content) :
+			m_Storage((std::size(content) + sizeof(std::uint64_t) - 1) / sizeof(std::uint64_t)),
+			m_Size{ std::size(content) }
+		{
+			std::memcpy(std::data(m_Storage), std::data(content), m_Size);
+		}
+
+		[[nodiscard]] std::span<std::byte> bytes() noexcept
+		{
+			return { reinterpret_cast<std::byte*>(std::data(m_Storage)), m_Size };
+		}
+
+	private:
+		std::vector<std::uint64_t> m_Storage;
+		std::size_t m_Size;
+	};
+
+	template <class T, std::size_t NodeSize>
+	std::string serializeToString(const PackedRTree<T, NodeSize>& tree)
+	{
+		std::ostringstream out;
+		serialize(tree, out);
+		REQUIRE(out.good());
+		return std::move(out).str();
+	}
+
+	std::vector<AABB_t<float>> makeBoxes(std::size_t count, unsigned seed)
+	{
+		std::mt19937 engine{ seed };
+		std::uniform_real_distribution<float> positionDist{ -100.f, 100.f };
+		std::uniform_real_distribution<float> spanDist{ 0.5f, 10.f };
+		std::vector<AABB_t<float>> boxes;
+		for (std::size_t i = 0; i < count; ++i)
+			boxes.push_back({ { positionDist(engine), positionDist(engine) }, { spanDist(engine), spanDist(engine) } });
+		return boxes;
+	}
+
+	template <class TTree>
+	std::set<std::size_t> collectQuery(const TTree& tree, const AABB_t<float>& bounds)
+	{
+		std::set<std::size_t> found;
+		tree.query(bounds, [&](std::size_t index) { found.emplace(index); });
+		return found;
+	}
+}
+
+TEST_CASE("PackedRTree format round trip test", "[PackedRTreeFormat]")
+{
+	auto boxes = makeBoxes(500, 1);
+	PackedRTree<float> tree{ boxes };
+	auto content = serializeToString(tree);
+	REQUIRE(std::size(content) == serializedSize(tree));
+
+	Buffer buffer{ content };
+	auto view = openPackedRTree<float, 16>(buffer.bytes());
+	REQUIRE(view);
+	REQUIRE(std::size(*view) == std::size(tree));
+	REQUIRE(view->levelCount() == tree.levelCount());
+	REQUIRE(view->bounds() == tree.bounds());
+
+	// the view refers to the buffer instead of a copy
+	REQUIRE(static_cast<const void*>(std::data(view->nodeBounds())) == std::data(buffer.bytes()) + 64);
+
+	for (auto& box : makeBoxes(50, 2))
+		REQUIRE(collectQuery(*view, box) == collectQuery(tree, box));
+
+	SECTION("empty tree")
+	{
+		PackedRTree<float> emptyTree{ std::vector<AABB_t<float>>{} };
+		auto emptyContent = serializeToString(emptyTree);
+		REQUIRE(std::size(emptyContent) == 64);
+		Buffer emptyBuffer{ emptyContent };
+		auto emptyView = openPackedRTree<float, 16>(emptyBuffer.bytes());
+		REQUIRE(emptyView);
+		REQUIRE(emptyView->empty());
+		REQUIRE(std::empty(collectQuery(*emptyView, boxes[0])));
+	}
+}
+
+TEST_CASE("PackedRTree format layout test", "[PackedRTreeFormat]")
+{
+	std::vector boxes{ AABB_t<std::int32_t>{ { 1, 2 }, { 3, 4 } }, AABB_t<std::int32_t>{ { -1, 0 }, { 1, 1 } } };
+	PackedRTree<std::int32_t, 4> tree{ boxes };
+	auto content = serializeToString(tree);
+
+	// header, 3 nodes of 16 bytes padded to 64, 3 indices padded to 64, 2 level ends
+	REQUIRE(std::size(content) == 64 + 64 + 64 + 8);
+	REQUIRE(content.substr(0, 8) == "GEORTREE");
+
+	auto readUInt32 = [&](std::size_t offset)
+	{
+		std::uint32_t value = 0;
+		for (std::size_t i = 0; i < 4; ++i)
+			value |= static_cast<std::uint32_t>(static_cast<unsigned char>(content[offset + i])) << (8 * i);
+		return value;
+	};
+	// version, value type (signed, 4 bytes), node size, level count
+	REQUIRE(readUInt32(8) == 1);
+	REQUIRE(readUInt32(12) == 0x104);
+	REQUIRE(readUInt32(16) == 4);
+	REQUIRE(readUInt32(20) == 2);
+
+	// root bounds and level ends, explicitly in little endian
+	REQUIRE(static_cast<std::int32_t>(readUInt32(64 + 32)) == -1);
+	REQUIRE(static_cast<std::int32_t>(readUInt32(64 + 36)) == 0);
+	REQUIRE(readUInt32(64 + 40) == 5);
+	REQUIRE(readUInt32(64 + 44) == 6);
+	REQUIRE(readUInt32(192) == 2);
+	REQUIRE(readUInt32(196) == 3);
+}
+
+TEST_CASE("PackedRTree format validation test", "[PackedRTreeFormat]")
+{
+	PackedRTree<float> tree{ makeBoxes(100, 3) };
+	auto content = serializeToString(tree);
+
+	SECTION("valid")
+	{
+		Buffer buffer{ content };
+		REQUIRE(openPackedRTree<float, 16>(buffer.bytes()));
+	}
+
+	SECTION("mismatching tree type")
+	{
+		Buffer buffer{ content };
+		REQUIRE_FALSE(openPackedRTree<double, 16>(buffer.bytes()));
+		REQUIRE_FALSE(openPackedRTree<std::int32_t, 16>(buffer.bytes()));
+		REQUIRE_FALSE(openPackedRTree<float, 8>(buffer.bytes()));
+	}
+
+	SECTION("corrupted header")
+	{
+		auto offset = GENERATE(0, 8, 20, 24);
+		content[offset] ^= 0x7F;
+		Buffer buffer{ content };
+		REQUIRE_FALSE(openPackedRTree<float, 16>(buffer.bytes()));
+	}
+
+	SECTION("truncated")
+	{
+		Buffer buffer{ content.substr(0, std::size(content) - 1) };
+		REQUIRE_FALSE(openPackedRTree<float, 16>(buffer.bytes()));
+		REQUIRE_FALSE(openPackedRTree<float, 16>(buffer.bytes().first(32)));
+	}
+
+	SECTION("misaligned")
+	{
+		Buffer buffer{ " " + content };
+		REQUIRE_FALSE(openPackedRTree<float, 16>(buffer.bytes().subspan(1)));
+	}
+
+	SECTION("corrupted indices")
+	{
+		Buffer buffer{ content };
+		REQUIRE(openPackedRTree<float, 16>(buffer.bytes(), PackedRTreeValidation::full));
+
+		// the first leaf refers to a non existing object, or the first inner node to the second leaf
+		auto [position, index] = GENERATE(std::pair<std::size_t, std::uint32_t>{ 0, 100 }, std::pair<std::size_t, std::uint32_t>{ 100, 1 });
+		auto indicesOffset = reinterpret_cast<const std::byte*>(std::data(openPackedRTree<float, 16>(buffer.bytes())->nodeIndices())) -
+			std::data(buffer.bytes());
+		std::memcpy(std::data(buffer.bytes()) + indicesOffset + position * sizeof(std::uint32_t), &index, sizeof(index));
+		REQUIRE(openPackedRTree<float, 16>(buffer.bytes()));
+		REQUIRE_FALSE(openPackedRTree<float, 16>(buffer.bytes(), PackedRTreeValidation::full));
+	}
+}
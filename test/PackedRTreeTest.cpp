@@ -0,0 +1,185 @@
+//          Copyright Dominic Koepke 2017 - 2020.
+// Distributed under the Boost Software License, Version 1.0.
+//    (See accompanying file LICENSE_1_0.txt or copy at
+//          https://www.boost.org/LICENSE_1_0.txt)
+
+#include "catch.hpp"
+
+#include <cstdint>
+#include <cstdlib>
+#include <iterator>
+#include <limits>
+#include <map>
+#include <random>
+#include <set>
+#include <utility>
+#include <vector>
+
+#include "georithm/Bounding.hpp"
+#include "georithm/Intersection.hpp"
+#include "georithm/Line.hpp"
+#include "georithm/Overlaps.hpp"
+#include "georithm/PackedRTree.hpp"
+#include "georithm/Rect.hpp"
+#include "georithm/Vector.hpp"
+
+#include "georithm/transform/Rotate.hpp"
+
+#include "RandomGeometry.hpp"
+
+namespace
+{
+	using namespace georithm;
+	using test::makeRects;
+
+	using Vector2_t = Vector<double, 2>;
+	using Rect_t = test::RotatedRect_t;
+
+	template <class TTree, class TObject>
+	std::set<std::size_t> collectQuery(const TTree& tree, const TObject& object)
+	{
+		std::set<std::size_t> found;
+		tree.query(object, [&](std::size_t index) { REQUIRE(found.emplace(index).second); });
+		return found;
+	}
+}
+
+TEST_CASE("Hilbert index test", "[PackedRTree]")
+{
+	constexpr std::uint32_t maxCell = (1u << detail::hilbertOrder) - 1;
+	REQUIRE(detail::hilbertIndex(0, 0) == 0);
+	REQUIRE(detail::hilbertIndex(maxCell, 0) == std::numeric_limits<std::uint32_t>::max());
+
+	// consecutive indices of the lower left corner are always adjacent cells
+	constexpr std::uint32_t gridSize = 64;
+	std::map<std::uint32_t, std::pair<std::uint32_t, std::uint32_t>> cells;
+	for (std::uint32_t x = 0; x < gridSize; ++x)
+	{
+		for (std::uint32_t y = 0; y < gridSize; ++y)
+			REQUIRE(cells.try_emplace(detail::hilbertIndex(x, y), x, y).second);
+	}
+	for (auto iter = std::begin(cells), next = std::next(iter); next != std::end(cells); ++iter, ++next)
+	{
+		if (next->first != iter->first + 1)
+			continue;
+		auto dx = static_cast<int>(next->second.first) - static_cast<int>(iter->second.first);
+		auto dy = static_cast<int>(next->second.second) - static_cast<int>(iter->second.second);
+		REQUIRE(std::abs(dx) + std::abs(dy) == 1);
+	}
+}
+
+TEST_CASE("PackedRTree query test", "[PackedRTree]")
+{
+	auto rects = makeRects(1000, 1);
+	PackedRTree<double> tree{ rects };
+	REQUIRE(std::size(tree) == std::size(rects));
+	// 1000 leafs, 63 nodes, 4 nodes, root
+	REQUIRE(tree.levelCount() == 4);
+
+	auto expectedBounds = boundingRect(rects[0]);
+	for (auto& rect : rects)
+		expectedBounds = detail::boundingRect(expectedBounds, boundingRect(rect));
+	REQUIRE(tree.bounds() == expectedBounds);
+
+	SECTION("bounds")
+	{
+		for (auto& queryRect : makeRects(100, 2))
+		{
+			std::set<std::size_t> expected;
+			for (std::size_t i = 0; i < std::size(rects); ++i)
+			{
+				if (detail::intersectsBounds(boundingRect(queryRect), boundingRect(rects[i])))
+					expected.emplace(i);
+			}
+			REQUIRE(collectQuery(tree, queryRect) == expected);
+		}
+	}
+
+	SECTION("overlapping")
+	{
+		for (auto& queryRect : makeRects(100, 3))
+		{
+			std::set<std::size_t> found;
+			tree.queryOverlapping(rects, queryRect, [&](std::size_t index) { REQUIRE(found.emplace(index).second); });
+
+			std::set<std::size_t> expected;
+			for (std::size_t i = 0; i < std::size(rects); ++i)
+			{
+				if (overlaps(rects[i], queryRect))
+					expected.emplace(i);
+			}
+			REQUIRE(found == expected);
+		}
+	}
+
+	SECTION("raycast")
+	{
+		std::mt19937 engine{ 4 };
+		std::uniform_real_distribution<double> positionDist{ -120., 120. };
+		for (int i = 0; i < 50; ++i)
+		{
+			Vector2_t origin{ positionDist(engine), positionDist(engine) };
+			Vector2_t target{ positionDist(engine), positionDist(engine) };
+			Ray<Vector2_t> ray{ origin, target - origin };
+			Segment<Vector2_t> segment{ origin, target - origin };
+
+			std::map<std::size_t, double> rayHits;
+			tree.raycast(rects, ray, [&](std::size_t index, double dist) { REQUIRE(rayHits.try_emplace(index, dist).second); });
+			std::map<std::size_t, double> segmentHits;
+			tree.raycast(rects, segment, [&](std::size_t index, double dist) { REQUIRE(segmentHits.try_emplace(index, dist).second); });
+
+			std::map<std::size_t, double> expectedRayHits;
+			std::map<std::size_t, double> expectedSegmentHits;
+			for (std::size_t j = 0; j < std::size(rects); ++j)
+			{
+				if (auto dist = intersection(ray, rects[j]))
+					expectedRayHits.emplace(j, *dist);
+				if (auto dist = intersection(segment, rects[j]))
+					expectedSegmentHits.emplace(j, *dist);
+			}
+			REQUIRE(rayHits == expectedRayHits);
+			REQUIRE(segmentHits == expectedSegmentHits);
+		}
+	}
+
+	SECTION("early stop")
+	{
+		int calls = 0;
+		tree.query(AABB_t<double>{ { -200., -200. }, { 400., 400. } }, [&](auto) { return ++calls < 5; });
+		REQUIRE(calls == 5);
+	}
+}
+
+TEST_CASE("PackedRTree degenerated cases test", "[PackedRTree]")
+{
+	SECTION("empty")
+	{
+		PackedRTree<int> tree{ std::vector<AABB_t<int>>{} };
+		REQUIRE(tree.empty());
+		REQUIRE(tree.levelCount() == 0);
+		REQUIRE(std::empty(collectQuery(tree, AABB_t<int>{ { 0, 0 }, { 10, 10 } })));
+	}
+
+	SECTION("single object")
+	{
+		std::vector rects{ AABB_t<int>{ { 0, 0 }, { 4, 4 } } };
+		PackedRTree<int> tree{ rects };
+		REQUIRE(tree.levelCount() == 1);
+		REQUIRE(tree.bounds() == rects[0]);
+		REQUIRE(collectQuery(tree, AABB_t<int>{ { 4, 4 }, { 1, 1 } }) == std::set<std::size_t>{ 0 });
+		REQUIRE(std::empty(collectQuery(tree, AABB_t<int>{ { 5, 0 }, { 1, 1 } })));
+	}
+
+	SECTION("identical centres")
+	{
+		std::vector<AABB_t<int>> rects;
+		for (int i = 1; i <= 40; ++i)
+			rects.push_back({ { -i, -i }, { 2 * i, 2 * i } });
+		PackedRTree<int, 4> tree{ rects };
+		REQUIRE(tree.levelCount() == 4);
+		std::set<std::size_t> atCentre;
+		tree.queryPoint(Vector<int, 2>{ 0, 0 }, [&](std::size_t index) { REQUIRE(atCentre.emplace(index).second); });
+		REQUIRE(std::size(atCentre) == 40);
+		REQUIRE(collectQuery(tree, AABB_t<int>{ { 39, 0 }, { 1, 0 } }) == std::set<std::size_t>{ 38, 39 });
+	}
+}
@@ -0,0 +1,196 @@
+//          Copyright Dominic Koepke 2017 - 2020.
+// Distributed under the Boost Software License, Version 1.0.
+//    (See accompanying file LICENSE_1_0.txt or copy at
+//          https://www.boost.org/LICENSE_1_0.txt)
+
+#include "catch.hpp"
+
+#include <iterator>
+#include <random>
+#include <vector>
+
+#include "georithm/Bounding.hpp"
+#include "georithm/Contains.hpp"
+#include "georithm/Intersects.hpp"
+#include "georithm/Overlaps.hpp"
+#include "georithm/Polygon.hpp"
+#include "georithm/Rect.hpp"
+#include "georithm/Vector.hpp"
+
+#include "georithm/transform/Rotate.hpp"
+
+TEST_CASE("Polygon basic test", "[Polygon]")
+{
+	using namespace georithm;
+
+	using Vector2 = Vector<int, 2>;
+	Polygon<Vector2> polygon{ { 0, 0 }, { 4, 0 }, { 4, 3 } };
+	static_assert(NDimensionalPolygonalObject<Polygon<Vector2>, 2>);
+
+	REQUIRE(!isNull(polygon));
+	REQUIRE(vertexCount(polygon) == 3);
+	REQUIRE(edgeCount(polygon) == 3);
+	REQUIRE(vertex(polygon, 1) == Vector2{ 4, 0 });
+	REQUIRE(edge(polygon, 2) == Segment<Vector2>{ { 4, 3 }, { -4, -3 } });
+	REQUIRE(boundingRect(polygon) == AABB_t<int>{ { 0, 0 }, { 4, 3 } });
+
+	polygon.vertices().pop_back();
+	REQUIRE(isNull(polygon));
+}
+
+TEST_CASE("Polygon contains test - int", "[Polygon]")
+{
+	using namespace georithm;
+
+	using Vector2 = Vector<int, 2>;
+	// concave "U" shape
+	Polygon<Vector2> polygon{ { 0, 0 }, { 2, 0 }, { 2, 4 }, { 4, 4 }, { 4, 0 }, { 6, 0 }, { 6, 6 }, { 0, 6 } };
+
+	REQUIRE(contains(polygon, Vector2{ 1, 1 }));
+	REQUIRE(contains(polygon, Vector2{ 5, 1 }));
+	REQUIRE(contains(polygon, Vector2{ 3, 5 }));
+	REQUIRE_FALSE(contains(polygon, Vector2{ 3, 1 }));
+	REQUIRE_FALSE(contains(polygon, Vector2{ 3, 3 }));
+	REQUIRE_FALSE(contains(polygon, Vector2{ -1, 3 }));
+	REQUIRE_FALSE(contains(polygon, Vector2{ 7, 3 }));
+	REQUIRE_FALSE(contains(polygon, Vector2{ 3, 7 }));
+
+	// boundary
+	REQUIRE(contains(polygon, Vector2{ 0, 0 }));
+	REQUIRE(contains(polygon, Vector2{ 3, 4 }));
+	REQUIRE(contains(polygon, Vector2{ 2, 2 }));
+	REQUIRE(contains(polygon, Vector2{ 6, 6 }));
+	REQUIRE(contains(polygon, Vector2{ 0, 3 }));
+	REQUIRE_FALSE(contains(polygon, Vector2{ 3, 0 }));
+
+	// opposite orientation
+	std::vector<Vector2> reversed{ std::rbegin(polygon.vertices()), std::rend(polygon.vertices()) };
+	Polygon<Vector2> reversedPolygon{ reversed };
+	REQUIRE(contains(reversedPolygon, Vector2{ 1, 1 }));
+	REQUIRE_FALSE(contains(reversedPolygon, Vector2{ 3, 1 }));
+	REQUIRE(contains(reversedPolygon, Vector2{ 3, 4 }));
+}
+
+TEST_CASE("Polygon batch contains test", "[Polygon]")
+{
+	using namespace georithm;
+
+	using Vector2 = Vector<double, 2>;
+	std::mt19937 engine{ 7 };
+	std::uniform_real_distribution<double> dist{ -12., 12. };
+	std::vector<Vector2> points(500);
+	for (auto& point : points)
+		point = { dist(engine), dist(engine) };
+
+	auto requireSameAsSingle = [&points](const auto& polygon)
+	{
+		std::vector<bool> results;
+		contains(polygon, points, std::back_inserter(results));
+		REQUIRE(std::size(results) == std::size(points));
+		for (std::size_t i = 0; i < std::size(points); ++i)
+			REQUIRE(results[i] == contains(polygon, points[i]));
+	};
+
+	SECTION("star")
+	{
+		Polygon<Vector2> star{ { 0., -10. }, { 2., -3. }, { 10., -3. }, { 4., 2. }, { 6., 10. }, { 0., 5. }, { -6., 10. }, { -4., 2. }, { -10., -3. }, { -2., -3. } };
+		requireSameAsSingle(star);
+
+		std::vector<bool> results;
+		contains(star, std::vector<Vector2>{ { 0., 0. }, { 0., -10. }, { 8., 8. } }, std::back_inserter(results));
+		REQUIRE(results == std::vector<bool>{ true, true, false });
+	}
+
+	SECTION("transformed rect")
+	{
+		Rect<double, transform::Rotate<Vector2>> rect{ { -3., -2. }, { 8., 5. } };
+		rect.rotation() = 0.7;
+		requireSameAsSingle(rect);
+
+		// the winding number test agrees with the rect specific test
+		Polygon<Vector2> polygon{ vertex(rect, 0), vertex(rect, 1), vertex(rect, 2), vertex(rect, 3) };
+		for (auto& point : points)
+			REQUIRE(contains(polygon, point) == contains(rect, point));
+	}
+
+	SECTION("aabb")
+	{
+		AABB_t<double> rect{ { -3., -2. }, { 8., 5. } };
+		requireSameAsSingle(rect);
+	}
+}
+
+TEST_CASE("Polygon overlaps test", "[Polygon]")
+{
+	using namespace georithm;
+
+	using Vector2 = Vector<int, 2>;
+	// concave "U" shape
+	Polygon<Vector2> polygon{ { 0, 0 }, { 4, 0 }, { 4, 8 }, { 8, 8 }, { 8, 0 }, { 12, 0 }, { 12, 12 }, { 0, 12 } };
+
+	// inside the gap of the U; the bounds overlap, but the polygons don't
+	REQUIRE_FALSE(overlaps(polygon, Polygon<Vector2>{ { 5, 1 }, { 7, 1 }, { 6, 6 } }));
+	REQUIRE_FALSE(overlaps(polygon, AABB_t<int>{ { 5, 2 }, { 2, 2 } }));
+	REQUIRE_FALSE(overlaps(polygon, AABB_t<int>{ { 14, 0 }, { 2, 2 } }));
+	REQUIRE(overlaps(polygon, Polygon<Vector2>{ { 2, 2 }, { 10, 2 }, { 6, 10 } }));
+	REQUIRE(overlaps(polygon, AABB_t<int>{ { -1, -1 }, { 20, 20 } }));
+	REQUIRE(overlaps(AABB_t<int>{ { -1, -1 }, { 20, 20 } }, polygon));
+	REQUIRE(overlaps(polygon, AABB_t<int>{ { 2, 9 }, { 1, 1 } }));
+	// touching
+	REQUIRE(overlaps(polygon, AABB_t<int>{ { 12, 2 }, { 2, 2 } }));
+	REQUIRE(overlaps(polygon, Polygon<Vector2>{ { 5, 1 }, { 7, 1 }, { 6, 8 } }));
+
+	REQUIRE(overlaps(AABB_t<int>{ { 0, 0 }, { 4, 4 } }, AABB_t<int>{ { 1, 1 }, { 1, 1 } }));
+	REQUIRE(overlaps(AABB_t<int>{ { 0, 0 }, { 4, 4 } }, AABB_t<int>{ { 4, 4 }, { 1, 1 } }));
+	REQUIRE_FALSE(overlaps(AABB_t<int>{ { 0, 0 }, { 4, 4 } }, AABB_t<int>{ { 5, 4 }, { 1, 1 } }));
+}
+
+TEST_CASE("Polygon overlaps against reference test", "[Polygon]")
+{
+	using namespace georithm;
+
+	using Vector2 = Vector<double, 2>;
+	using Rect_t = Rect<double, transform::Rotate<Vector2>>;
+	std::mt19937 engine{ 11 };
+	std::uniform_real_distribution<double> positionDist{ -15., 15. };
+	std::uniform_real_distribution<double> spanDist{ 0.5, 12. };
+	std::uniform_real_distribution<double> rotationDist{ 0., 6. };
+
+	auto makeRect = [&]()
+	{
+		Rect_t rect{ { positionDist(engine), positionDist(engine) }, { spanDist(engine), spanDist(engine) } };
+		rect.rotation() = rotationDist(engine);
+		return rect;
+	};
+
+	SECTION("transformed rects")
+	{
+		for (int i = 0; i < 500; ++i)
+		{
+			auto lhs = makeRect();
+			auto rhs = makeRect();
+			bool expected = intersects(lhs, rhs) || contains(lhs, rhs) || contains(rhs, lhs);
+			REQUIRE(overlaps(lhs, rhs) == expected);
+			REQUIRE(overlaps(lhs, boundingRect(lhs), rhs, boundingRect(rhs)) == expected);
+		}
+	}
+
+	SECTION("concave polygons")
+	{
+		std::uniform_real_distribution<double> scaleDist{ 0.1, 1.5 };
+		for (int i = 0; i < 500; ++i)
+		{
+			auto scale = scaleDist(engine);
+			Vector2 offset{ positionDist(engine), positionDist(engine) };
+			Polygon<Vector2> star{ { 0., -10. }, { 2., -3. }, { 10., -3. }, { 4., 2. }, { 6., 10. }, { 0., 5. }, { -6., 10. }, { -4., 2. }, { -10., -3. }, { -2., -3. } };
+			for (auto& vertex : star.vertices())
+				vertex = vertex * scale + offset;
+			auto rect = makeRect();
+
+			bool expected = detail::intersectsByEdges(star, rect) || contains(star, vertex(rect, 0)) || contains(rect, vertex(star, 0));
+			REQUIRE(overlaps(star, rect) == expected);
+			REQUIRE(overlaps(rect, star) == expected);
+			REQUIRE(overlaps(star, boundingRect(star), rect, boundingRect(rect)) == expected);
+		}
+	}
+}
@@ -0,0 +1,55 @@
+//          Copyright Dominic Koepke 2017 - 2020.
+// Distributed under the Boost Software License, Version 1.0.
+//    (See accompanying file LICENSE_1_0.txt or copy at
+//          https://www.boost.org/LICENSE_1_0.txt)
+
+#ifndef GEORITHM_TEST_RANDOM_GEOMETRY_HPP
+#define GEORITHM_TEST_RANDOM_GEOMETRY_HPP
+
+#pragma once
+
+#include <cstddef>
+#include <random>
+#include <vector>
+
+#include "georithm/Rect.hpp"
+#include "georithm/Vector.hpp"
+
+#include "georithm/transform/Rotate.hpp"
+
+namespace georithm::test
+{
+	using RotatedRect_t = Rect<double, transform::Rotate<Vector<double, 2>>>;
+
+	// randomly placed points around the origin; equal seeds result in equal points
+	inline std::vector<Vector<double, 2>> makePoints(std::size_t count, unsigned seed)
+	{
+		std::mt19937 engine{ seed };
+		std::uniform_real_distribution<double> positionDist{ -100., 100. };
+
+		std::vector<Vector<double, 2>> points;
+		for (std::size_t i = 0; i < count; ++i)
+			points.push_back({ positionDist(engine), positionDist(engine) });
+		return points;
+	}
+
+	// randomly placed, sized and rotated rects around the origin; equal seeds result in equal rects
+	inline std::vector<RotatedRect_t> makeRects(std::size_t count, unsigned seed)
+	{
+		std::mt19937 engine{ seed };
+		std::uniform_real_distribution<double> positionDist{ -100., 100. };
+		std::uniform_real_distribution<double> spanDist{ 0.5, 10. };
+		std::uniform_real_distribution<double> rotationDist{ 0., 6. };
+
+		std::vector<RotatedRect_t> rects;
+		for (std::size_t i = 0; i < count; ++i)
+		{
+			RotatedRect_t rect{ { positionDist(engine), positionDist(engine) }, { spanDist(engine), spanDist(engine) } };
+			rect.rotation() = rotationDist(engine);
+			rects.emplace_back(rect);
+		}
+		return rects;
+	}
+}
+
+#endif
@@ -4,15 +4,28 @@
 //          https://www.boost.org/LICENSE_1_0.txt)
 
 #include "catch.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <iterator>
+#include <numbers>
+#include <random>
+#include <utility>
+#include <vector>
+
 #include "georithm/Bounding.hpp"
+#include "georithm/CachedRect.hpp"
 #include "georithm/Contains.hpp"
 #include "georithm/Intersection.hpp"
 #include "georithm/Intersects.hpp"
 #include "georithm/Line.hpp"
+#include "georithm/Polygon.hpp"
 #include "georithm/Rect.hpp"
 #include "georithm/Utility.hpp"
 #include "georithm/Vector.hpp"
 
+#include "georithm/transform/Affine.hpp"
+#include "georithm/transform/PrecomputedRotate.hpp"
 #include "georithm/transform/Rotate.hpp"
 #include "georithm/transform/Scale.hpp"
 #include "georithm/transform/Shear.hpp"
@@ -153,6 +166,11 @@ TEST_CASE("Rect contains test - int", "[Rect]")
 	REQUIRE_FALSE(contains(rect, rect.span() + Vector2{ 1, 1 }));
 	REQUIRE_FALSE(contains(rect, rect.span() + Vector2{ -1, 1 }));
 	REQUIRE_FALSE(contains(rect, rect.span() + Vector2{ 1, -1 }));
+
+	REQUIRE(contains(rect, AABB_t<int>{ { 1, 1 }, { 6, 4 } }));
+	REQUIRE(contains(rect, rect));
+	REQUIRE_FALSE(contains(rect, AABB_t<int>{ { 1, 1 }, { 7, 4 } }));
+	REQUIRE_FALSE(contains(rect, AABB_t<int>{ { -1, 1 }, { 2, 2 } }));
 }
 
 TEST_CASE("Rect make bounding rect test", "[Rect]")
@@ -173,6 +191,55 @@ TEST_CASE("Rect make bounding rect test", "[Rect]")
 	REQUIRE(bb.position() == abs(transRect.span()));
 }
 
+TEMPLATE_TEST_CASE("Bounding kernel test", "[Rect]", float, double, int)
+{
+	using namespace georithm;
+
+	using Vector2 = Vector<TestType, 2>;
+	std::mt19937 engine{ 11 };
+	std::uniform_int_distribution<int> dist{ -1000, 1000 };
+
+	for (std::size_t count = 1; count < 12; ++count)
+	{
+		std::vector<Vector2> points(count);
+		for (auto& point : points)
+			point = { static_cast<TestType>(dist(engine)), static_cast<TestType>(dist(engine)) };
+
+		auto xMin = points[0].x();
+		auto yMin = points[0].y();
+		auto xMax = xMin;
+		auto yMax = yMin;
+		for (auto& point : points)
+		{
+			xMin = std::min(xMin, point.x());
+			yMin = std::min(yMin, point.y());
+			xMax = std::max(xMax, point.x());
+			yMax = std::max(yMax, point.y());
+		}
+		REQUIRE(boundingRect(points) == AABB_t<TestType>{ { xMin, yMin }, { xMax - xMin, yMax - yMin } });
+	}
+
+	Rect<TestType, transform::Rotate<Vector2>> rect{ { TestType(3), TestType(-2) }, { TestType(40), TestType(20) } };
+	rect.rotation() = 2.;
+	AABB_t<TestType> expected{ topLeftBounding(rect), bottomRightBounding(rect) - topLeftBounding(rect) };
+	REQUIRE(boundingRect(rect) == expected);
+	REQUIRE(leftBounding(rect) == expected.position().x());
+	REQUIRE(topBounding(rect) == expected.position().y());
+	REQUIRE(rightBounding(rect) == expected.position().x() + expected.span().x());
+	REQUIRE(bottomBounding(rect) == expected.position().y() + expected.span().y());
+	REQUIRE(topRightBounding(rect) == Vector2{ rightBounding(rect), topBounding(rect) });
+	REQUIRE(bottomLeftBounding(rect) == Vector2{ leftBounding(rect), bottomBounding(rect) });
+
+	std::vector<Vector2> vertices{ vertex(rect, 0), vertex(rect, 1), vertex(rect, 2), vertex(rect, 3) };
+	REQUIRE(boundingRect(vertices) == expected);
+
+	std::vector<decltype(rect)> rects{ rect, rect };
+	rects[1].position() = { TestType(-50), TestType(7) };
+	std::vector<AABB_t<TestType>> bounds;
+	boundingRects(rects, std::back_inserter(bounds));
+	REQUIRE(bounds == std::vector<AABB_t<TestType>>{ boundingRect(rects[0]), boundingRect(rects[1]) });
+}
+
 TEST_CASE("Rect transform tests", "[Rect]")
 {
 	using namespace georithm;
@@ -351,3 +418,342 @@ TEST_CASE("Rect transform tests", "[Rect]")
 	//REQUIRE(bb.position() == transRect.position() + transRect.span());
 	//REQUIRE(bb.position() == abs(transRect.span()));
 }
+
+TEST_CASE("CachedRect tests", "[Rect]")
+{
+	using namespace georithm;
+
+	using Vector2F_t = Vector<float, 2>;
+	using Rect_t = Rect<float, transform::Rotate<Vector2F_t>, transform::Translate<Vector2F_t>>;
+
+	Rect_t rect{ { 1.f, 2.f }, { 3.f, 4.f } };
+	rect.rotation() = 0.5f;
+	rect.translation() = { -1.f, 1.f };
+	CachedRect<Rect_t> cachedRect{ rect };
+
+	auto requireSameVertices = [](const auto& lhs, const auto& rhs)
+	{
+		for (VertexIndex_t i = 0; i < vertexCount(lhs); ++i)
+		{
+			REQUIRE(vertex(lhs, i).x() == Approx(vertex(rhs, i).x()));
+			REQUIRE(vertex(lhs, i).y() == Approx(vertex(rhs, i).y()));
+			REQUIRE(edge(lhs, i).direction().x() == Approx(edge(rhs, i).direction().x()).margin(0.00001));
+			REQUIRE(edge(lhs, i).direction().y() == Approx(edge(rhs, i).direction().y()).margin(0.00001));
+		}
+	};
+
+	requireSameVertices(cachedRect, rect);
+
+	SECTION("position change invalidates")
+	{
+		cachedRect.position() = { 5.f, 5.f };
+		rect.position() = { 5.f, 5.f };
+	}
+
+	SECTION("span change invalidates")
+	{
+		cachedRect.span() = { 10.f, 1.f };
+		rect.span() = { 10.f, 1.f };
+	}
+
+	SECTION("transformer change invalidates")
+	{
+		cachedRect.transformer<transform::Rotate<Vector2F_t>>().rotation() = 2.f;
+		rect.rotation() = 2.f;
+	}
+
+	SECTION("rect change invalidates")
+	{
+		cachedRect.rect().translation() = { 3.f, 3.f };
+		rect.translation() = { 3.f, 3.f };
+	}
+
+	requireSameVertices(cachedRect, rect);
+	REQUIRE(std::as_const(cachedRect).rect() == rect);
+
+	auto bb = boundingRect(cachedRect);
+	auto expectedBB = boundingRect(rect);
+	REQUIRE(bb.position().x() == Approx(expectedBB.position().x()));
+	REQUIRE(bb.position().y() == Approx(expectedBB.position().y()));
+	REQUIRE(contains(cachedRect, rect.vertex(0) * 0.5f + rect.vertex(2) * 0.5f));
+	REQUIRE(intersects(cachedRect, rect));
+}
+
+TEST_CASE("PrecomputedRotate tests", "[Rect]")
+{
+	using namespace georithm;
+
+	SECTION("float")
+	{
+		using Vector2F_t = Vector<float, 2>;
+		Rect<float, transform::Rotate<Vector2F_t>> rect{ { 1.f, 2.f }, { 3.f, 4.f } };
+		Rect<float, transform::PrecomputedRotate<Vector2F_t>> precomputedRect{ { 1.f, 2.f }, { 3.f, 4.f } };
+
+		for (auto rotation : { 0.f, 0.3f, 2.f, -5.f })
+		{
+			rect.rotation() = rotation;
+			precomputedRect.rotation(rotation);
+			REQUIRE(precomputedRect.rotation() == rotation);
+			REQUIRE(precomputedRect.cos() == Approx(std::cos(rotation)));
+			REQUIRE(precomputedRect.sin() == Approx(std::sin(rotation)));
+
+			for (VertexIndex_t i = 0; i < 4; ++i)
+			{
+				REQUIRE(vertex(precomputedRect, i).x() == Approx(vertex(rect, i).x()));
+				REQUIRE(vertex(precomputedRect, i).y() == Approx(vertex(rect, i).y()));
+			}
+		}
+	}
+
+	SECTION("int")
+	{
+		using Vector2_t = Vector<int, 2>;
+		transform::Rotate<Vector2_t> rotate{ std::numbers::pi / 2 };
+		transform::PrecomputedRotate<Vector2_t> precomputedRotate{ std::numbers::pi / 2 };
+		REQUIRE(precomputedRotate.transform({ 1, 2 }) == rotate.transform({ 1, 2 }));
+		REQUIRE(precomputedRotate.transform({ 1, 2 }) == Vector2_t{ -2, 1 });
+	}
+}
+
+TEST_CASE("AffineChain tests", "[Rect]")
+{
+	using namespace georithm;
+
+	using Vector2F_t = Vector<float, 2>;
+	using Rotate_t = transform::Rotate<Vector2F_t>;
+	using Scale_t = transform::Scale<Vector2F_t>;
+	using Shear_t = transform::Shear<Vector2F_t>;
+	using Translate_t = transform::Translate<Vector2F_t>;
+	using Chain_t = transform::AffineChain<Vector2F_t, Rotate_t, Scale_t, Shear_t, Translate_t>;
+
+	Rect<float, Rotate_t, Scale_t, Shear_t, Translate_t> rect{ { 1.f, 2.f }, { 3.f, 4.f } };
+	Rect<float, Chain_t> chainRect{ { 1.f, 2.f }, { 3.f, 4.f } };
+	REQUIRE(chainRect.matrix() == transform::AffineMatrix<float>::identity());
+
+	auto requireSameVertices = [&]()
+	{
+		for (VertexIndex_t i = 0; i < 4; ++i)
+		{
+			REQUIRE(vertex(chainRect, i).x() == Approx(vertex(rect, i).x()).margin(0.0001));
+			REQUIRE(vertex(chainRect, i).y() == Approx(vertex(rect, i).y()).margin(0.0001));
+		}
+	};
+
+	requireSameVertices();
+
+	rect.rotation() = 0.7f;
+	rect.scale() = { 2.f, 0.5f };
+	rect.shear() = { 0.3f, -0.2f };
+	rect.translation() = { -3.f, 4.f };
+	chainRect.component<Rotate_t>().rotation() = 0.7f;
+	chainRect.component<1>().scale() = { 2.f, 0.5f };
+	chainRect.component<Shear_t>().shear() = { 0.3f, -0.2f };
+	chainRect.component<Translate_t>().translation() = { -3.f, 4.f };
+	requireSameVertices();
+
+	rect.rotation() = -2.f;
+	chainRect.component<Rotate_t>().rotation() = -2.f;
+	requireSameVertices();
+
+	SECTION("int")
+	{
+		using Vector2_t = Vector<int, 2>;
+		transform::AffineChain<Vector2_t, transform::Scale<Vector2_t>, transform::Rotate<Vector2_t>, transform::Translate<Vector2_t>> chain{
+			transform::Scale<Vector2_t>{ { 2, 3 } },
+			transform::Rotate<Vector2_t>{ std::numbers::pi / 2 },
+			transform::Translate<Vector2_t>{ { 1, 1 } }
+		};
+		REQUIRE(chain.transform({ 1, 1 }) == Vector2_t{ -2, 3 });
+	}
+}
+
+namespace
+{
+	// pulls the upper right vertex of a rect towards the origin, which makes it a concave dart
+	struct Dent
+	{
+		using VectorType = georithm::Vector<double, 2>;
+		using ValueType = double;
+
+		[[nodiscard]] constexpr VectorType transform(const VectorType& vec) const noexcept
+		{
+			if (0. < vec.x() && 0. < vec.y())
+				return vec / 4.;
+			return vec;
+		}
+	};
+}
+
+TEST_CASE("Rect separating axis intersects test", "[Rect]")
+{
+	using namespace georithm;
+
+	using Vector2_t = Vector<double, 2>;
+	using Rect_t = Rect<double, transform::Rotate<Vector2_t>, transform::Translate<Vector2_t>>;
+
+	SECTION("contained rects have no intersecting edges")
+	{
+		Rect_t outer{ { 0., 0. }, { 10., 10. } };
+		Rect_t inner{ { 2., 2. }, { 1., 1. } };
+		inner.rotation() = 0.5;
+		REQUIRE_FALSE(intersects(outer, inner));
+		REQUIRE_FALSE(intersects(inner, outer));
+		REQUIRE_FALSE(detail::intersectsByEdges(outer, inner));
+
+		inner.position() = { 9.5, 5. };
+		REQUIRE(intersects(outer, inner));
+		REQUIRE(intersects(inner, outer));
+	}
+
+	SECTION("touching rects intersect")
+	{
+		AABB_t<double> lhs{ { 0., 0. }, { 1., 1. } };
+		AABB_t<double> rhs{ { 1., 0. }, { 1., 1. } };
+		REQUIRE(intersects(lhs, rhs));
+
+		rhs.position().x() += 0.0001;
+		REQUIRE_FALSE(intersects(lhs, rhs));
+	}
+
+	SECTION("same result as edge based test")
+	{
+		std::mt19937 engine{ 42 };
+		std::uniform_real_distribution<double> positionDist{ -10., 10. };
+		std::uniform_real_distribution<double> spanDist{ 0.5, 8. };
+		std::uniform_real_distribution<double> rotationDist{ 0., 2 * std::numbers::pi };
+
+		auto makeRect = [&]()
+		{
+			Rect_t rect{ { positionDist(engine), positionDist(engine) }, { spanDist(engine), spanDist(engine) } };
+			rect.rotation() = rotationDist(engine);
+			rect.translation() = { positionDist(engine), positionDist(engine) };
+			return rect;
+		};
+
+		for (int i = 0; i < 1000; ++i)
+		{
+			auto lhs = makeRect();
+			auto rhs = makeRect();
+			REQUIRE(intersects(lhs, rhs) == detail::intersectsByEdges(lhs, rhs));
+		}
+	}
+
+	SECTION("integral rects use all of their edges as separating axes")
+	{
+		using IntRect_t = Rect<int, transform::Rotate<Vector<int, 2>>>;
+
+		// each vertex is rounded on its own, thus opposing edges aren't parallel anymore
+		IntRect_t lhs{ { -3, -2 }, { 1, 3 } };
+		lhs.rotation() = std::numbers::pi / 2;
+		IntRect_t rhs{ { 3, 0 }, { 4, 5 } };
+		rhs.rotation() = 130. * std::numbers::pi / 180.;
+		REQUIRE(rhs.vertex(2) == Vector<int, 2>{ -3, 0 });
+		REQUIRE(rhs.vertex(3) == Vector<int, 2>{ -1, -3 });
+		REQUIRE_FALSE(intersects(lhs, rhs));
+		REQUIRE_FALSE(intersects(rhs, lhs));
+
+		std::mt19937 engine{ 42 };
+		std::uniform_int_distribution<int> positionDist{ -6, 6 };
+		std::uniform_int_distribution<int> spanDist{ 2, 6 };
+		std::uniform_real_distribution<double> rotationDist{ 0., 2 * std::numbers::pi };
+
+		auto makeRect = [&]()
+		{
+			IntRect_t rect{ { positionDist(engine), positionDist(engine) }, { spanDist(engine), spanDist(engine) } };
+			rect.rotation() = rotationDist(engine);
+			return rect;
+		};
+
+		// the edge based test of the rounded vertices serves as reference
+		auto toPolygon = [](const IntRect_t& rect)
+		{
+			Polygon<Vector2_t> polygon;
+			for (VertexIndex_t i = 0; i < 4; ++i)
+				polygon.vertices().emplace_back(rect.vertex(i));
+			return polygon;
+		};
+
+		for (int i = 0; i < 2000; ++i)
+		{
+			auto lhs = makeRect();
+			auto rhs = makeRect();
+			REQUIRE(intersects(lhs, rhs) == detail::intersectsByEdges(toPolygon(lhs), toPolygon(rhs)));
+		}
+	}
+
+	SECTION("non affine transformers don't use separating axes")
+	{
+		static_assert(IsConvex_v<AABB_t<double>>);
+		static_assert(IsConvex_v<Rect_t>);
+		static_assert(IsConvex_v<Rect<double, transform::AffineChain<Vector2_t, transform::Scale<Vector2_t>, transform::Shear<Vector2_t>>>>);
+		static_assert(!IsConvex_v<Rect<double, Dent>>);
+		static_assert(!IsConvex_v<Rect<double, transform::Rotate<Vector2_t>, Dent>>);
+
+		// lies within the dent, thus the separating axes of the dart's edges don't separate both
+		Rect<double, Dent> dart{ { 0., 0. }, { 4., 4. } };
+		AABB_t<double> rect{ { 1.5, 1.5 }, { 1., 1. } };
+		REQUIRE_FALSE(intersects(dart, rect));
+		REQUIRE_FALSE(intersects(rect, dart));
+
+		rect.position() = { 0.5, 1.5 };
+		REQUIRE(intersects(dart, rect));
+	}
+}
+
+TEST_CASE("Rect bounding rejection intersects test", "[Rect]")
+{
+	using namespace georithm;
+
+	using Vector2_t = Vector<double, 2>;
+	using Rect_t = Rect<double, transform::Rotate<Vector2_t>>;
+
+	Rect_t rect{ { 0., 0. }, { 2., 2. } };
+	rect.rotation() = 0.3;
+	auto bounds = boundingRect(rect);
+
+	SECTION("segment")
+	{
+		Segment<Vector2_t> segment{ { -5., 1. }, { 4., 0. } };
+		REQUIRE_FALSE(intersects(segment, rect));
+		REQUIRE_FALSE(intersects(segment, rect, bounds));
+
+		segment.direction().x() = 10.;
+		REQUIRE(intersects(segment, rect));
+		REQUIRE(intersects(segment, rect, bounds));
+	}
+
+	SECTION("ray")
+	{
+		Ray<Vector2_t> ray{ { -5., 1. }, { -1., 0. } };
+		REQUIRE_FALSE(intersects(ray, rect));
+		REQUIRE_FALSE(intersects(ray, rect, bounds));
+
+		ray.direction() = { 1., 0. };
+		REQUIRE(intersects(ray, rect));
+		REQUIRE(intersects(ray, rect, bounds));
+	}
+
+	SECTION("line")
+	{
+		Line<Vector2_t> line{ { -5., 10. }, { 1., 0. } };
+		REQUIRE_FALSE(intersects(line, rect));
+		REQUIRE_FALSE(intersects(line, rect, bounds));
+
+		line.location().y() = 1.;
+		REQUIRE(intersects(line, rect));
+		REQUIRE(intersects(line, rect, bounds));
+	}
+
+	SECTION("polygon")
+	{
+		Rect_t other{ { 1., 1. }, { 3., 3. } };
+		auto otherBounds = boundingRect(other);
+		REQUIRE(intersects(rect, bounds, other, otherBounds) == intersects(rect, other));
+		REQUIRE(intersects(rect, bounds, other, otherBounds));
+
+		other.position() = { 10., 10. };
+		otherBounds = boundingRect(other);
+		REQUIRE_FALSE(intersects(rect, bounds, other, otherBounds));
+		REQUIRE_FALSE(detail::intersectsBounds(bounds, otherBounds));
+	}
+}
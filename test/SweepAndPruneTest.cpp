@@ -0,0 +1,210 @@
+//          Copyright Dominic Koepke 2017 - 2020.
+// Distributed under the Boost Software License, Version 1.0.
+//    (See accompanying file LICENSE_1_0.txt or copy at
+//          https://www.boost.org/LICENSE_1_0.txt)
+
+#include "catch.hpp"
+
+#include <map>
+#include <random>
+#include <set>
+#include <utility>
+#include <vector>
+
+#include "georithm/Bounding.hpp"
+#include "georithm/Rect.hpp"
+#include "georithm/SweepAndPrune.hpp"
+#include "georithm/Vector.hpp"
+
+namespace
+{
+	using namespace georithm;
+
+	using Pair_t = std::pair<std::size_t, std::size_t>;
+
+	template <class T>
+	std::set<Pair_t> collectPairs(const SweepAndPrune<T>& broadPhase)
+	{
+		std::set<Pair_t> pairs;
+		broadPhase.forEachOverlappingPair([&](std::size_t lhs, std::size_t rhs)
+			{
+				REQUIRE(lhs < rhs);
+				REQUIRE(pairs.emplace(lhs, rhs).second);
+			}
+		);
+		REQUIRE(std::size(pairs) == broadPhase.pairCount());
+		return pairs;
+	}
+
+	template <class T>
+	std::set<Pair_t> bruteForcePairs(const std::map<std::size_t, AABB_t<T>>& objects)
+	{
+		std::set<Pair_t> pairs;
+		for (auto lhs = std::begin(objects); lhs != std::end(objects); ++lhs)
+		{
+			for (auto rhs = std::next(lhs); rhs != std::end(objects); ++rhs)
+			{
+				if (detail::intersectsBounds(lhs->second, rhs->second))
+					pairs.emplace(lhs->first, rhs->first);
+			}
+		}
+		return pairs;
+	}
+
+	// applies the reported changes to pairs, which must never report a pair twice or end a pair, which doesn't exist
+	template <class T>
+	void update(SweepAndPrune<T>& broadPhase, std::set<Pair_t>& pairs)
+	{
+		std::set<Pair_t> changedPairs;
+		broadPhase.update(
+			[&](std::size_t lhs, std::size_t rhs)
+			{
+				REQUIRE(lhs < rhs);
+				REQUIRE(changedPairs.emplace(lhs, rhs).second);
+				REQUIRE(pairs.emplace(lhs, rhs).second);
+			},
+			[&](std::size_t lhs, std::size_t rhs)
+			{
+				REQUIRE(lhs < rhs);
+				REQUIRE(changedPairs.emplace(lhs, rhs).second);
+				REQUIRE(pairs.erase({ lhs, rhs }) == 1);
+			}
+		);
+	}
+}
+
+TEMPLATE_TEST_CASE("SweepAndPrune moving objects test", "[SweepAndPrune]", float, int)
+{
+	using T = TestType;
+
+	std::mt19937 engine{ 1 };
+	std::uniform_int_distribution<int> positionDist{ 0, 500 };
+	std::uniform_int_distribution<int> spanDist{ 0, 30 };
+	std::uniform_int_distribution<int> stepDist{ -3, 3 };
+	auto makeRect = [&]()
+	{
+		return AABB_t<T>{ { static_cast<T>(positionDist(engine)), static_cast<T>(positionDist(engine)) },
+			{ static_cast<T>(spanDist(engine)), static_cast<T>(spanDist(engine)) } };
+	};
+
+	SweepAndPrune<T> broadPhase;
+	std::map<std::size_t, AABB_t<T>> objects;
+	std::set<Pair_t> pairs;
+	auto initialCount = GENERATE(0, 1, 5, 300);
+	for (int i = 0; i < initialCount; ++i)
+	{
+		auto rect = makeRect();
+		objects.emplace(broadPhase.insert(rect, 0), rect);
+	}
+	update(broadPhase, pairs);
+	REQUIRE(std::size(broadPhase) == std::size(objects));
+	REQUIRE(pairs == bruteForcePairs(objects));
+	REQUIRE(collectPairs(broadPhase) == pairs);
+
+	for (int frame = 0; frame < 30; ++frame)
+	{
+		for (auto& [proxyId, rect] : objects)
+		{
+			rect.position() += Vector<T, 2>{ static_cast<T>(stepDist(engine)), static_cast<T>(stepDist(engine)) };
+			broadPhase.move(proxyId, rect);
+		}
+
+		// a few insertions and removals, which may reuse ids
+		for (int i = 0; i < 3 && !std::empty(objects); ++i)
+		{
+			auto proxyId = std::next(std::begin(objects), engine() % std::size(objects))->first;
+			broadPhase.remove(proxyId);
+			objects.erase(proxyId);
+		}
+		if (frame % 10 == 9)
+		{
+			for (int i = 0; i < 50; ++i)
+			{
+				auto rect = makeRect();
+				REQUIRE(objects.emplace(broadPhase.insert(rect, 0), rect).second);
+			}
+		}
+		for (int i = 0; i < 3; ++i)
+		{
+			auto rect = makeRect();
+			REQUIRE(objects.emplace(broadPhase.insert(rect, 0), rect).second);
+		}
+
+		update(broadPhase, pairs);
+		REQUIRE(std::size(broadPhase) == std::size(objects));
+		REQUIRE(pairs == bruteForcePairs(objects));
+		REQUIRE(collectPairs(broadPhase) == pairs);
+		for (auto& [proxyId, rect] : objects)
+			REQUIRE(broadPhase.bounds(proxyId) == rect);
+	}
+}
+
+TEST_CASE("SweepAndPrune touching and degenerated objects test", "[SweepAndPrune]")
+{
+	SweepAndPrune<int> broadPhase;
+	auto lhs = broadPhase.insert(AABB_t<int>{ { 0, 0 }, { 10, 10 } }, 1);
+	auto rhs = broadPhase.insert(AABB_t<int>{ { 10, 10 }, { 0, 0 } }, 2);
+	std::set<Pair_t> pairs;
+	update(broadPhase, pairs);
+	REQUIRE(pairs == std::set<Pair_t>{ { lhs, rhs } });
+	REQUIRE(broadPhase.userData(rhs) == 2);
+
+	// moving apart by one ends the pair, moving back begins it again
+	broadPhase.move(rhs, AABB_t<int>{ { 11, 10 }, { 0, 0 } });
+	update(broadPhase, pairs);
+	REQUIRE(std::empty(pairs));
+
+	broadPhase.move(rhs, AABB_t<int>{ { -5, -5 }, { 5, 5 } });
+	update(broadPhase, pairs);
+	REQUIRE(std::size(pairs) == 1);
+
+	// removing reports the end of its pairs
+	broadPhase.remove(lhs);
+	update(broadPhase, pairs);
+	REQUIRE(std::empty(pairs));
+	REQUIRE(std::size(broadPhase) == 1);
+
+	broadPhase.clear();
+	REQUIRE(broadPhase.empty());
+	REQUIRE(broadPhase.pairCount() == 0);
+}
+
+TEST_CASE("SweepAndPrune removing overlapping objects test", "[SweepAndPrune]")
+{
+	// enough proxies to keep update from rebuilding everything
+	SweepAndPrune<int> broadPhase;
+	for (int i = 0; i < 64; ++i)
+		broadPhase.insert(AABB_t<int>{ { 100 * i, 100 }, { 10, 10 } }, 0);
+	auto lhs = broadPhase.insert(AABB_t<int>{ { 0, 0 }, { 10, 10 } }, 1);
+	auto rhs = broadPhase.insert(AABB_t<int>{ { 5, 5 }, { 10, 10 } }, 2);
+	std::set<Pair_t> pairs;
+	update(broadPhase, pairs);
+	REQUIRE(pairs == std::set<Pair_t>{ { std::min(lhs, rhs), std::max(lhs, rhs) } });
+
+	// both endpoints of removed proxies are equal, which mustn't keep their pair alive
+	broadPhase.remove(lhs);
+	broadPhase.remove(rhs);
+	update(broadPhase, pairs);
+	REQUIRE(std::empty(pairs));
+	REQUIRE(broadPhase.pairCount() == 0);
+
+	// the ids get reused by proxies far apart
+	broadPhase.insert(AABB_t<int>{ { -100, -100 }, { 10, 10 } }, 3);
+	broadPhase.insert(AABB_t<int>{ { 1000, -100 }, { 10, 10 } }, 4);
+	update(broadPhase, pairs);
+	REQUIRE(std::empty(pairs));
+	REQUIRE(std::empty(collectPairs(broadPhase)));
+}
+
+TEST_CASE("SweepAndPrune early stop test", "[SweepAndPrune]")
+{
+	SweepAndPrune<float> broadPhase;
+	for (int i = 0; i < 10; ++i)
+		broadPhase.insert(AABB_t<float>{ { 0.f, 0.f }, { 1.f, 1.f } }, i);
+	broadPhase.update();
+	REQUIRE(broadPhase.pairCount() == 45);
+
+	int calls = 0;
+	broadPhase.forEachOverlappingPair([&](auto, auto) { return ++calls < 3; });
+	REQUIRE(calls == 3);
+}
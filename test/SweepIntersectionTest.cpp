@@ -0,0 +1,193 @@
+//          Copyright Dominic Koepke 2017 - 2020.
+// Distributed under the Boost Software License, Version 1.0.
+//    (See accompanying file LICENSE_1_0.txt or copy at
+//          https://www.boost.org/LICENSE_1_0.txt)
+
+#include "catch.hpp"
+
+#include <algorithm>
+#include <map>
+#include <random>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+#include "georithm/Intersection.hpp"
+#include "georithm/Line.hpp"
+#include "georithm/SweepIntersection.hpp"
+#include "georithm/Vector.hpp"
+
+namespace
+{
+	using namespace georithm;
+
+	using Vector2_t = Vector<double, 2>;
+	using Segment_t = Segment<Vector2_t>;
+	using Pair_t = std::pair<std::size_t, std::size_t>;
+	using Intersection_t = std::tuple<LineIntersectionResult, double, double>;
+	using Pairs_t = std::map<Pair_t, Intersection_t>;
+
+	Segment_t makeSegment(double x1, double y1, double x2, double y2)
+	{
+		return { { x1, y1 }, { x2 - x1, y2 - y1 } };
+	}
+
+	Pairs_t sweepPairs(const std::vector<Segment_t>& segments)
+	{
+		Pairs_t pairs;
+		forEachIntersectingPair(segments, [&](std::size_t lhs, std::size_t rhs, LineIntersectionResult result, double lhsDist, double rhsDist)
+			{
+				REQUIRE(lhs < rhs);
+				REQUIRE(pairs.try_emplace({ lhs, rhs }, result, lhsDist, rhsDist).second);
+			}
+		);
+		return pairs;
+	}
+
+	// collinear segments only intersect, if their projections onto the common line overlap
+	bool overlapsCollinear(const Segment_t& lhs, const Segment_t& rhs)
+	{
+		auto axis = lhs.direction().x() != 0 ? 0 : 1;
+		auto lhsMinMax = std::minmax({ lhs.location()[axis], lhs.location()[axis] + lhs.direction()[axis] });
+		auto rhsMinMax = std::minmax({ rhs.location()[axis], rhs.location()[axis] + rhs.direction()[axis] });
+		return std::max(lhsMinMax.first, rhsMinMax.first) <= std::min(lhsMinMax.second, rhsMinMax.second);
+	}
+
+	Pairs_t bruteForcePairs(const std::vector<Segment_t>& segments)
+	{
+		Pairs_t pairs;
+		for (std::size_t i = 0; i < std::size(segments); ++i)
+		{
+			for (std::size_t j = i + 1; j < std::size(segments); ++j)
+			{
+				auto result = intersection(segments[i], segments[j]);
+				if (std::get<0>(result) == LineIntersectionResult::intersecting ||
+					(std::get<0>(result) == LineIntersectionResult::collinear && overlapsCollinear(segments[i], segments[j])))
+					pairs.emplace(Pair_t{ i, j }, result);
+			}
+		}
+		return pairs;
+	}
+}
+
+TEST_CASE("Sweep intersection degenerated cases test", "[SweepIntersection]")
+{
+	SECTION("crossing")
+	{
+		std::vector<Segment_t> segments{ makeSegment(0, 0, 2, 2), makeSegment(0, 2, 2, 0) };
+		auto pairs = sweepPairs(segments);
+		REQUIRE(std::size(pairs) == 1);
+		REQUIRE(pairs[{ 0, 1 }] == Intersection_t{ LineIntersectionResult::intersecting, 0.5, 0.5 });
+	}
+
+	SECTION("shared end points and t junctions")
+	{
+		std::vector<Segment_t> segments{
+			makeSegment(0, 0, 4, 0),
+			makeSegment(4, 0, 4, 4),
+			makeSegment(2, 0, 2, 3),
+			makeSegment(4, 2, 6, 2)
+		};
+		auto pairs = sweepPairs(segments);
+		REQUIRE(pairs == bruteForcePairs(segments));
+		REQUIRE(std::size(pairs) == 3);
+		REQUIRE(pairs[{ 0, 2 }] == Intersection_t{ LineIntersectionResult::intersecting, 0.5, 0 });
+	}
+
+	SECTION("multiple segments through a single point")
+	{
+		std::vector<Segment_t> segments{
+			makeSegment(-1, -1, 1, 1),
+			makeSegment(-1, 1, 1, -1),
+			makeSegment(0, -1, 0, 1),
+			makeSegment(-1, 0, 1, 0),
+			makeSegment(-2, -1, 2, 1)
+		};
+		auto pairs = sweepPairs(segments);
+		REQUIRE(std::size(pairs) == 10);
+		REQUIRE(pairs == bruteForcePairs(segments));
+	}
+
+	SECTION("collinear segments")
+	{
+		std::vector<Segment_t> segments{
+			makeSegment(0, 0, 4, 4),
+			makeSegment(3, 3, 1, 1),
+			makeSegment(4, 4, 5, 5),
+			makeSegment(6, 6, 7, 7),
+			makeSegment(0, 0, 4, 4),
+			makeSegment(2, 0, 2, 5),
+			makeSegment(2, 4, 2, 7)
+		};
+		auto pairs = sweepPairs(segments);
+		REQUIRE(pairs == bruteForcePairs(segments));
+		REQUIRE(pairs.contains({ 0, 2 }));
+		REQUIRE(pairs[{ 5, 6 }] == Intersection_t{ LineIntersectionResult::collinear, 0, 0 });
+		REQUIRE(!pairs.contains({ 2, 3 }));
+	}
+
+	SECTION("early stop")
+	{
+		std::vector<Segment_t> segments{
+			makeSegment(0, 0, 2, 2),
+			makeSegment(0, 2, 2, 0),
+			makeSegment(1, 0, 1, 2)
+		};
+		int calls = 0;
+		forEachIntersectingPair(segments, [&](auto&&...) { ++calls; return false; });
+		REQUIRE(calls == 1);
+	}
+}
+
+TEST_CASE("Sweep intersection grid test", "[SweepIntersection]")
+{
+	constexpr int lineCount = 20;
+	std::vector<Segment_t> segments;
+	for (int i = 0; i < lineCount; ++i)
+	{
+		segments.push_back(makeSegment(0, i, lineCount - 1, i));
+		segments.push_back(makeSegment(i, 0, i, lineCount - 1));
+	}
+	segments.push_back(makeSegment(0, 0, lineCount - 1, lineCount - 1));
+
+	auto pairs = sweepPairs(segments);
+	REQUIRE(std::size(pairs) == lineCount * lineCount + 2 * lineCount);
+	REQUIRE(pairs == bruteForcePairs(segments));
+}
+
+TEST_CASE("Sweep intersection against brute force test", "[SweepIntersection]")
+{
+	std::mt19937 engine{ 1337 };
+
+	// integral coordinates on a coarse lattice produce plenty of shared end points, concurrent crossings and collinear overlaps,
+	// while intersection still computes them exactly
+	SECTION("lattice segments")
+	{
+		std::uniform_int_distribution<int> coordinateDist{ 0, 12 };
+		for (int round = 0; round < 20; ++round)
+		{
+			std::vector<Segment_t> segments;
+			while (std::size(segments) < 150)
+			{
+				Vector2_t first{ double(coordinateDist(engine)), double(coordinateDist(engine)) };
+				Vector2_t second{ double(coordinateDist(engine)), double(coordinateDist(engine)) };
+				if (first != second)
+					segments.push_back({ first, second - first });
+			}
+			REQUIRE(sweepPairs(segments) == bruteForcePairs(segments));
+		}
+	}
+
+	SECTION("arbitrary segments")
+	{
+		std::uniform_real_distribution<double> positionDist{ -100., 100. };
+		std::uniform_real_distribution<double> spanDist{ -20., 20. };
+		for (int round = 0; round < 5; ++round)
+		{
+			std::vector<Segment_t> segments;
+			for (int i = 0; i < 500; ++i)
+				segments.push_back({ { positionDist(engine), positionDist(engine) }, { spanDist(engine), spanDist(engine) } });
+			REQUIRE(sweepPairs(segments) == bruteForcePairs(segments));
+		}
+	}
+}
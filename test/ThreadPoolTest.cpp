@@ -0,0 +1,138 @@
+//          Copyright Dominic Koepke 2017 - 2020.
+// Distributed under the Boost Software License, Version 1.0.
+//    (See accompanying file LICENSE_1_0.txt or copy at
+//          https://www.boost.org/LICENSE_1_0.txt)
+
+#include "catch.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+#include "georithm/ThreadPool.hpp"
+
+using namespace georithm;
+
+TEST_CASE("ThreadPool parallelFor test", "[ThreadPool]")
+{
+	auto threadCount = GENERATE(1u, 2u, 8u);
+	ThreadPool pool{ threadCount };
+	REQUIRE(pool.threadCount() == threadCount);
+
+	SECTION("each element is visited exactly once")
+	{
+		auto count = GENERATE(0u, 1u, 7u, 10000u);
+		// Catch assertions aren't thread safe, thus invalid chunks are only counted
+		std::vector<std::atomic<int>> visits(count);
+		std::atomic<int> invalidChunks{ 0 };
+		pool.parallelFor(count, 64, [&](std::size_t begin, std::size_t end)
+			{
+				if (end <= begin || 64 < end - begin)
+					++invalidChunks;
+				for (auto i = begin; i < end; ++i)
+					++visits[i];
+			}
+		);
+		REQUIRE(invalidChunks == 0);
+		REQUIRE(std::ranges::all_of(visits, [](auto& visit) { return visit == 1; }));
+	}
+
+	SECTION("nested")
+	{
+		std::atomic<std::size_t> sum{ 0 };
+		pool.parallelFor(16, 1, [&](std::size_t outer, std::size_t)
+			{
+				pool.parallelFor(100, 10, [&](std::size_t begin, std::size_t end)
+					{
+						for (auto i = begin; i < end; ++i)
+							sum += outer * 100 + i;
+					}
+				);
+			}
+		);
+		REQUIRE(sum == 1600 * 1599 / 2);
+	}
+
+	SECTION("exceptions are rethrown")
+	{
+		REQUIRE_THROWS_AS(pool.parallelFor(100, 1, [&](std::size_t begin, std::size_t)
+				{
+					if (begin == 42)
+						throw std::runtime_error{ "test" };
+				}
+			),
+			std::runtime_error
+		);
+		// the pool stays usable
+		std::atomic<int> calls{ 0 };
+		pool.parallelFor(100, 1, [&](std::size_t, std::size_t) { ++calls; });
+		REQUIRE(calls == 100);
+	}
+}
+
+TEST_CASE("ThreadPool work stealing test", "[ThreadPool]")
+{
+	ThreadPool pool{ GENERATE(2u, 4u) };
+
+	SECTION("all chunks run despite exceptions")
+	{
+		std::atomic<int> calls{ 0 };
+		REQUIRE_THROWS_AS(pool.parallelFor(100, 1, [&](std::size_t begin, std::size_t)
+				{
+					++calls;
+					if (begin % 10 == 0)
+						throw std::runtime_error{ "test" };
+				}
+			),
+			std::runtime_error
+		);
+		REQUIRE(calls == 100);
+	}
+
+	SECTION("unbalanced chunks")
+	{
+		// the cost of the chunks grows steeply, thus idle threads have to steal from the busy ones
+		std::vector<std::atomic<std::size_t>> results(64);
+		pool.parallelFor(std::size(results), 1, [&](std::size_t begin, std::size_t)
+			{
+				std::size_t sum = 0;
+				for (std::size_t i = 0; i < begin * begin * 100; ++i)
+					sum += i % 7;
+				results[begin] = sum + 1;
+			}
+		);
+		REQUIRE(std::ranges::all_of(results, [](auto& result) { return result != 0; }));
+	}
+
+	SECTION("concurrent callers")
+	{
+		// threads outside of the pool share a queue and may execute each others tasks while they wait
+		std::vector<std::size_t> sums(6);
+		std::vector<std::thread> threads;
+		for (std::size_t t = 0; t < std::size(sums); ++t)
+		{
+			threads.emplace_back([&, t]()
+				{
+					for (int round = 0; round < 20; ++round)
+					{
+						sums[t] += pool.parallelReduce(std::size_t{ 1000 }, 10, std::size_t{ 0 }, [&](std::size_t begin, std::size_t end)
+							{
+								std::size_t sum = 0;
+								for (auto i = begin; i < end; ++i)
+									sum += i * (t + 1);
+								return sum;
+							},
+							[](std::size_t lhs, std::size_t rhs) { return lhs + rhs; }
+						);
+					}
+				}
+			);
+		}
+		for (auto& thread : threads)
+			thread.join();
+		for (std::size_t t = 0; t < std::size(sums); ++t)
+			REQUIRE(sums[t] == 20 * (t + 1) * 999 * 1000 / 2);
+	}
+}
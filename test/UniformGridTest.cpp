@@ -0,0 +1,175 @@
+//          Copyright Dominic Koepke 2017 - 2020.
+// Distributed under the Boost Software License, Version 1.0.
+//    (See accompanying file LICENSE_1_0.txt or copy at
+//          https://www.boost.org/LICENSE_1_0.txt)
+
+#include "catch.hpp"
+
+#include <random>
+#include <set>
+#include <utility>
+#include <vector>
+
+#include "georithm/Bounding.hpp"
+#include "georithm/Contains.hpp"
+#include "georithm/Rect.hpp"
+#include "georithm/UniformGrid.hpp"
+#include "georithm/Vector.hpp"
+
+#include "georithm/transform/Rotate.hpp"
+
+namespace
+{
+	using namespace georithm;
+
+	using Pair_t = std::pair<std::size_t, std::size_t>;
+
+	template <class T>
+	std::set<Pair_t> collectPairs(const UniformGrid<T>& grid)
+	{
+		std::set<Pair_t> pairs;
+		grid.forEachOverlappingPair([&](std::size_t lhs, std::size_t rhs)
+			{
+				REQUIRE(lhs < rhs);
+				REQUIRE(pairs.emplace(lhs, rhs).second);
+			}
+		);
+		return pairs;
+	}
+
+	template <class TObject>
+	std::set<Pair_t> bruteForcePairs(const std::vector<TObject>& objects)
+	{
+		std::set<Pair_t> pairs;
+		for (std::size_t i = 0; i < std::size(objects); ++i)
+		{
+			for (std::size_t j = i + 1; j < std::size(objects); ++j)
+			{
+				if (detail::intersectsBounds(boundingRect(objects[i]), boundingRect(objects[j])))
+					pairs.emplace(i, j);
+			}
+		}
+		return pairs;
+	}
+}
+
+TEST_CASE("UniformGrid random objects test", "[UniformGrid]")
+{
+	using Vector2_t = Vector<float, 2>;
+	using Rect_t = Rect<float, transform::Rotate<Vector2_t>>;
+
+	std::mt19937 engine{ 1 };
+	std::uniform_real_distribution<float> positionDist{ -200.f, 200.f };
+	std::uniform_real_distribution<float> spanDist{ 1.f, 10.f };
+	std::uniform_real_distribution<float> rotationDist{ 0.f, 6.f };
+	std::vector<Rect_t> rects;
+	for (int i = 0; i < 1000; ++i)
+	{
+		Rect_t rect{ { positionDist(engine), positionDist(engine) }, { spanDist(engine), spanDist(engine) } };
+		rect.rotation() = rotationDist(engine);
+		rects.emplace_back(rect);
+	}
+	// a single huge object covers more cells than there are buckets
+	rects.emplace_back(Rect_t{ { -300.f, -300.f }, { 600.f, 600.f } });
+
+	UniformGrid<float> grid{ 8.f };
+	grid.rebuild(rects);
+	REQUIRE(std::size(grid) == std::size(rects));
+	REQUIRE(grid.bounds(3) == boundingRect(rects[3]));
+	REQUIRE(collectPairs(grid) == bruteForcePairs(rects));
+
+	SECTION("query")
+	{
+		for (int i = 0; i < 100; ++i)
+		{
+			AABB_t<float> area{ { positionDist(engine), positionDist(engine) }, { 4 * spanDist(engine), -4 * spanDist(engine) } };
+			std::set<std::size_t> found;
+			grid.query(area, [&](std::size_t index) { REQUIRE(found.emplace(index).second); });
+
+			std::set<std::size_t> expected;
+			for (std::size_t j = 0; j < std::size(rects); ++j)
+			{
+				if (detail::intersectsBounds(boundingRect(area), boundingRect(rects[j])))
+					expected.emplace(j);
+			}
+			REQUIRE(found == expected);
+		}
+	}
+
+	SECTION("point query")
+	{
+		for (int i = 0; i < 100; ++i)
+		{
+			Vector2_t point{ positionDist(engine), positionDist(engine) };
+			std::set<std::size_t> found;
+			grid.queryPoint(point, [&](std::size_t index) { REQUIRE(found.emplace(index).second); });
+
+			std::set<std::size_t> expected;
+			for (std::size_t j = 0; j < std::size(rects); ++j)
+			{
+				if (contains(boundingRect(rects[j]), point))
+					expected.emplace(j);
+			}
+			REQUIRE(found == expected);
+		}
+	}
+
+	SECTION("rebuild")
+	{
+		rects.resize(500);
+		for (auto& rect : rects)
+			rect.position() += Vector2_t{ 3.f, -5.f };
+		grid.rebuild(rects);
+		REQUIRE(std::size(grid) == 500);
+		REQUIRE(collectPairs(grid) == bruteForcePairs(rects));
+	}
+
+	SECTION("clear")
+	{
+		grid.clear();
+		REQUIRE(grid.empty());
+		REQUIRE(std::empty(collectPairs(grid)));
+		int calls = 0;
+		grid.queryPoint(Vector2_t{ 0.f, 0.f }, [&](std::size_t) { ++calls; });
+		REQUIRE(calls == 0);
+	}
+}
+
+TEST_CASE("UniformGrid cell boundaries test", "[UniformGrid]")
+{
+	// boxes touch each other exactly on the cell borders, including negative ones
+	std::vector<AABB_t<int>> boxes{
+		{ { -8, -8 }, { 4, 4 } },
+		{ { -4, -4 }, { 4, 4 } },
+		{ { 0, 0 }, { 4, 4 } },
+		{ { 4, 0 }, { -4, 4 } },
+		{ { 4, 4 }, { 4, 4 } },
+		{ { 20, 20 }, { 1, 1 } }
+	};
+	UniformGrid<int> grid{ 4 };
+	grid.rebuild(boxes);
+	REQUIRE(collectPairs(grid) == std::set<Pair_t>{ { 0, 1 }, { 1, 2 }, { 1, 3 }, { 2, 3 }, { 2, 4 }, { 3, 4 } });
+
+	std::set<std::size_t> found;
+	grid.queryPoint(Vector{ 0, 0 }, [&](std::size_t index) { found.emplace(index); });
+	REQUIRE(found == std::set<std::size_t>{ 1, 2, 3 });
+
+	SECTION("early stop")
+	{
+		int calls = 0;
+		grid.forEachOverlappingPair([&](std::size_t, std::size_t) { return ++calls < 2; });
+		REQUIRE(calls == 2);
+
+		calls = 0;
+		grid.query(AABB_t<int>{ { -10, -10 }, { 20, 20 } }, [&](std::size_t) { return ++calls < 3; });
+		REQUIRE(calls == 3);
+	}
+
+	SECTION("query objects of other value types")
+	{
+		// the bounds are rounded outwards to { { -1, -1 }, { 2, 2 } }
+		found.clear();
+		grid.query(AABB_t<double>{ { -0.5, -0.5 }, { 1., 1. } }, [&](std::size_t index) { found.emplace(index); });
+		REQUIRE(found == std::set<std::size_t>{ 1, 2, 3 });
+	}
+}
@@ -0,0 +1,98 @@
+//          Copyright Dominic Koepke 2017 - 2020.
+// Distributed under the Boost Software License, Version 1.0.
+//    (See accompanying file LICENSE_1_0.txt or copy at
+//          https://www.boost.org/LICENSE_1_0.txt)
+
+#include "catch.hpp"
+
+#include <numbers>
+#include <vector>
+
+#include "georithm/Vector.hpp"
+#include "georithm/VectorSoA.hpp"
+
+TEST_CASE("VectorSoA container test", "[VectorSoA]")
+{
+	using namespace georithm;
+
+	VectorSoA<float, 3> vectors;
+	REQUIRE(vectors.empty());
+
+	vectors.push_back({ 1.f, 2.f, 3.f });
+	vectors.push_back({ 4.f, 5.f, 6.f });
+	REQUIRE(std::size(vectors) == 2);
+	REQUIRE(vectors[0] == Vector{ 1.f, 2.f, 3.f });
+	REQUIRE(vectors[1] == Vector{ 4.f, 5.f, 6.f });
+	REQUIRE(vectors.lane(1)[0] == 2.f);
+	REQUIRE(vectors.lane(1)[1] == 5.f);
+
+	vectors.set(0, { 7.f, 8.f, 9.f });
+	REQUIRE(vectors[0] == Vector{ 7.f, 8.f, 9.f });
+
+	std::vector<Vector<float, 3>> aos{ { 7.f, 8.f, 9.f }, { 4.f, 5.f, 6.f } };
+	REQUIRE(VectorSoA<float, 3>{ aos } == vectors);
+
+	vectors.resize(5);
+	REQUIRE(std::size(vectors) == 5);
+	REQUIRE(vectors[4] == Vector<float, 3>::zero());
+
+	vectors.clear();
+	REQUIRE(vectors.empty());
+}
+
+TEST_CASE("VectorSoA algorithm test", "[VectorSoA]")
+{
+	using namespace georithm;
+
+	std::vector<Vector<double, 2>> aos{ { 1., 2. }, { -3., 4.5 }, { 0.5, -0.25 }, { -7.5, -1. }, { 2.5, 3.5 } };
+	VectorSoA<double, 2> soa{ aos };
+
+	auto requireElementWise = [&aos](const VectorSoA<double, 2>& result, auto op)
+	{
+		REQUIRE(std::size(result) == std::size(aos));
+		for (std::size_t i = 0; i < std::size(aos); ++i)
+		{
+			auto expected = op(aos[i]);
+			REQUIRE(result[i].x() == Approx(expected.x()));
+			REQUIRE(result[i].y() == Approx(expected.y()));
+		}
+	};
+
+	SECTION("reductions")
+	{
+		std::vector<double> out(std::size(aos));
+		lengthSq(soa, std::span{ out });
+		for (std::size_t i = 0; i < std::size(aos); ++i)
+			REQUIRE(out[i] == Approx(lengthSq(aos[i])));
+
+		length(soa, std::span{ out });
+		for (std::size_t i = 0; i < std::size(aos); ++i)
+			REQUIRE(out[i] == Approx(length(aos[i])));
+
+		auto rotated = rotate(soa, 1.);
+		scalarProduct(soa, rotated, std::span{ out });
+		for (std::size_t i = 0; i < std::size(aos); ++i)
+			REQUIRE(out[i] == Approx(scalarProduct(aos[i], rotate(aos[i], 1.))));
+	}
+
+	SECTION("element wise")
+	{
+		requireElementWise(normalize(soa), [](const auto& vec) { return normalize(vec); });
+		requireElementWise(abs(soa), [](const auto& vec) { return abs(vec); });
+		requireElementWise(floor(soa), [](const auto& vec) { return floor(vec); });
+		requireElementWise(ceil(soa), [](const auto& vec) { return ceil(vec); });
+		requireElementWise(round(soa), [](const auto& vec) { return round(vec); });
+		requireElementWise(trunc(soa), [](const auto& vec) { return trunc(vec); });
+		requireElementWise(rotate(soa, 0.7), [](const auto& vec) { return rotate(vec, 0.7); });
+	}
+
+	SECTION("int rotation")
+	{
+		VectorSoA<int, 2> ints;
+		ints.push_back({ 1, 2 });
+		ints.push_back({ -3, 5 });
+		auto rotated = rotate(ints, std::numbers::pi / 2);
+		REQUIRE(rotated[0] == rotate(Vector{ 1, 2 }, std::numbers::pi / 2));
+		REQUIRE(rotated[1] == rotate(Vector{ -3, 5 }, std::numbers::pi / 2));
+	}
+}
@@ -117,3 +117,51 @@ TEST_CASE("Vector algorithm test", "[Vector]")
 		}
 	}
 }
+
+TEMPLATE_TEST_CASE_SIG("Vector register storage test", "[Vector]", ((class T, int TDim), T, TDim), (float, 3), (float, 4), (double, 2), (double, 4))
+{
+	using namespace georithm;
+	using Vector_t = Vector<T, TDim>;
+
+	static_assert(NDimensionalVectorObject<Vector_t, TDim>);
+
+	Vector_t lhs;
+	Vector_t rhs;
+	for (int i = 0; i < TDim; ++i)
+	{
+		lhs[i] = static_cast<T>(i + 1);
+		rhs[i] = static_cast<T>(2 * i - 3);
+	}
+	REQUIRE(std::distance(std::begin(lhs), std::end(lhs)) == TDim);
+	REQUIRE(*std::rbegin(lhs) == static_cast<T>(TDim));
+
+	auto requireElementWise = [](const Vector_t& result, auto op)
+	{
+		for (int i = 0; i < TDim; ++i)
+			REQUIRE(result[i] == Approx(op(i)));
+	};
+
+	requireElementWise(lhs + rhs, [](int i) { return (i + 1) + (2 * i - 3); });
+	requireElementWise(lhs - rhs, [](int i) { return (i + 1) - (2 * i - 3); });
+	requireElementWise(lhs + T(2), [](int i) { return i + 3; });
+	requireElementWise(lhs - T(2), [](int i) { return i - 1; });
+	requireElementWise(lhs * T(3), [](int i) { return (i + 1) * 3; });
+	requireElementWise(T(3) * lhs, [](int i) { return (i + 1) * 3; });
+	requireElementWise(lhs / T(4), [](int i) { return (i + 1) / 4.; });
+
+	T expectedDot{};
+	T expectedLengthSq{};
+	for (int i = 0; i < TDim; ++i)
+	{
+		expectedDot += lhs[i] * rhs[i];
+		expectedLengthSq += lhs[i] * lhs[i];
+	}
+	REQUIRE(scalarProduct(lhs, rhs) == Approx(expectedDot));
+	REQUIRE(lengthSq(lhs) == Approx(expectedLengthSq));
+	REQUIRE(length(normalize(lhs)) == Approx(1));
+
+	// hidden padding elements must not influence comparisons
+	REQUIRE(Vector_t::make(T(2)) + T(1) == Vector_t::make(T(3)));
+	REQUIRE((lhs * T(0)) / T(2) == Vector_t::zero());
+	REQUIRE((lhs + T(5)) - T(5) == lhs);
+}